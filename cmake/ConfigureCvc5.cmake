@@ -75,6 +75,7 @@ else()
   endif()
 endif()
 check_symbol_exists(ffs "strings.h" HAVE_FFS)
+check_symbol_exists(fork "unistd.h" HAVE_FORK)
 check_symbol_exists(optreset "getopt.h" HAVE_DECL_OPTRESET)
 check_symbol_exists(sigaltstack "signal.h" HAVE_SIGALTSTACK)
 check_symbol_exists(strerror_r "string.h" HAVE_STRERROR_R)
@@ -14,6 +14,7 @@
 # CaDiCaL_FOUND - system has CaDiCaL lib
 # CaDiCaL_INCLUDE_DIR - the CaDiCaL include directory
 # CaDiCaL_LIBRARIES - Libraries needed to use CaDiCaL
+# CaDiCaL_HAS_EXTERNAL_PROPAGATOR - CaDiCaL supports external propagators
 ##
 
 include(deps-helper)
@@ -36,6 +37,35 @@ if(CaDiCaL_INCLUDE_DIR AND CaDiCaL_LIBRARIES)
   endif()
 
   check_system_version("CaDiCaL")
+
+  # External propagators (IPASIR-UP) are required to use CaDiCaL as CDCL(T)
+  # SAT solver
+  include(CheckCXXSourceCompiles)
+  set(CMAKE_REQUIRED_INCLUDES ${CaDiCaL_INCLUDE_DIR})
+  check_cxx_source_compiles(
+    "
+    #include <cadical.hpp>
+    class P : public CaDiCaL::ExternalPropagator
+    {
+     public:
+      void notify_assignment(const std::vector<int>& lits) override {}
+      void notify_new_decision_level() override {}
+      void notify_backtrack(size_t new_level) override {}
+      bool cb_check_found_model(const std::vector<int>& model) override
+      {
+        return true;
+      }
+      bool cb_has_external_clause(bool& is_forgettable) override
+      {
+        return false;
+      }
+      int cb_add_external_clause_lit() override { return 0; }
+    };
+    int main() { P p; return 0; }
+    "
+    CaDiCaL_HAS_EXTERNAL_PROPAGATOR
+  )
+  unset(CMAKE_REQUIRED_INCLUDES)
 endif()
 
 if(NOT CaDiCaL_FOUND_SYSTEM)
@@ -48,6 +78,10 @@ if(NOT CaDiCaL_FOUND_SYSTEM)
   include(ExternalProject)
 
   set(CaDiCaL_VERSION "rel-1.4.1")
+  # External propagators were introduced in CaDiCaL 2.0, the version
+  # downloaded here can only be used as SAT solver for bit-blasting. Install
+  # CaDiCaL >= 2.0 to enable --sat-solver=cadical.
+  set(CaDiCaL_HAS_EXTERNAL_PROPAGATOR FALSE)
 
   # avoid configure script and instantiate the makefile manually the configure
   # scripts unnecessarily fails for cross compilation thus we do the bare
@@ -123,6 +157,7 @@ mark_as_advanced(CaDiCaL_FOUND)
 mark_as_advanced(CaDiCaL_FOUND_SYSTEM)
 mark_as_advanced(CaDiCaL_INCLUDE_DIR)
 mark_as_advanced(CaDiCaL_LIBRARIES)
+mark_as_advanced(CaDiCaL_HAS_EXTERNAL_PROPAGATOR)
 
 if(CaDiCaL_FOUND_SYSTEM)
   message(STATUS "Found CaDiCaL ${CaDiCaL_VERSION}: ${CaDiCaL_LIBRARIES}")
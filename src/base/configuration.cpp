@@ -233,6 +233,11 @@ bool Configuration::isBuiltWithCryptominisat() {
 
 bool Configuration::isBuiltWithKissat() { return IS_KISSAT_BUILD; }
 
+bool Configuration::isBuiltWithCadicalPropagator()
+{
+  return IS_CADICAL_PROPAGATOR_BUILD;
+}
+
 bool Configuration::isBuiltWithEditline() { return IS_EDITLINE_BUILD; }
 
 bool Configuration::isBuiltWithPoly()
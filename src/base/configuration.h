@@ -101,6 +101,9 @@ public:
 
   static bool isBuiltWithKissat();
 
+  /** Whether CaDiCaL can be used as CDCL(T) SAT solver. */
+  static bool isBuiltWithCadicalPropagator();
+
   static bool isBuiltWithEditline();
 
   static bool isBuiltWithPoly();
@@ -108,6 +108,12 @@ namespace cvc5 {
 #define IS_KISSAT_BUILD false
 #endif /* CVC5_USE_KISSAT */
 
+#if CVC5_CADICAL_EXTERNAL_PROPAGATOR
+#define IS_CADICAL_PROPAGATOR_BUILD true
+#else /* CVC5_CADICAL_EXTERNAL_PROPAGATOR */
+#define IS_CADICAL_PROPAGATOR_BUILD false
+#endif /* CVC5_CADICAL_EXTERNAL_PROPAGATOR */
+
 #if CVC5_USE_POLY
 #define IS_POLY_BUILD true
 #else /* CVC5_USE_POLY */
@@ -0,0 +1,483 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Context-dependent insert only hashmap with flat storage.
+ *
+ * Context-dependent hashmap that only allows for one insertion per element,
+ * with the same interface as CDInsertHashMap. The elements are stored in
+ * insertion order in a single trail, which doubles as the undo log for pops,
+ * and are looked up through an open-addressing table of indices into the
+ * trail. Compared to CDInsertHashMap, there is no per-element node
+ * allocation and no second copy of the key, and iteration is in insertion
+ * order. Compared to CDHashMap, there is no ContextObj per element.
+ *
+ * See also:
+ *  CDInsertHashMap : The same interface, backed by std::unordered_map.
+ *  CDHashMap : A fully featured CD hash map. (The closest to <ext/hash_map>)
+ *
+ * Notes:
+ * - operator[] is only supported as a const derefence (must succeed).
+ * - insert(k) must always work.
+ * - Use insert_safe if you want to check if the element has been inserted
+ *   and only insert if it has not yet been.
+ * - Does not accept TNodes as keys.
+ * - Supports insertAtContextLevelZero() if the element is not in the map.
+ * - References to elements are invalidated by insertions.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "context/cdflat_hashmap_forward.h"
+#include "context/context.h"
+#include "cvc5_private.h"
+#include "expr/node.h"
+
+#pragma once
+
+namespace cvc5 {
+namespace context {
+
+template <class Key, class Data, class HashFcn = std::hash<Key> >
+class FlatInsertHashMap
+{
+ public:
+  // The type of the <Key, Data> values in the hashmap.
+  using value_type = std::pair<Key, Data>;
+
+ private:
+  /**
+   * The trail of elements. Elements inserted with push_back() are at
+   * positions d_numFront and above, in insertion order. Elements inserted
+   * with push_front() are below, the most recent one first.
+   */
+  using Trail = std::deque<value_type>;
+  Trail d_trail;
+  /** The number of elements inserted with push_front(). */
+  size_t d_numFront;
+
+  /**
+   * A slot of the lookup table: the position of an element in d_trail plus
+   * d_numFront at the time it was inserted (so that it is not affected by
+   * later calls to push_front()), and the hash of its key. A slot is empty
+   * iff d_id is s_empty.
+   */
+  struct Slot
+  {
+    int32_t d_id;
+    uint32_t d_hash;
+  };
+  static constexpr int32_t s_empty = INT32_MIN;
+  /**
+   * The lookup table, a Robin Hood hash table with linear probing and
+   * backward-shift deletion (as NodeValuePool). The number of slots is a
+   * power of two.
+   */
+  std::vector<Slot> d_slots;
+  /** 64 - log2 of the number of slots. */
+  uint32_t d_shift;
+
+  /** The initial capacity is 2^initialLog2Capacity slots. */
+  static constexpr size_t initialLog2Capacity = 4;
+  /** The table grows once its load exceeds maxLoadNum / maxLoadDen. */
+  static constexpr size_t maxLoadNum = 7;
+  static constexpr size_t maxLoadDen = 8;
+
+  static uint32_t hash(const Key& k)
+  {
+    uint64_t h = HashFcn()(k);
+    return static_cast<uint32_t>(h ^ (h >> 32));
+  }
+  /** The home slot of an element with hash h (Fibonacci hashing). */
+  size_t home(uint32_t h) const
+  {
+    return static_cast<size_t>(
+        (static_cast<uint64_t>(h) * UINT64_C(0x9e3779b97f4a7c15)) >> d_shift);
+  }
+  /** The distance of slot i from the home slot of an element with hash h. */
+  size_t probeDistance(size_t i, uint32_t h) const
+  {
+    return (i - home(h)) & (d_slots.size() - 1);
+  }
+  /** The element of d_trail with identifier id. */
+  const value_type& element(int32_t id) const
+  {
+    return d_trail[static_cast<size_t>(static_cast<int64_t>(id) + d_numFront)];
+  }
+
+  /** Get the slot index of k, or d_slots.size() if k is not in the map. */
+  size_t findSlot(const Key& k) const
+  {
+    uint32_t h = hash(k);
+    size_t mask = d_slots.size() - 1;
+    size_t i = home(h);
+    for (size_t dist = 0;; ++dist, i = (i + 1) & mask)
+    {
+      const Slot& s = d_slots[i];
+      if (s.d_id == s_empty || probeDistance(i, s.d_hash) < dist)
+      {
+        return d_slots.size();
+      }
+      if (s.d_hash == h && element(s.d_id).first == k)
+      {
+        return i;
+      }
+    }
+  }
+
+  /** Insert slot s, whose key is known not to be in the table. */
+  void insertSlot(Slot s)
+  {
+    size_t mask = d_slots.size() - 1;
+    size_t i = home(s.d_hash);
+    for (size_t dist = 0;; ++dist, i = (i + 1) & mask)
+    {
+      Slot& cur = d_slots[i];
+      if (cur.d_id == s_empty)
+      {
+        cur = s;
+        return;
+      }
+      size_t curDist = probeDistance(i, cur.d_hash);
+      if (curDist < dist)
+      {
+        // take the slot from the richer entry, continue with that one
+        std::swap(cur, s);
+        dist = curDist;
+      }
+    }
+  }
+
+  /** Add the element with identifier id, which is in d_trail, to the table. */
+  void insertId(int32_t id)
+  {
+    if ((d_trail.size() + 1) * maxLoadDen > d_slots.size() * maxLoadNum)
+    {
+      grow();
+    }
+    insertSlot(Slot{id, hash(element(id).first)});
+  }
+
+  /** Remove the element with identifier id from the table. */
+  void eraseId(int32_t id)
+  {
+    size_t mask = d_slots.size() - 1;
+    size_t i = home(hash(element(id).first));
+    while (d_slots[i].d_id != id)
+    {
+      Assert(d_slots[i].d_id != s_empty) << "element is not in the table!";
+      i = (i + 1) & mask;
+    }
+    // shift the following entries of the cluster back by one slot
+    size_t j = (i + 1) & mask;
+    while (d_slots[j].d_id != s_empty
+           && probeDistance(j, d_slots[j].d_hash) > 0)
+    {
+      d_slots[i] = d_slots[j];
+      i = j;
+      j = (j + 1) & mask;
+    }
+    d_slots[i] = Slot{s_empty, 0};
+  }
+
+  /** Double the capacity of the table. */
+  void grow()
+  {
+    std::vector<Slot> old(d_slots.size() * 2, Slot{s_empty, 0});
+    old.swap(d_slots);
+    --d_shift;
+    for (const Slot& s : old)
+    {
+      if (s.d_id != s_empty)
+      {
+        insertSlot(s);
+      }
+    }
+  }
+
+ public:
+  /**
+   * An iterator over the elements in the map, in the order of the trail.
+   * (See std::deque<>::iterator).
+   */
+  using const_iterator = typename Trail::const_iterator;
+
+  FlatInsertHashMap() : d_numFront(0), d_shift(64 - initialLog2Capacity)
+  {
+    d_slots.resize(static_cast<size_t>(1) << initialLog2Capacity,
+                   Slot{s_empty, 0});
+  }
+
+  /** Returns an iterator to the begining of the trail. */
+  const_iterator begin() const { return d_trail.begin(); }
+  /** Returns an iterator to the end of the trail. */
+  const_iterator end() const { return d_trail.end(); }
+
+  /** Returns an iterator to the element with Key k, or end() if none. */
+  const_iterator find(const Key& k) const
+  {
+    size_t i = findSlot(k);
+    if (i == d_slots.size())
+    {
+      return end();
+    }
+    return begin()
+           + static_cast<std::ptrdiff_t>(
+               static_cast<int64_t>(d_slots[i].d_id) + d_numFront);
+  }
+
+  /** Returns true if the map is empty. */
+  bool empty() const { return d_trail.empty(); }
+  /** Returns the number of elements in the map. */
+  size_t size() const { return d_trail.size(); }
+  /** Returns the number of slots of the lookup table. */
+  size_t capacity() const { return d_slots.size(); }
+
+  /** Returns true if k is a mapped key. */
+  bool contains(const Key& k) const { return findSlot(k) != d_slots.size(); }
+
+  /**
+   * Returns a reference the data mapped by k.
+   * This must succeed.
+   */
+  const Data& operator[](const Key& k) const
+  {
+    size_t i = findSlot(k);
+    Assert(i != d_slots.size());
+    return element(d_slots[i].d_id).second;
+  }
+
+  /**
+   * Inserts an element at the front of the trail. The key inserted must be
+   * not be currently mapped. Elements inserted this way are never removed.
+   */
+  void push_front(const Key& k, const Data& d)
+  {
+    Assert(!contains(k));
+    d_trail.emplace_front(k, d);
+    ++d_numFront;
+    AlwaysAssert(d_numFront <= static_cast<size_t>(INT32_MAX));
+    insertId(-static_cast<int32_t>(d_numFront));
+  }
+
+  /**
+   * Inserts an element at the back of the trail. The key inserted must be
+   * not be currently mapped.
+   */
+  void push_back(const Key& k, const Data& d)
+  {
+    Assert(!contains(k));
+    size_t id = d_trail.size() - d_numFront;
+    AlwaysAssert(id < static_cast<size_t>(INT32_MAX));
+    d_trail.emplace_back(k, d);
+    insertId(static_cast<int32_t>(id));
+  }
+
+  /**
+   * Removes the elements at the back of the trail until the size is s.
+   */
+  void pop_to_size(size_t s)
+  {
+    Assert(s >= d_numFront);
+    Debug("FlatInsertHashMap")
+        << "FlatInsertHashMap pop_to_size " << size() << " to " << s
+        << std::endl;
+    while (size() > s)
+    {
+      eraseId(static_cast<int32_t>(d_trail.size() - 1 - d_numFront));
+      d_trail.pop_back();
+    }
+  }
+}; /* class FlatInsertHashMap<> */
+
+template <class Key, class Data, class HashFcn>
+class CDFlatHashMap : public ContextObj
+{
+ private:
+  typedef FlatInsertHashMap<Key, Data, HashFcn> FIHM;
+
+  /** A FlatInsertHashMap that backs all of the data. */
+  FIHM* d_flatMap;
+
+  /** For restores, we need to keep track of the previous size. */
+  size_t d_size;
+
+  /**
+   * To support insertAtContextLevelZero() and restores, the number of times
+   * we have called d_flatMap->push_front().
+   */
+  size_t d_pushFronts;
+
+  /**
+   * Private copy constructor used only by save().  d_flatMap is not copied:
+   * only the base class information and d_size and d_pushFronts are needed
+   * in restore.
+   */
+  CDFlatHashMap(const CDFlatHashMap& l)
+      : ContextObj(l),
+        d_flatMap(NULL),
+        d_size(l.d_size),
+        d_pushFronts(l.d_pushFronts)
+  {
+  }
+  CDFlatHashMap& operator=(const CDFlatHashMap&) = delete;
+
+  /**
+   * Implementation of mandatory ContextObj method save: simply copies the
+   * current size information to a copy using the copy constructor.  The
+   * saved information is allocated using the ContextMemoryManager.
+   */
+  ContextObj* save(ContextMemoryManager* pCMM) override
+  {
+    ContextObj* data = new (pCMM) CDFlatHashMap<Key, Data, HashFcn>(*this);
+    Debug("CDFlatHashMap") << "save " << this << " at level "
+                           << this->getContext()->getLevel() << " size at "
+                           << this->d_size << std::endl;
+    return data;
+  }
+
+ protected:
+  /**
+   * Implementation of mandatory ContextObj method restore: pop the trail
+   * back to the previous size, taking into account the number of push_front
+   * calls that have happened since saving.
+   */
+  void restore(ContextObj* data) override
+  {
+    CDFlatHashMap<Key, Data, HashFcn>* p =
+        static_cast<CDFlatHashMap<Key, Data, HashFcn>*>(data);
+    Assert(p->d_pushFronts <= d_pushFronts);
+    size_t restoreSize = p->d_size + (d_pushFronts - p->d_pushFronts);
+    d_flatMap->pop_to_size(restoreSize);
+    d_size = restoreSize;
+    Assert(d_flatMap->size() == d_size);
+  }
+
+  /**
+   * Implementation of ContextObj method discard: restoring from an older
+   * saved copy gives the same result as restoring from this one first, so
+   * there is nothing to do.
+   */
+  void discard(ContextObj* data) override {}
+
+ public:
+  /**
+   * Main constructor: d_flatMap starts as an empty map, with the size is 0
+   */
+  CDFlatHashMap(Context* context)
+      : ContextObj(context), d_flatMap(new FIHM()), d_size(0), d_pushFronts(0)
+  {
+  }
+
+  /**
+   * Destructor: delete the d_flatMap
+   */
+  ~CDFlatHashMap()
+  {
+    this->destroy();
+    delete d_flatMap;
+  }
+
+  /** An iterator over the elements in the map, in insertion order. */
+  typedef typename FIHM::const_iterator const_iterator;
+
+  // The type of the <key, data> values in the hashmap.
+  using value_type = typename FIHM::value_type;
+
+  /** Returns true if the map is empty in the current context. */
+  bool empty() const { return d_size == 0; }
+
+  /** Returns true the size of the map in the current context. */
+  size_t size() const { return d_size; }
+
+  /**
+   * Inserts an element into the map.
+   * The key inserted must be not be currently mapped.
+   */
+  void insert(const Key& k, const Data& d)
+  {
+    makeCurrent();
+    ++d_size;
+    d_flatMap->push_back(k, d);
+    Assert(d_flatMap->size() == d_size);
+  }
+
+  /**
+   * Checks if the key k is mapped already.
+   * If it is, this returns false.
+   * Otherwise it is inserted and this returns true.
+   */
+  bool insert_safe(const Key& k, const Data& d)
+  {
+    if (contains(k))
+    {
+      return false;
+    }
+    insert(k, d);
+    return true;
+  }
+
+  /**
+   * Version of insert() that inserts data value d at context level zero.
+   *
+   * It is an error to insertAtContextLevelZero() a key that already is in
+   * the map.
+   */
+  void insertAtContextLevelZero(const Key& k, const Data& d)
+  {
+    makeCurrent();
+    ++d_size;
+    ++d_pushFronts;
+    d_flatMap->push_front(k, d);
+  }
+
+  /** Returns true if k is a mapped key in the context. */
+  bool contains(const Key& k) const { return d_flatMap->contains(k); }
+
+  /**
+   * Returns a reference the data mapped by k.
+   * k must be in the map in this context.
+   */
+  const Data& operator[](const Key& k) const { return (*d_flatMap)[k]; }
+
+  /**
+   * Returns a const_iterator to the value_type if k is a mapped key in
+   * the context.
+   */
+  const_iterator find(const Key& k) const { return d_flatMap->find(k); }
+
+  /** Returns an iterator to the begining of the map. */
+  const_iterator begin() const { return d_flatMap->begin(); }
+
+  /** Returns an iterator to the end of the map. */
+  const_iterator end() const { return d_flatMap->end(); }
+}; /* class CDFlatHashMap<> */
+
+template <class Data, class HashFcn>
+class CDFlatHashMap<TNode, Data, HashFcn> : public ContextObj
+{
+  /* As for CDInsertHashMap, keys are hashed again when they are removed on
+   * a pop, which is not safe for TNode keys whose backing node may already
+   * be gone. Consider using CDHashMap<TNode,...> instead.
+   */
+  static_assert(sizeof(Data) == 0,
+                "Cannot create a CDFlatHashMap with TNode keys");
+};
+
+}  // namespace context
+}  // namespace cvc5
@@ -0,0 +1,38 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * This is a forward declaration header to declare the CDFlatHashMap<>
+ * template
+ *
+ * It's useful if you want to forward-declare CDFlatHashMap<> without
+ * including the full cdflat_hashmap.h header, for example, in a public
+ * header context.
+ *
+ * For CDFlatHashMap<> in particular, it's difficult to forward-declare it
+ * yourself, because it has a default template argument.
+ */
+
+#include "cvc5_public.h"
+
+#ifndef CVC5__CONTEXT__CDFLAT_HASHMAP_FORWARD_H
+#define CVC5__CONTEXT__CDFLAT_HASHMAP_FORWARD_H
+
+#include <functional>
+
+namespace cvc5 {
+namespace context {
+template <class Key, class Data, class HashFcn = std::hash<Key> >
+class CDFlatHashMap;
+}  // namespace context
+}  // namespace cvc5
+
+#endif /* CVC5__CONTEXT__CDFLAT_HASHMAP_FORWARD_H */
@@ -258,6 +258,13 @@ protected:
        << "restore " << this << " level " << this->getContext()->getLevel()
        << " size back to " << this->d_size << std::endl;
   }
+
+  /**
+   * Implementation of ContextObj method discard: restoring from an older
+   * saved copy gives the same result as restoring from this one first, so
+   * there is nothing to do.
+   */
+  void discard(ContextObj* data) override {}
 public:
 
  /**
@@ -219,6 +219,13 @@ protected:
                    << std::endl;
   }
 
+  /**
+   * Implementation of ContextObj method discard: truncating the list to the
+   * size of an older saved copy subsumes truncating it to the size of this
+   * one, so there is nothing to do.
+   */
+  void discard(ContextObj* data) override {}
+
   /**
    * Given a size parameter smaller than d_size, truncateList()
    * removes the elements from the end of the list until d_size equals size.
@@ -76,6 +76,15 @@ protected:
     p->d_data.~T();
   }
 
+  /**
+   * Implementation of ContextObj method discard: the data of a skipped saved
+   * copy is not needed, only its destructor is called.
+   */
+  void discard(ContextObj* pContextObj) override
+  {
+    static_cast<CDO<T>*>(pContextObj)->d_data.~T();
+  }
+
 public:
 
   /**
@@ -110,7 +110,38 @@ void Context::pop() {
 void Context::popto(int toLevel) {
   // Pop scopes until there are none left or toLevel is reached
   if(toLevel < 0) toLevel = 0;
-  while(toLevel < getLevel()) pop();
+  // Notification objects must see each intermediate level, so pop one level
+  // at a time if there are any
+  if (d_pCNOpre != NULL || d_pCNOpost != NULL || getLevel() - toLevel < 2)
+  {
+    while(toLevel < getLevel()) pop();
+    return;
+  }
+
+  int fromLevel = getLevel();
+  Trace("pushpop") << std::string(2 * fromLevel, ' ') << "Pop [from "
+                   << fromLevel << " to " << toLevel << "] " << this
+                   << std::endl;
+
+  // Restore all objects of the popped Scopes to their state at toLevel, from
+  // the top Scope down
+  for (int level = fromLevel; level > toLevel; --level)
+  {
+    d_scopeList[level]->restoreTo(toLevel);
+  }
+
+  // Delete the popped Scopes (which collects their garbage) and pop their
+  // memory regions
+  while (getLevel() > toLevel)
+  {
+    Scope* pScope = d_scopeList.back();
+    d_scopeList.pop_back();
+    delete pScope;
+    d_pCMM->pop();
+  }
+
+  Trace("pushpop") << std::string(2 * getLevel(), ' ') << "} Pop [to "
+                   << getLevel() << "] " << this << std::endl;
 }
 
 
@@ -234,6 +265,41 @@ ContextObj* ContextObj::restoreAndContinue()
   return pContextObjNext;
 }
 
+ContextObj* ContextObj::restoreToAndContinue(int toLevel)
+{
+  ContextObj* pContextObjSaved = d_pContextObjRestore;
+
+  // Skip the saved copies of the levels that are popped as well, as long as
+  // there is an older one
+  while (pContextObjSaved != NULL
+         && pContextObjSaved->d_pContextObjRestore != NULL
+         && pContextObjSaved->d_pScope->getLevel() > toLevel)
+  {
+    ContextObj* pContextObjOlder = pContextObjSaved->d_pContextObjRestore;
+    discard(pContextObjSaved);
+    // Unlink the saved copy from the list of its Scope, which is restored
+    // later on
+    pContextObjSaved->unlink();
+    pContextObjSaved = pContextObjOlder;
+  }
+
+  if (pContextObjSaved != NULL
+      && pContextObjSaved->d_pScope->getLevel() > toLevel)
+  {
+    // The object was created in one of the popped levels (see
+    // restoreAndContinue() for the case of a NULL restore object)
+    ContextObj* pContextObjNext = d_pContextObjNext;
+    restore(pContextObjSaved);
+    pContextObjSaved->unlink();
+    d_pContextObjRestore = NULL;
+    d_pScope = nullptr;
+    return pContextObjNext;
+  }
+
+  d_pContextObjRestore = pContextObjSaved;
+  return restoreAndContinue();
+}
+
 void ContextObj::destroy()
 {
   /* The object to destroy must be valid, i.e., its current state must belong
@@ -379,6 +445,15 @@ Scope::~Scope() {
   }
 }
 
+void Scope::restoreTo(int toLevel)
+{
+  Assert(toLevel < d_level);
+  while (d_pContextObjList != NULL)
+  {
+    d_pContextObjList = d_pContextObjList->restoreToAndContinue(toLevel);
+  }
+}
+
 void Scope::enqueueToGarbageCollect(ContextObj* obj) {
   if (!d_garbage) {
     d_garbage.reset(new std::vector<ContextObj*>);
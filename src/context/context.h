@@ -179,7 +179,11 @@ public:
   void pop();
 
   /**
-   * Pop all the way back to given level
+   * Pop all the way back to given level.  When popping several levels at
+   * once, each object is restored directly to its state at toLevel, skipping
+   * the saved copies of the intermediate levels.  If there are pre-pop or
+   * post-pop notification objects, which must see each intermediate level,
+   * the levels are popped one at a time instead.
    */
   void popto(int toLevel);
 
@@ -281,6 +285,14 @@ class Scope {
    */
   ~Scope();
 
+  /**
+   * Restore all of the objects in ContextObjList to their state at level
+   * toLevel, which is below the level of this Scope.  This is used by
+   * Context::popto() on all popped scopes, from the top down, before they are
+   * deleted.
+   */
+  void restoreTo(int toLevel);
+
   /**
    * Get the Context for this Scope
    */
@@ -479,6 +491,27 @@ class ContextObj {
    */
   ContextObj* restoreAndContinue();
 
+  /**
+   * This method is called by Scope during a multi-level pop to toLevel: it
+   * restores the object to its state at toLevel, discarding the saved copies
+   * of the levels in between, and then returns the next object in the list
+   * that needs to be restored.  Discarded copies are unlinked from the lists
+   * of their (popped) Scopes, so that they are not visited again.
+   */
+  ContextObj* restoreToAndContinue(int toLevel);
+
+  /**
+   * Remove this object from the ContextObjList it is in.
+   */
+  void unlink()
+  {
+    if (next() != NULL)
+    {
+      next()->prev() = prev();
+    }
+    *prev() = next();
+  }
+
  protected:
   /**
    * This is a method that must be implemented by all classes inheriting from
@@ -492,6 +525,19 @@ class ContextObj {
    */
   virtual void restore(ContextObj* pContextObjRestore) = 0;
 
+  /**
+   * Release a saved copy whose state is skipped by a multi-level pop, i.e.
+   * one that would be restored from and then immediately overwritten by an
+   * older saved copy (see Context::popto()).  The default implementation
+   * simply restores from it.  Classes whose restore() gives the same result
+   * when skipping intermediate copies may override this to only do the
+   * clean-up work that restore() does on the saved copy.
+   */
+  virtual void discard(ContextObj* pContextObjSaved)
+  {
+    restore(pContextObjSaved);
+  }
+
   /**
    * This method checks if the object has been modified in this Scope
    * yet.  If not, it calls update().
@@ -13,6 +13,8 @@
  * Implementation of Context Memory Manager
  */
 
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>
 #include <deque>
 #include <limits>
@@ -20,6 +22,10 @@
 #include <ostream>
 #include <vector>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 #ifdef CVC5_VALGRIND
 #include <valgrind/memcheck.h>
 #endif /* CVC5_VALGRIND */
@@ -35,47 +41,145 @@ namespace context {
 
 void ContextMemoryManager::newChunk() {
 
+  // The size class of the new chunk depends on the number of chunks of the
+  // current region
+  unsigned regionChunks =
+      d_indexChunkList
+      - (d_indexChunkListStack.empty() ? 0 : d_indexChunkListStack.back());
+  unsigned sizeClass = std::min(regionChunks, numSizeClasses - 1);
+
   // Increment index to chunk list
   ++d_indexChunkList;
   Assert(d_chunkList.size() == d_indexChunkList)
       << "Index should be at the end of the list";
 
   // Create new chunk if no free chunk available
-  if(d_freeChunks.empty()) {
-    d_chunkList.push_back((char*)malloc(chunkSizeBytes));
-    if(d_chunkList.back() == NULL) {
+  std::deque<Chunk>& freeChunks = d_freeChunks[sizeClass];
+  if (freeChunks.empty())
+  {
+    d_chunkList.push_back(allocateChunk(sizeClass));
+  }
+  // If there is a free chunk, use that
+  else {
+    d_chunkList.push_back(freeChunks.back());
+    freeChunks.pop_back();
+    --d_numFreeChunks;
+    ++d_chunksReused;
+  }
+  // Set up the current chunk pointers
+  d_nextFree = d_chunkList.back().d_data;
+  d_endChunk = d_nextFree + chunkBytes(sizeClass);
+}
+
+ContextMemoryManager::Chunk ContextMemoryManager::allocateChunk(
+    unsigned sizeClass)
+{
+  size_t size = chunkBytes(sizeClass);
+  Chunk chunk{nullptr, sizeClass, false};
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (d_hugePages && size == hugePageBytes)
+  {
+    // map twice the size and trim, so that the chunk is aligned to the huge
+    // page size
+    char* mem = static_cast<char*>(mmap(nullptr,
+                                        2 * size,
+                                        PROT_READ | PROT_WRITE,
+                                        MAP_PRIVATE | MAP_ANONYMOUS,
+                                        -1,
+                                        0));
+    if (mem != MAP_FAILED)
+    {
+      uintptr_t addr = reinterpret_cast<uintptr_t>(mem);
+      char* aligned = reinterpret_cast<char*>((addr + size - 1) & ~(size - 1));
+      size_t head = aligned - mem;
+      if (head > 0)
+      {
+        munmap(mem, head);
+      }
+      munmap(aligned + size, size - head);
+      // the advice is only a hint, failure is not an error
+      madvise(aligned, size, MADV_HUGEPAGE);
+      chunk.d_data = aligned;
+      chunk.d_mapped = true;
+    }
+  }
+#endif
+  if (chunk.d_data == nullptr)
+  {
+    chunk.d_data = static_cast<char*>(malloc(size));
+    if (chunk.d_data == nullptr)
+    {
       throw std::bad_alloc();
     }
+  }
+  Debug("context") << "ContextMemoryManager: new chunk of " << size
+                   << " bytes" << (chunk.d_mapped ? " (huge pages)" : "")
+                   << std::endl;
 
 #ifdef CVC5_VALGRIND
-    VALGRIND_MAKE_MEM_NOACCESS(d_chunkList.back(), chunkSizeBytes);
+  VALGRIND_MAKE_MEM_NOACCESS(chunk.d_data, size);
 #endif /* CVC5_VALGRIND */
+
+  ++d_chunksAllocated;
+  d_bytesHeld += size;
+  d_peakBytesHeld = std::max(d_peakBytesHeld, d_bytesHeld);
+  return chunk;
+}
+
+void ContextMemoryManager::releaseChunk(const Chunk& chunk)
+{
+  size_t size = chunkBytes(chunk.d_sizeClass);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (chunk.d_mapped)
+  {
+    munmap(chunk.d_data, size);
   }
-  // If there is a free chunk, use that
-  else {
-    d_chunkList.push_back(d_freeChunks.back());
-    d_freeChunks.pop_back();
+  else
+#endif
+  {
+    free(chunk.d_data);
   }
-  // Set up the current chunk pointers
-  d_nextFree = d_chunkList.back();
-  d_endChunk = d_nextFree + chunkSizeBytes;
+  ++d_chunksReleased;
+  d_bytesHeld -= size;
 }
 
-
-ContextMemoryManager::ContextMemoryManager() : d_indexChunkList(0) {
-  // Create initial chunk
-  d_chunkList.push_back((char*)malloc(chunkSizeBytes));
-  d_nextFree = d_chunkList.back();
-  if(d_nextFree == NULL) {
-    throw std::bad_alloc();
+void ContextMemoryManager::trimFreeChunks()
+{
+  for (unsigned c = numSizeClasses;
+       c > 0 && d_numFreeChunks > d_freeChunkReserve;
+       --c)
+  {
+    std::deque<Chunk>& freeChunks = d_freeChunks[c - 1];
+    while (!freeChunks.empty() && d_numFreeChunks > d_freeChunkReserve)
+    {
+      releaseChunk(freeChunks.front());
+      freeChunks.pop_front();
+      --d_numFreeChunks;
+    }
   }
-  d_endChunk = d_nextFree + chunkSizeBytes;
+}
 
+ContextMemoryManager::ContextMemoryManager()
+    : d_numFreeChunks(0),
+      d_freeChunkReserve(defaultFreeChunkReserve),
+      d_hugePages(false),
+      d_indexChunkList(0),
+      d_chunksAllocated(0),
+      d_chunksReleased(0),
+      d_chunksReused(0),
+      d_bytesHeld(0),
+      d_peakBytesHeld(0),
+      d_pops(0)
+{
 #ifdef CVC5_VALGRIND
   VALGRIND_CREATE_MEMPOOL(this, 0, false);
-  VALGRIND_MAKE_MEM_NOACCESS(d_nextFree, chunkSizeBytes);
   d_allocations.push_back(std::vector<char*>());
 #endif /* CVC5_VALGRIND */
+
+  // Create initial chunk
+  d_chunkList.push_back(allocateChunk(0));
+  d_nextFree = d_chunkList.back().d_data;
+  d_endChunk = d_nextFree + chunkSizeBytes;
 }
 
 
@@ -86,13 +190,11 @@ ContextMemoryManager::~ContextMemoryManager() {
 
   // Delete all chunks
   while(!d_chunkList.empty()) {
-    free(d_chunkList.back());
+    releaseChunk(d_chunkList.back());
     d_chunkList.pop_back();
   }
-  while(!d_freeChunks.empty()) {
-    free(d_freeChunks.back());
-    d_freeChunks.pop_back();
-  }
+  d_freeChunkReserve = 0;
+  trimFreeChunks();
 }
 
 
@@ -152,21 +254,29 @@ void ContextMemoryManager::pop() {
 
   // Free all the new chunks since the last push
   while(d_indexChunkList > d_indexChunkListStack.back()) {
-    d_freeChunks.push_back(d_chunkList.back());
+    const Chunk& chunk = d_chunkList.back();
+    d_freeChunks[chunk.d_sizeClass].push_back(chunk);
+    ++d_numFreeChunks;
 #ifdef CVC5_VALGRIND
-    VALGRIND_MAKE_MEM_NOACCESS(d_chunkList.back(), chunkSizeBytes);
+    VALGRIND_MAKE_MEM_NOACCESS(chunk.d_data, chunkBytes(chunk.d_sizeClass));
 #endif /* CVC5_VALGRIND */
     d_chunkList.pop_back();
     --d_indexChunkList;
   }
   d_indexChunkListStack.pop_back();
+  ++d_pops;
 
   // Delete excess free chunks
-  while(d_freeChunks.size() > maxFreeChunks) {
-    free(d_freeChunks.front());
-    d_freeChunks.pop_front();
-  }
+  trimFreeChunks();
 }
+
+void ContextMemoryManager::setFreeChunkReserve(size_t n)
+{
+  d_freeChunkReserve = n;
+  trimFreeChunks();
+}
+
+void ContextMemoryManager::setHugePages(bool enable) { d_hugePages = enable; }
 #else
 
 unsigned ContextMemoryManager::getMaxAllocationSize()
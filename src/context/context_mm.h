@@ -20,6 +20,8 @@
 #ifndef CVC5__CONTEXT__CONTEXT_MM_H
 #define CVC5__CONTEXT__CONTEXT_MM_H
 
+#include <cstddef>
+#include <cstdint>
 #ifndef CVC5_DEBUG_CONTEXT_MEMORY_MANAGER
 #include <deque>
 #endif
@@ -43,25 +45,63 @@ namespace context {
 class ContextMemoryManager {
 
   /**
-   * Memory in regions is allocated in chunks.  This is the chunk size
+   * Memory in regions is allocated in chunks.  This is the size of the
+   * smallest chunk, which is also the maximum allocation size.
    */
   static const unsigned chunkSizeBytes = 16384;
 
   /**
-   * A list of free chunks is maintained.  This is the maximum number of
-   * free chunks.
+   * The number of chunk sizes.  The chunks of size class i have
+   * chunkSizeBytes * 2^i bytes.  The first chunk of a region has the
+   * smallest size, and each further chunk of the same region is twice as
+   * large as the previous one, up to the largest size.  This way, regions
+   * that are filled with many objects need few chunks.
    */
-  static const unsigned maxFreeChunks = 100;
+  static const unsigned numSizeClasses = 8;
+
+  /**
+   * The size of the chunks of the largest size class, which may be backed by
+   * huge pages (see setHugePages()).
+   */
+  static const size_t hugePageBytes = size_t(chunkSizeBytes)
+                                      << (numSizeClasses - 1);
+
+  /**
+   * A list of free chunks is maintained.  This is the default maximum number
+   * of free chunks.
+   */
+  static const unsigned defaultFreeChunkReserve = 100;
+
+  /** A chunk of memory */
+  struct Chunk
+  {
+    /** The memory of the chunk */
+    char* d_data;
+    /** The size class of the chunk */
+    unsigned d_sizeClass;
+    /** Whether the chunk was obtained with mmap (rather than malloc) */
+    bool d_mapped;
+  };
 
   /**
    * List of all chunks that are currently active
    */
-  std::vector<char*> d_chunkList;
+  std::vector<Chunk> d_chunkList;
 
   /**
-   * Queue of free chunks (for best cache performance, LIFO order is used)
+   * Queues of free chunks per size class (for best cache performance, LIFO
+   * order is used)
    */
-  std::deque<char*> d_freeChunks;
+  std::deque<Chunk> d_freeChunks[numSizeClasses];
+
+  /** The number of free chunks over all size classes */
+  size_t d_numFreeChunks;
+
+  /** The maximum number of free chunks */
+  size_t d_freeChunkReserve;
+
+  /** Whether chunks of the largest size class use huge pages */
+  bool d_hugePages;
 
   /**
    * Pointer to the beginning of available memory in the current chunk in
@@ -98,6 +138,20 @@ class ContextMemoryManager {
    */
   std::vector<unsigned> d_indexChunkListStack;
 
+  /* Statistics, see accessors below. */
+  uint64_t d_chunksAllocated;
+  uint64_t d_chunksReleased;
+  uint64_t d_chunksReused;
+  uint64_t d_bytesHeld;
+  uint64_t d_peakBytesHeld;
+  uint64_t d_pops;
+
+  /** The number of bytes of the chunks of the given size class */
+  static size_t chunkBytes(unsigned sizeClass)
+  {
+    return size_t(chunkSizeBytes) << sizeClass;
+  }
+
   /**
    * Private method to grab a new chunk for the current region.  Uses chunk
    * from d_freeChunks if available.  Creates a new one otherwise.  Sets the
@@ -105,6 +159,18 @@ class ContextMemoryManager {
    */
   void newChunk();
 
+  /** Get a chunk of the given size class from the system */
+  Chunk allocateChunk(unsigned sizeClass);
+
+  /** Return the given chunk to the system */
+  void releaseChunk(const Chunk& chunk);
+
+  /**
+   * Release free chunks until there are at most d_freeChunkReserve of them,
+   * largest chunks first.
+   */
+  void trimFreeChunks();
+
 #ifdef CVC5_VALGRIND
   /**
    * Vector of allocations for each level. Used for accurately marking
@@ -147,6 +213,32 @@ class ContextMemoryManager {
    */
   void pop();
 
+  /**
+   * Set the maximum number of free chunks kept for reuse by later regions.
+   * Excess free chunks are returned to the system.
+   */
+  void setFreeChunkReserve(size_t n);
+
+  /**
+   * Enable or disable backing chunks of the largest size class by huge pages.
+   * This only has an effect on Linux, and only on chunks allocated after this
+   * call.
+   */
+  void setHugePages(bool enable);
+
+  /** Number of chunks obtained from the system. */
+  const uint64_t& numChunksAllocated() const { return d_chunksAllocated; }
+  /** Number of chunks returned to the system. */
+  const uint64_t& numChunksReleased() const { return d_chunksReleased; }
+  /** Number of chunks taken from the free chunks. */
+  const uint64_t& numChunksReused() const { return d_chunksReused; }
+  /** Number of bytes of all chunks currently held, including free ones. */
+  const uint64_t& numBytesHeld() const { return d_bytesHeld; }
+  /** Maximum of numBytesHeld() over the lifetime of this manager. */
+  const uint64_t& peakBytesHeld() const { return d_peakBytesHeld; }
+  /** Number of calls to pop(). */
+  const uint64_t& numPops() const { return d_pops; }
+
 };/* class ContextMemoryManager */
 
 #else /* CVC5_DEBUG_CONTEXT_MEMORY_MANAGER */
@@ -194,8 +286,19 @@ class ContextMemoryManager
     d_allocations.pop_back();
   }
 
+  void setFreeChunkReserve(size_t n) {}
+  void setHugePages(bool enable) {}
+
+  const uint64_t& numChunksAllocated() const { return d_zero; }
+  const uint64_t& numChunksReleased() const { return d_zero; }
+  const uint64_t& numChunksReused() const { return d_zero; }
+  const uint64_t& numBytesHeld() const { return d_zero; }
+  const uint64_t& peakBytesHeld() const { return d_zero; }
+  const uint64_t& numPops() const { return d_zero; }
+
  private:
   std::vector<std::vector<char*>> d_allocations;
+  const uint64_t d_zero = 0;
 }; /* ContextMemoryManager */
 
 #endif /* CVC5_DEBUG_CONTEXT_MEMORY_MANAGER */
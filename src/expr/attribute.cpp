@@ -49,6 +49,8 @@ void AttributeManager::deleteAllAttributes(NodeValue* nv) {
   deleteFromTable(d_nodes, nv);
   deleteFromTable(d_types, nv);
   deleteFromTable(d_strings, nv);
+  d_denseNodes.erase(nv);
+  d_denseTypes.erase(nv);
 }
 
 void AttributeManager::deleteAllAttributes() {
@@ -58,6 +60,10 @@ void AttributeManager::deleteAllAttributes() {
   deleteAllFromTable(d_nodes);
   deleteAllFromTable(d_types);
   deleteAllFromTable(d_strings);
+  d_inGarbageCollection = true;
+  d_denseNodes.clear();
+  d_denseTypes.clear();
+  d_inGarbageCollection = false;
 }
 
 void AttributeManager::deleteAttributes(const AttrIdVec& atids) {
@@ -95,6 +101,22 @@ void AttributeManager::deleteAttributes(const AttrIdVec& atids) {
     case AttrTableString:
       deleteAttributesFromTable(d_strings, ids);
       break;
+    case AttrTableDenseNode:
+      d_inGarbageCollection = true;
+      for (uint64_t id : ids)
+      {
+        d_denseNodes.eraseAttribute(id);
+      }
+      d_inGarbageCollection = false;
+      break;
+    case AttrTableDenseTypeNode:
+      d_inGarbageCollection = true;
+      for (uint64_t id : ids)
+      {
+        d_denseTypes.eraseAttribute(id);
+      }
+      d_inGarbageCollection = false;
+      break;
 
     case AttrTableCDBool:
     case AttrTableCDUInt64:
@@ -99,6 +99,12 @@ class AttributeManager {
   template <class T, class Enable>
   friend struct getTable;
 
+  /**
+   * getDenseTable<> is the analogue of getTable<> for dense attributes.
+   */
+  template <class T>
+  friend struct getDenseTable;
+
   bool d_inGarbageCollection;
 
   void clearDeleteAllAttributesBuffer();
@@ -123,6 +129,10 @@ public:
   AttrHash<TypeNode> d_types;
   /** Underlying hash table for string-valued attributes */
   AttrHash<std::string> d_strings;
+  /** Underlying table for dense node-valued attributes */
+  DenseAttrTable<Node> d_denseNodes;
+  /** Underlying table for dense type-valued attributes */
+  DenseAttrTable<TypeNode> d_denseTypes;
 
   /**
    * Get a particular attribute on a particular node.
@@ -320,6 +330,46 @@ struct getTable<std::string>
   }
 };
 
+/**
+ * The getDenseTable<> template provides (static) access to the
+ * AttributeManager field holding the table of dense attributes with values
+ * of type T.
+ */
+template <class T>
+struct getDenseTable;
+
+/** Access the "d_denseNodes" member of AttributeManager. */
+template <>
+struct getDenseTable<Node>
+{
+  static const AttrTableId id = AttrTableDenseNode;
+  typedef DenseAttrTable<Node> table_type;
+  static inline table_type& get(AttributeManager& am)
+  {
+    return am.d_denseNodes;
+  }
+  static inline const table_type& get(const AttributeManager& am)
+  {
+    return am.d_denseNodes;
+  }
+};
+
+/** Access the "d_denseTypes" member of AttributeManager. */
+template <>
+struct getDenseTable<TypeNode>
+{
+  static const AttrTableId id = AttrTableDenseTypeNode;
+  typedef DenseAttrTable<TypeNode> table_type;
+  static inline table_type& get(AttributeManager& am)
+  {
+    return am.d_denseTypes;
+  }
+  static inline const table_type& get(const AttributeManager& am)
+  {
+    return am.d_denseTypes;
+  }
+};
+
 }  // namespace attr
 
 // ATTRIBUTE MANAGER IMPLEMENTATIONS ===========================================
@@ -331,18 +381,28 @@ template <class AttrKind>
 typename AttrKind::value_type
 AttributeManager::getAttribute(NodeValue* nv, const AttrKind&) const {
   typedef typename AttrKind::value_type value_type;
-  typedef KindValueToTableValueMapping<value_type> mapping;
-  typedef typename getTable<value_type>::table_type table_type;
+  if constexpr (AttrKind::is_dense)
+  {
+    const value_type* v =
+        getDenseTable<value_type>::get(*this).find(AttrKind::getId(), nv);
+    return v == nullptr ? value_type() : *v;
+  }
+  else
+  {
+    typedef KindValueToTableValueMapping<value_type> mapping;
+    typedef typename getTable<value_type>::table_type table_type;
 
-  const table_type& ah = getTable<value_type>::get(*this);
-  typename table_type::const_iterator i =
-    ah.find(std::make_pair(AttrKind::getId(), nv));
+    const table_type& ah = getTable<value_type>::get(*this);
+    typename table_type::const_iterator i =
+        ah.find(std::make_pair(AttrKind::getId(), nv));
 
-  if(i == ah.end()) {
-    return typename AttrKind::value_type();
-  }
+    if (i == ah.end())
+    {
+      return typename AttrKind::value_type();
+    }
 
-  return mapping::convertBack((*i).second);
+    return mapping::convertBack((*i).second);
+  }
 }
 
 /* Helper template class for hasAttribute(), specialized based on
@@ -435,16 +495,40 @@ struct HasAttribute<false, AttrKind> {
 template <class AttrKind>
 bool AttributeManager::hasAttribute(NodeValue* nv,
                                     const AttrKind&) const {
-  return HasAttribute<AttrKind::has_default_value, AttrKind>::
-           hasAttribute(this, nv);
+  if constexpr (AttrKind::is_dense)
+  {
+    typedef typename AttrKind::value_type value_type;
+    return getDenseTable<value_type>::get(*this).find(AttrKind::getId(), nv)
+           != nullptr;
+  }
+  else
+  {
+    return HasAttribute<AttrKind::has_default_value, AttrKind>::hasAttribute(
+        this, nv);
+  }
 }
 
 template <class AttrKind>
 bool AttributeManager::getAttribute(NodeValue* nv,
                                     const AttrKind&,
                                     typename AttrKind::value_type& ret) const {
-  return HasAttribute<AttrKind::has_default_value, AttrKind>::
-           getAttribute(this, nv, ret);
+  if constexpr (AttrKind::is_dense)
+  {
+    typedef typename AttrKind::value_type value_type;
+    const value_type* v =
+        getDenseTable<value_type>::get(*this).find(AttrKind::getId(), nv);
+    if (v == nullptr)
+    {
+      return false;
+    }
+    ret = *v;
+    return true;
+  }
+  else
+  {
+    return HasAttribute<AttrKind::has_default_value, AttrKind>::getAttribute(
+        this, nv, ret);
+  }
 }
 
 template <class AttrKind>
@@ -453,11 +537,18 @@ AttributeManager::setAttribute(NodeValue* nv,
                                const AttrKind&,
                                const typename AttrKind::value_type& value) {
   typedef typename AttrKind::value_type value_type;
-  typedef KindValueToTableValueMapping<value_type> mapping;
-  typedef typename getTable<value_type>::table_type table_type;
+  if constexpr (AttrKind::is_dense)
+  {
+    getDenseTable<value_type>::get(*this).set(AttrKind::getId(), nv, value);
+  }
+  else
+  {
+    typedef KindValueToTableValueMapping<value_type> mapping;
+    typedef typename getTable<value_type>::table_type table_type;
 
-  table_type& ah = getTable<value_type>::get(*this);
-  ah[std::make_pair(AttrKind::getId(), nv)] = mapping::convert(value);
+    table_type& ah = getTable<value_type>::get(*this);
+    ah[std::make_pair(AttrKind::getId(), nv)] = mapping::convert(value);
+  }
 }
 
 /** Search for the NodeValue in all attribute tables and remove it. */
@@ -485,8 +576,15 @@ inline void AttributeManager::deleteAllFromTable(AttrHash<T>& table) {
 template <class AttrKind>
 AttributeUniqueId AttributeManager::getAttributeId(const AttrKind& attr){
   typedef typename AttrKind::value_type value_type;
-  AttrTableId tableId = getTable<value_type>::id;
-  return AttributeUniqueId(tableId, attr.getId());
+  if constexpr (AttrKind::is_dense)
+  {
+    return AttributeUniqueId(getDenseTable<value_type>::id, attr.getId());
+  }
+  else
+  {
+    AttrTableId tableId = getTable<value_type>::id;
+    return AttributeUniqueId(tableId, attr.getId());
+  }
 }
 
 template <class T>
@@ -536,12 +634,14 @@ void AttributeManager::reconstructTable(AttrHash<T>& table){
 template <class AttrKind>
 inline typename AttrKind::value_type
 NodeManager::getAttribute(expr::NodeValue* nv, const AttrKind&) const {
+  SharedLock lock(this);
   return d_attrManager->getAttribute(nv, AttrKind());
 }
 
 template <class AttrKind>
 inline bool NodeManager::hasAttribute(expr::NodeValue* nv,
                                       const AttrKind&) const {
+  SharedLock lock(this);
   return d_attrManager->hasAttribute(nv, AttrKind());
 }
 
@@ -549,6 +649,7 @@ template <class AttrKind>
 inline bool
 NodeManager::getAttribute(expr::NodeValue* nv, const AttrKind&,
                           typename AttrKind::value_type& ret) const {
+  SharedLock lock(this);
   return d_attrManager->getAttribute(nv, AttrKind(), ret);
 }
 
@@ -556,18 +657,21 @@ template <class AttrKind>
 inline void
 NodeManager::setAttribute(expr::NodeValue* nv, const AttrKind&,
                           const typename AttrKind::value_type& value) {
+  SharedLock lock(this);
   d_attrManager->setAttribute(nv, AttrKind(), value);
 }
 
 template <class AttrKind>
 inline typename AttrKind::value_type
 NodeManager::getAttribute(TNode n, const AttrKind&) const {
+  SharedLock lock(this);
   return d_attrManager->getAttribute(n.d_nv, AttrKind());
 }
 
 template <class AttrKind>
 inline bool
 NodeManager::hasAttribute(TNode n, const AttrKind&) const {
+  SharedLock lock(this);
   return d_attrManager->hasAttribute(n.d_nv, AttrKind());
 }
 
@@ -575,6 +679,7 @@ template <class AttrKind>
 inline bool
 NodeManager::getAttribute(TNode n, const AttrKind&,
                           typename AttrKind::value_type& ret) const {
+  SharedLock lock(this);
   return d_attrManager->getAttribute(n.d_nv, AttrKind(), ret);
 }
 
@@ -582,18 +687,21 @@ template <class AttrKind>
 inline void
 NodeManager::setAttribute(TNode n, const AttrKind&,
                           const typename AttrKind::value_type& value) {
+  SharedLock lock(this);
   d_attrManager->setAttribute(n.d_nv, AttrKind(), value);
 }
 
 template <class AttrKind>
 inline typename AttrKind::value_type
 NodeManager::getAttribute(TypeNode n, const AttrKind&) const {
+  SharedLock lock(this);
   return d_attrManager->getAttribute(n.d_nv, AttrKind());
 }
 
 template <class AttrKind>
 inline bool
 NodeManager::hasAttribute(TypeNode n, const AttrKind&) const {
+  SharedLock lock(this);
   return d_attrManager->hasAttribute(n.d_nv, AttrKind());
 }
 
@@ -601,6 +709,7 @@ template <class AttrKind>
 inline bool
 NodeManager::getAttribute(TypeNode n, const AttrKind&,
                           typename AttrKind::value_type& ret) const {
+  SharedLock lock(this);
   return d_attrManager->getAttribute(n.d_nv, AttrKind(), ret);
 }
 
@@ -608,6 +717,7 @@ template <class AttrKind>
 inline void
 NodeManager::setAttribute(TypeNode n, const AttrKind&,
                           const typename AttrKind::value_type& value) {
+  SharedLock lock(this);
   d_attrManager->setAttribute(n.d_nv, AttrKind(), value);
 }
 
@@ -22,7 +22,9 @@
 #ifndef CVC5__EXPR__ATTRIBUTE_INTERNALS_H
 #define CVC5__EXPR__ATTRIBUTE_INTERNALS_H
 
+#include <algorithm>
 #include <unordered_map>
+#include <vector>
 
 namespace cvc5 {
 namespace expr {
@@ -362,6 +364,131 @@ public:
   }
 };/* class AttrHash<bool> */
 
+/**
+ * A "DenseAttrTable<value_type>" is the table underlying dense attributes
+ * (see DenseAttribute<> below). It holds one column per attribute id,
+ * which is a vector of values indexed by the id of the NodeValue, so a
+ * lookup is a bounds check and an array access instead of a hash probe.
+ *
+ * A column spans the ids up to the largest id of a live NodeValue it is set
+ * for. It shrinks when the NodeValues with the largest ids are reclaimed,
+ * but NodeValue ids are never reused, so a single long-lived node keeps the
+ * column as large as the number of nodes created before it. Hence this only
+ * pays off for a few attributes that are set for almost all nodes, such as
+ * the type of a node.
+ */
+template <class value_type>
+class DenseAttrTable
+{
+  /** The values of one attribute. */
+  struct Column
+  {
+    /** The values, indexed by NodeValue id */
+    std::vector<value_type> d_values;
+    /** Whether the value is set, indexed by NodeValue id */
+    std::vector<bool> d_isSet;
+  };
+
+ public:
+  /**
+   * Get a pointer to the value of attribute id for nv, or null if it is not
+   * set.
+   */
+  const value_type* find(uint64_t id, const NodeValue* nv) const
+  {
+    if (id >= d_columns.size())
+    {
+      return nullptr;
+    }
+    const Column& c = d_columns[id];
+    uint64_t i = nv->getId();
+    if (i >= c.d_isSet.size() || !c.d_isSet[i])
+    {
+      return nullptr;
+    }
+    return &c.d_values[i];
+  }
+
+  /** Set the value of attribute id for nv to v. */
+  void set(uint64_t id, const NodeValue* nv, const value_type& v)
+  {
+    if (id >= d_columns.size())
+    {
+      d_columns.resize(id + 1);
+    }
+    Column& c = d_columns[id];
+    uint64_t i = nv->getId();
+    if (i >= c.d_isSet.size())
+    {
+      // grow geometrically, NodeValue ids are handed out in increasing order
+      size_t newSize = std::max<size_t>(i + 1, 2 * c.d_isSet.size());
+      c.d_values.resize(newSize);
+      c.d_isSet.resize(newSize, false);
+    }
+    c.d_isSet[i] = true;
+    c.d_values[i] = v;
+  }
+
+  /** Remove all attributes of nv. */
+  void erase(const NodeValue* nv)
+  {
+    uint64_t i = nv->getId();
+    for (Column& c : d_columns)
+    {
+      if (i < c.d_isSet.size() && c.d_isSet[i])
+      {
+        c.d_isSet[i] = false;
+        c.d_values[i] = value_type();
+        if (i + 1 == c.d_isSet.size())
+        {
+          shrink(c);
+        }
+      }
+    }
+  }
+
+  /** Remove attribute id from all nodes. */
+  void eraseAttribute(uint64_t id)
+  {
+    if (id < d_columns.size())
+    {
+      Column tmp;
+      std::swap(tmp, d_columns[id]);
+    }
+  }
+
+  /** Remove all attributes from all nodes. */
+  void clear()
+  {
+    std::vector<Column> tmp;
+    std::swap(tmp, d_columns);
+  }
+
+ private:
+  /**
+   * Drop the unset entries at the end of column c, and release memory once
+   * less than a quarter of it is used.
+   */
+  static void shrink(Column& c)
+  {
+    size_t size = c.d_isSet.size();
+    while (size > 0 && !c.d_isSet[size - 1])
+    {
+      --size;
+    }
+    c.d_values.resize(size);
+    c.d_isSet.resize(size);
+    if (size < c.d_values.capacity() / 4)
+    {
+      c.d_values.shrink_to_fit();
+      c.d_isSet.shrink_to_fit();
+    }
+  }
+
+  /** The columns, indexed by attribute id */
+  std::vector<Column> d_columns;
+}; /* class DenseAttrTable<> */
+
 }  // namespace attr
 
 // ATTRIBUTE IDENTIFIER ASSIGNMENT TEMPLATE ====================================
@@ -429,6 +556,9 @@ public:
    */
   static const bool has_default_value = false;
 
+  /** This attribute is stored in a hash table. */
+  static const bool is_dense = false;
+
   /**
    * Register this attribute kind and check that the ID is a valid ID
    * for bool-valued attributes.  Fail an assert if not.  Otherwise
@@ -472,6 +602,9 @@ public:
    */
   static const bool default_value = false;
 
+  /** This attribute is stored in a hash table. */
+  static const bool is_dense = false;
+
   /**
    * Register this attribute kind and check that the ID is a valid ID
    * for bool-valued attributes.  Fail an assert if not.  Otherwise
@@ -485,6 +618,43 @@ public:
   }
 };/* class Attribute<..., bool, ...> */
 
+/**
+ * An "attribute type" structure for dense attributes, whose values are
+ * stored in vectors indexed by NodeValue ids (see attr::DenseAttrTable<>)
+ * rather than in hash tables. This is meant for hot attributes that are set
+ * for almost all nodes, such as the type of a node. Only Node and
+ * TypeNode values are supported.
+ *
+ * @param T the tag for the attribute kind.
+ *
+ * @param value_t the underlying value_type for the attribute kind
+ */
+template <class T, class value_t>
+class DenseAttribute
+{
+  /** The unique ID associated to this attribute among dense attributes. */
+  static const uint64_t s_id;
+
+ public:
+  /** The value type for this attribute. */
+  typedef value_t value_type;
+
+  /** Get the unique ID associated to this attribute. */
+  static inline uint64_t getId() { return s_id; }
+
+  /** Dense attributes do not have a default value. */
+  static const bool has_default_value = false;
+
+  /** This attribute is stored in a dense table. */
+  static const bool is_dense = true;
+
+  /** Register this attribute kind and return its id. */
+  static inline uint64_t registerAttribute()
+  {
+    return attr::LastAttributeId<attr::DenseAttrTable<value_t>>::getNextId();
+  }
+}; /* class DenseAttribute<> */
+
 // ATTRIBUTE IDENTIFIER ASSIGNMENT =============================================
 
 /** Assign unique IDs to attributes at load time. */
@@ -497,6 +667,11 @@ template <class T>
 const uint64_t Attribute<T, bool>::s_id =
     Attribute<T, bool>::registerAttribute();
 
+/** Assign unique IDs to attributes at load time. */
+template <class T, class value_t>
+const uint64_t DenseAttribute<T, value_t>::s_id =
+    DenseAttribute<T, value_t>::registerAttribute();
+
 }  // namespace expr
 }  // namespace cvc5
 
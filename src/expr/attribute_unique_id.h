@@ -40,6 +40,8 @@ enum AttrTableId {
   AttrTableCDNode,
   AttrTableCDString,
   AttrTableCDPointer,
+  AttrTableDenseNode,
+  AttrTableDenseTypeNode,
   LastAttrTable
 };
 
@@ -358,10 +358,15 @@ void NodeBuilder::decrRefCounts()
   d_inlineNv.d_nchildren = 0;
 }
 
-TypeNode NodeBuilder::constructTypeNode() { return TypeNode(constructNV()); }
+TypeNode NodeBuilder::constructTypeNode()
+{
+  NodeManager::SharedLock lock(d_nm);
+  return TypeNode(constructNV());
+}
 
 Node NodeBuilder::constructNode()
 {
+  NodeManager::SharedLock lock(d_nm);
   Node n(constructNV());
   maybeCheckType(n);
   return n;
@@ -369,6 +374,7 @@ Node NodeBuilder::constructNode()
 
 Node* NodeBuilder::constructNodePtr()
 {
+  NodeManager::SharedLock lock(d_nm);
   std::unique_ptr<Node> np(new Node(constructNV()));
   maybeCheckType(*np.get());
   return np.release();
@@ -388,6 +394,16 @@ expr::NodeValue* NodeBuilder::constructNV()
   // NOTE: The comments in this function refer to the cases in the
   // file comments at the top of this file.
 
+  // If the node manager is shared, the callers hold its lock until the
+  // returned node is referenced. Hash-consing and id assignment must not race
+  // with other threads, and a zombie found in the pool must not be reclaimed
+  // by another thread before it is resurrected.
+
+  // In incremental reclamation mode, pay for (at most) one batch of zombie
+  // reclamation here. The children of this builder are referenced by it, so
+  // none of them can be reclaimed.
+  d_nm->reclaimZombiesIncrementally();
+
   // Case 0: If a VARIABLE
   if (getMetaKind() == kind::metakind::VARIABLE
       || getMetaKind() == kind::metakind::NULLARY_OPERATOR)
@@ -405,17 +421,13 @@ expr::NodeValue* NodeBuilder::constructNV()
            "no children permitted";
 
     // we have to copy the inline NodeValue out
-    expr::NodeValue* nv =
-        (expr::NodeValue*)std::malloc(sizeof(expr::NodeValue));
-    if (nv == nullptr)
-    {
-      throw std::bad_alloc();
-    }
+    expr::NodeValue* nv = d_nm->d_nvAllocator.allocate(0);
     // there are no children, so we don't have to worry about
     // reference counts in this case.
     nv->d_nchildren = 0;
     nv->d_kind = d_nv->d_kind;
-    nv->d_id = d_nm->next_id++;  // FIXME multithreading
+    nv->d_id = d_nm->next_id++;
+    nv->d_nmIndex = d_nm->d_threadSafeIndex;
     nv->d_rc = 0;
     setUsed();
     if (Debug.isOn("gc"))
@@ -488,16 +500,12 @@ expr::NodeValue* NodeBuilder::constructNV()
        * reference count. */
 
       // create the canonical expression value for this node
-      expr::NodeValue* nv = (expr::NodeValue*)std::malloc(
-          sizeof(expr::NodeValue)
-          + (sizeof(expr::NodeValue*) * d_inlineNv.d_nchildren));
-      if (nv == nullptr)
-      {
-        throw std::bad_alloc();
-      }
+      expr::NodeValue* nv =
+          d_nm->d_nvAllocator.allocate(d_inlineNv.d_nchildren);
       nv->d_nchildren = d_inlineNv.d_nchildren;
       nv->d_kind = d_inlineNv.d_kind;
-      nv->d_id = d_nm->next_id++;  // FIXME multithreading
+      nv->d_id = d_nm->next_id++;
+      nv->d_nmIndex = d_nm->d_threadSafeIndex;
       nv->d_rc = 0;
 
       std::copy(d_inlineNv.d_children,
@@ -548,16 +556,36 @@ expr::NodeValue* NodeBuilder::constructNV()
       /* Subcase (b) The Node under construction is NOT already in the
        * NodeManager's pool. */
 
-      /* 2(b). The heap-allocated d_nv is "cropped" to the correct
-       * size (based on the number of children it _actually_ has).
-       * d_nv is repointed to d_inlineNv so that destruction of the
-       * NodeBuilder doesn't cause any problems, and the (old) value
-       * it had is placed into the NodeManager's pool and returned in
-       * a Node wrapper. */
-
-      crop();
-      expr::NodeValue* nv = d_nv;
-      nv->d_id = d_nm->next_id++;  // FIXME multithreading
+      /* 2(b). If the node is small enough to be served by the
+       * NodeManager's slab allocator, its header and children are moved
+       * into a NodeValue obtained from there and the heap-allocated d_nv
+       * is freed.  Otherwise, the heap-allocated d_nv is "cropped" to the
+       * correct size (based on the number of children it _actually_
+       * has).  d_nv is repointed to d_inlineNv so that destruction of the
+       * NodeBuilder doesn't cause any problems, and the resulting value
+       * is placed into the NodeManager's pool and returned in a Node
+       * wrapper. */
+
+      expr::NodeValue* nv;
+      if (d_nv->d_nchildren <= expr::NodeValueAllocator::maxSlabChildren)
+      {
+        nv = d_nm->d_nvAllocator.allocate(d_nv->d_nchildren);
+        nv->d_nchildren = d_nv->d_nchildren;
+        nv->d_kind = d_nv->d_kind;
+        nv->d_rc = 0;
+        std::copy(d_nv->d_children,
+                  d_nv->d_children + d_nv->d_nchildren,
+                  nv->d_children);
+        // the child reference counts have been taken over by nv
+        free(d_nv);
+      }
+      else
+      {
+        crop();
+        nv = d_nv;
+      }
+      nv->d_id = d_nm->next_id++;
+      nv->d_nmIndex = d_nm->d_threadSafeIndex;
       d_nv = &d_inlineNv;
       d_nvMaxChildren = default_nchild_thresh;
       setUsed();
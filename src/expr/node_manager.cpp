@@ -15,6 +15,8 @@
 #include "expr/node_manager.h"
 
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <sstream>
 #include <stack>
 #include <utility>
@@ -35,6 +37,7 @@
 #include "util/abstract_value.h"
 #include "util/bitvector.h"
 #include "util/resource_manager.h"
+#include "util/statistics_stats.h"
 
 using namespace std;
 using namespace cvc5::expr;
@@ -83,6 +86,22 @@ struct NVReclaim {
   }
 };
 
+/**
+ * The node manager of the innermost active NodeManagerScope of this thread,
+ * or null if there is none.
+ */
+thread_local NodeManager* s_scopeNM = nullptr;
+
+/**
+ * The thread-safe node managers of this process, by the index they record in
+ * their nodes (see NodeManager::setThreadSafe()). Index 0 is unused.
+ */
+std::atomic<NodeManager*>
+    s_threadSafeNMs[static_cast<size_t>(1) << NodeValue::NBITS_NM_INDEX];
+
+/** Protects the assignment of indices in s_threadSafeNMs. */
+std::mutex s_threadSafeNMsMutex;
+
 } // namespace
 
 namespace attr {
@@ -100,17 +119,84 @@ NodeManager::NodeManager()
       d_attrManager(new expr::attr::AttributeManager()),
       d_nodeUnderDeletion(nullptr),
       d_inReclaimZombies(false),
+      d_zombieThreshold(5000),
+      d_zombieReclaimBatch(0),
+      d_zombieOwner(nullptr),
+      d_reclaimTimer(nullptr),
+      d_threadSafeIndex(0),
       d_abstractValueCount(0),
       d_skolemCounter(0)
 {
 }
 
-NodeManager* NodeManager::currentNM()
+NodeManager* NodeManager::threadNM()
 {
   thread_local static NodeManager nm;
   return &nm;
 }
 
+NodeManager* NodeManager::currentNM()
+{
+  if (s_scopeNM != nullptr)
+  {
+    return s_scopeNM;
+  }
+  return threadNM();
+}
+
+NodeManager* NodeManager::getOwner(const expr::NodeValue* nv)
+{
+  if (nv->d_nmIndex != 0)
+  {
+    return s_threadSafeNMs[nv->d_nmIndex].load(std::memory_order_acquire);
+  }
+  return threadNM();
+}
+
+void NodeManager::setThreadSafe()
+{
+  if (d_threadSafeIndex != 0)
+  {
+    return;
+  }
+  // existing nodes would not record this node manager
+  AlwaysAssert(next_id == 0)
+      << "NodeManager::setThreadSafe() must be called before nodes are "
+         "created";
+  std::lock_guard<std::mutex> guard(s_threadSafeNMsMutex);
+  for (uint32_t i = 1; i < (1u << NodeValue::NBITS_NM_INDEX); ++i)
+  {
+    if (s_threadSafeNMs[i].load(std::memory_order_relaxed) == nullptr)
+    {
+      s_threadSafeNMs[i].store(this, std::memory_order_release);
+      d_threadSafeIndex = i;
+      break;
+    }
+  }
+  AlwaysAssert(d_threadSafeIndex != 0)
+      << "too many thread-safe node managers: at most "
+      << (1u << NodeValue::NBITS_NM_INDEX) - 1
+      << " node managers can be thread-safe at the same time";
+  // the reclamation timer belongs to a SolverEngine of the owning thread
+  d_reclaimTimer = nullptr;
+}
+
+NodeManagerScope::NodeManagerScope(NodeManager* nm)
+    : d_nm(nm), d_prev(s_scopeNM)
+{
+  // the nodes of other node managers are never shared between threads (see
+  // NodeManager::getOwner())
+  Assert(d_nm->isThreadSafe() || d_nm == NodeManager::threadNM())
+      << "only thread-safe node managers can be entered by other threads";
+  s_scopeNM = d_nm;
+}
+
+NodeManagerScope::~NodeManagerScope()
+{
+  Assert(s_scopeNM == d_nm) << "NodeManagerScopes must be properly nested";
+  s_scopeNM = d_prev;
+}
+
 bool NodeManager::isNAryKind(Kind k)
 {
   return kind::metakind::getMaxArityForKind(k) == expr::NodeValue::MAX_CHILDREN;
@@ -279,21 +365,56 @@ NodeManager::~NodeManager() {
   // defensive coding, in case destruction-order issues pop up (they often do)
   delete d_attrManager;
   d_attrManager = NULL;
+
+  if (d_threadSafeIndex != 0)
+  {
+    std::lock_guard<std::mutex> guard(s_threadSafeNMsMutex);
+    s_threadSafeNMs[d_threadSafeIndex].store(nullptr,
+                                             std::memory_order_relaxed);
+  }
 }
 
 const DType& NodeManager::getDTypeForIndex(size_t index) const
 {
+  SharedLock lock(this);
   // if this assertion fails, it is likely due to not managing datatypes
   // properly w.r.t. multiple NodeManagers.
   Assert(index < d_dtypes.size());
   return *d_dtypes[index];
 }
 
-void NodeManager::reclaimZombies() {
-  // FIXME multithreading
+bool NodeManager::setZombieReclamation(const void* owner,
+                                       size_t threshold,
+                                       size_t batch)
+{
+  SharedLock lock(this);
+  if (d_zombieOwner != nullptr && d_zombieOwner != owner)
+  {
+    return false;
+  }
+  d_zombieOwner = owner;
+  d_zombieThreshold = threshold;
+  d_zombieReclaimBatch = batch;
+  return true;
+}
+
+void NodeManager::releaseZombieReclamation(const void* owner)
+{
+  SharedLock lock(this);
+  if (d_zombieOwner == owner)
+  {
+    d_zombieOwner = nullptr;
+  }
+}
+
+void NodeManager::reclaimZombies(size_t limit)
+{
+  // the listeners are notified of the deleted nodes under the lock
+  SharedLock lock(this);
   Assert(!d_attrManager->inGarbageCollection());
 
-  Debug("gc") << "reclaiming " << d_zombies.size() << " zombie(s)!\n";
+  Debug("gc") << "reclaiming " << d_zombies.size() << " zombie(s)"
+              << (limit > 0 ? " incrementally" : "") << "!\n";
 
   // during reclamation, reclaimZombies() is never supposed to be called
   Assert(!d_inReclaimZombies)
@@ -316,13 +437,40 @@ void NodeManager::reclaimZombies() {
   // may be invisible to us (B is leaked) or even invalidate our
   // iterator, causing a crash.  So we need to copy the set away.
 
+  //
+  // In incremental mode, only (at most) limit zombies are moved out of
+  // d_zombies, the rest is left for subsequent rounds.
+
+  std::unique_ptr<CodeTimer> reclaimTimer;
+  if (d_reclaimTimer != nullptr)
+  {
+    reclaimTimer.reset(new CodeTimer(*d_reclaimTimer));
+  }
+
   vector<NodeValue*> zombies;
-  zombies.reserve(d_zombies.size());
-  remove_copy_if(d_zombies.begin(),
-                 d_zombies.end(),
-                 back_inserter(zombies),
-                 NodeValueReferenceCountNonZero());
-  d_zombies.clear();
+  if (limit == 0 || d_zombies.size() <= limit)
+  {
+    zombies.reserve(d_zombies.size());
+    remove_copy_if(d_zombies.begin(),
+                   d_zombies.end(),
+                   back_inserter(zombies),
+                   NodeValueReferenceCountNonZero());
+    d_zombies.clear();
+  }
+  else
+  {
+    zombies.reserve(limit);
+    NodeValueIDSet::iterator it = d_zombies.begin();
+    while (zombies.size() < limit && it != d_zombies.end())
+    {
+      // zombies that have been resurrected are dropped
+      if ((*it)->d_rc == 0)
+      {
+        zombies.push_back(*it);
+      }
+      it = d_zombies.erase(it);
+    }
+  }
 
 #ifdef _LIBCPP_VERSION
   NodeValue* last = NULL;
@@ -388,10 +536,17 @@ void NodeManager::reclaimZombies() {
         // constant, but then, you should probably use a smart-pointer
         // type for a constant payload.)
         kind::metakind::deleteNodeValueConstant(nv);
+        free(nv);
+      }
+      else
+      {
+        d_nvAllocator.deallocate(nv, nv->d_nchildren);
       }
-      free(nv);
     }
   }
+
+  // release the slabs emptied by this round of reclamation in bulk
+  d_nvAllocator.releaseEmptySlabs();
 }/* NodeManager::reclaimZombies() */
 
 std::vector<NodeValue*> NodeManager::TopologicalSort(
@@ -441,6 +596,7 @@ std::vector<NodeValue*> NodeManager::TopologicalSort(
 
 TypeNode NodeManager::getType(TNode n, bool check)
 {
+  SharedLock lock(this);
   TypeNode typeNode;
   bool hasType = getAttribute(n, TypeAttr(), typeNode);
   bool needsCheck = check && !getAttribute(n, TypeCheckedAttr());
@@ -504,6 +660,7 @@ TypeNode NodeManager::getType(TNode n, bool check)
 }
 
 Node NodeManager::mkSkolem(const std::string& prefix, const TypeNode& type, const std::string& comment, int flags) {
+  SharedLock lock(this);
   Node n = NodeBuilder(this, kind::SKOLEM);
   setAttribute(n, TypeAttr(), type);
   setAttribute(n, TypeCheckedAttr(), true);
@@ -560,6 +717,7 @@ std::vector<TypeNode> NodeManager::mkMutualDatatypeTypes(
     const std::set<TypeNode>& unresolvedTypes,
     uint32_t flags)
 {
+  SharedLock lock(this);
   std::map<std::string, TypeNode> nameResolutions;
   std::vector<TypeNode> dtts;
 
@@ -814,6 +972,7 @@ TypeNode NodeManager::mkFunctionType(const std::vector<TypeNode>& argTypes,
 }
 
 TypeNode NodeManager::mkTupleType(const std::vector<TypeNode>& types) {
+  SharedLock lock(this);
   std::vector< TypeNode > ts;
   Debug("tuprec-debug") << "Make tuple type : ";
   for (unsigned i = 0; i < types.size(); ++ i) {
@@ -826,15 +985,18 @@ TypeNode NodeManager::mkTupleType(const std::vector<TypeNode>& types) {
 }
 
 TypeNode NodeManager::mkRecordType(const Record& rec) {
+  SharedLock lock(this);
   return d_rt_cache.getRecordType( this, rec );
 }
 
 void NodeManager::reclaimAllZombies(){
+  SharedLock lock(this);
   reclaimZombiesUntil(0u);
 }
 
 /** Reclaim zombies while there are more than k nodes in the pool (if possible).*/
 void NodeManager::reclaimZombiesUntil(uint32_t k){
+  SharedLock lock(this);
   if(safeToReclaimZombies()){
     while(poolSize() >= k && !d_zombies.empty()){
       reclaimZombies();
@@ -843,10 +1005,12 @@ void NodeManager::reclaimZombiesUntil(uint32_t k){
 }
 
 size_t NodeManager::poolSize() const{
+  SharedLock lock(this);
   return d_nodeValuePool.size();
 }
 
 TypeNode NodeManager::mkSort(uint32_t flags) {
+  SharedLock lock(this);
   NodeBuilder nb(this, kind::SORT_TYPE);
   Node sortTag = NodeBuilder(this, kind::SORT_TAG);
   nb << sortTag;
@@ -858,6 +1022,7 @@ TypeNode NodeManager::mkSort(uint32_t flags) {
 }
 
 TypeNode NodeManager::mkSort(const std::string& name, uint32_t flags) {
+  SharedLock lock(this);
   NodeBuilder nb(this, kind::SORT_TYPE);
   Node sortTag = NodeBuilder(this, kind::SORT_TAG);
   nb << sortTag;
@@ -872,6 +1037,7 @@ TypeNode NodeManager::mkSort(const std::string& name, uint32_t flags) {
 TypeNode NodeManager::mkSort(TypeNode constructor,
                                     const std::vector<TypeNode>& children,
                                     uint32_t flags) {
+  SharedLock lock(this);
   Assert(constructor.getKind() == kind::SORT_TYPE
          && constructor.getNumChildren() == 0)
       << "expected a sort constructor";
@@ -899,6 +1065,7 @@ TypeNode NodeManager::mkSortConstructor(const std::string& name,
                                         size_t arity,
                                         uint32_t flags)
 {
+  SharedLock lock(this);
   Assert(arity > 0);
   NodeBuilder nb(this, kind::SORT_TYPE);
   Node sortTag = NodeBuilder(this, kind::SORT_TAG);
@@ -914,6 +1081,7 @@ TypeNode NodeManager::mkSortConstructor(const std::string& name,
 
 Node NodeManager::mkVar(const std::string& name, const TypeNode& type)
 {
+  SharedLock lock(this);
   Node n = NodeBuilder(this, kind::VARIABLE);
   setAttribute(n, TypeAttr(), type);
   setAttribute(n, TypeCheckedAttr(), true);
@@ -931,6 +1099,7 @@ Node NodeManager::mkBoundVar(const std::string& name, const TypeNode& type) {
 }
 
 Node NodeManager::getBoundVarListForFunctionType( TypeNode tn ) {
+  SharedLock lock(this);
   Assert(tn.isFunction());
   Node bvl = tn.getAttribute(LambdaBoundVarListAttr());
   if( bvl.isNull() ){
@@ -1038,6 +1207,7 @@ Node NodeManager::mkChain(Kind kind, const std::vector<Node>& children)
 
 Node NodeManager::mkVar(const TypeNode& type)
 {
+  SharedLock lock(this);
   Node n = NodeBuilder(this, kind::VARIABLE);
   setAttribute(n, TypeAttr(), type);
   setAttribute(n, TypeCheckedAttr(), true);
@@ -1069,6 +1239,7 @@ Node NodeManager::mkBooleanTermVariable() {
 }
 
 Node NodeManager::mkNullaryOperator(const TypeNode& type, Kind k) {
+  SharedLock lock(this);
   std::map< TypeNode, Node >::iterator it = d_unique_vars[k].find( type );
   if( it==d_unique_vars[k].end() ){
     Node n = NodeBuilder(this, k).constructNode();
@@ -1105,6 +1276,7 @@ Node NodeManager::mkBag(const TypeNode& t, const TNode n, const TNode m)
 }
 
 Node NodeManager::mkAbstractValue(const TypeNode& type) {
+  SharedLock lock(this);
   Node n = mkConst(AbstractValue(++d_abstractValueCount));
   n.setAttribute(TypeAttr(), type);
   n.setAttribute(TypeCheckedAttr(), true);
@@ -1112,11 +1284,11 @@ Node NodeManager::mkAbstractValue(const TypeNode& type) {
 }
 
 bool NodeManager::safeToReclaimZombies() const{
-  // FIXME multithreading
   return !d_inReclaimZombies && !d_attrManager->inGarbageCollection();
 }
 
 void NodeManager::deleteAttributes(const std::vector<const expr::attr::AttributeUniqueId*>& ids){
+  SharedLock lock(this);
   d_attrManager->deleteAttributes(ids);
 }
 
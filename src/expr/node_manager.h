@@ -23,6 +23,7 @@
 #ifndef CVC5__NODE_MANAGER_H
 #define CVC5__NODE_MANAGER_H
 
+#include <mutex>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -31,6 +32,8 @@
 #include "expr/kind.h"
 #include "expr/metakind.h"
 #include "expr/node_value.h"
+#include "expr/node_value_allocator.h"
+#include "expr/node_value_pool.h"
 #include "util/floatingpoint_size.h"
 
 namespace cvc5 {
@@ -43,6 +46,7 @@ class Solver;
 
 class ResourceManager;
 class SkolemManager;
+class TimerStat;
 class BoundVarManager;
 
 class DType;
@@ -59,6 +63,12 @@ namespace expr {
 /**
  * An interface that an interested party can implement and then subscribe
  * to NodeManager events via NodeManager::subscribeEvents(this).
+ *
+ * The listeners of a thread-safe node manager (see
+ * NodeManager::setThreadSafe()) are notified while the lock of the node
+ * manager is held, from whichever thread triggers the event. Their
+ * notifications are hence serialized, but they must not access state that
+ * other threads use without that lock.
  */
 class NodeManagerListener {
  public:
@@ -90,6 +100,7 @@ class NodeManager
   friend class SkolemManager;
 
   friend class NodeBuilder;
+  friend class NodeManagerScope;
 
  public:
   /**
@@ -108,14 +119,15 @@ class NodeManager
   explicit NodeManager();
   ~NodeManager();
 
+  /** The node manager owned by the calling thread. */
+  static NodeManager* threadNM();
+
   /** Predicate for use with STL algorithms */
   struct NodeValueReferenceCountNonZero {
     bool operator()(expr::NodeValue* nv) { return nv->d_rc > 0; }
   };
 
-  typedef std::unordered_set<expr::NodeValue*,
-                             expr::NodeValuePoolHashFunction,
-                             expr::NodeValuePoolEq> NodeValuePool;
+  typedef expr::NodeValuePool NodeValuePool;
   typedef std::unordered_set<expr::NodeValue*,
                              expr::NodeValueIDHashFunction,
                              expr::NodeValueIDEquality> NodeValueIDSet;
@@ -127,6 +139,12 @@ class NodeManager
 
   NodeValuePool d_nodeValuePool;
 
+  /**
+   * The allocator for the non-constant NodeValues of this node manager. It
+   * must outlive the members below, some of which hold Nodes.
+   */
+  expr::NodeValueAllocator d_nvAllocator;
+
   bool d_initialized;
 
   size_t next_id;
@@ -158,6 +176,36 @@ class NodeManager
    */
   NodeValueIDSet d_zombies;
 
+  /**
+   * Zombie reclamation is triggered once there are more than this many
+   * zombies.
+   */
+  size_t d_zombieThreshold;
+
+  /**
+   * If non-zero, zombies are reclaimed incrementally: a round of reclamation
+   * processes at most this many zombies, and node construction reclaims a
+   * batch whenever this many zombies are pending. If zero, every round
+   * reclaims all zombies.
+   */
+  size_t d_zombieReclaimBatch;
+
+  /** The owner of the zombie reclamation settings, if any */
+  const void* d_zombieOwner;
+
+  /** Timer for zombie reclamation (owned by a SolverEngine, may be null). */
+  TimerStat* d_reclaimTimer;
+
+  /**
+   * The index of this node manager among the thread-safe node managers of
+   * this process, recorded in all of its nodes, or 0 if it is not
+   * thread-safe (see setThreadSafe()).
+   */
+  uint32_t d_threadSafeIndex;
+
+  /** The lock of a thread-safe node manager (see SharedLock). */
+  mutable std::recursive_mutex d_mutex;
+
   /**
    * NodeValues with maxed out reference counts. These live as long as the
    * NodeManager. They have a custom deallocation procedure at the very end.
@@ -273,6 +321,7 @@ class NodeManager
    * Register a NodeValue as a zombie.
    */
   inline void markForDeletion(expr::NodeValue* nv) {
+    SharedLock lock(this);
     Assert(nv->d_rc == 0);
 
     // if d_reclaiming is set, make sure we don't call
@@ -294,17 +343,34 @@ class NodeManager
     d_zombies.insert(nv);
 
     if(safeToReclaimZombies()) {
-      if(d_zombies.size() > 5000) {
-        reclaimZombies();
+      if (d_zombies.size() > d_zombieThreshold)
+      {
+        reclaimZombies(d_zombieReclaimBatch);
       }
     }
   }
 
+  /**
+   * If incremental zombie reclamation is enabled and at least a batch of
+   * zombies is pending, reclaim one batch. This is called when constructing
+   * nodes, so that reclamation work is spread over term construction instead
+   * of occurring in bursts.
+   */
+  inline void reclaimZombiesIncrementally()
+  {
+    if (d_zombieReclaimBatch > 0 && d_zombies.size() >= d_zombieReclaimBatch
+        && safeToReclaimZombies())
+    {
+      reclaimZombies(d_zombieReclaimBatch);
+    }
+  }
+
   /**
    * Register a NodeValue as having a maxed out reference count. This NodeValue
    * will live as long as its containing NodeManager.
    */
   inline void markRefCountMaxedOut(expr::NodeValue* nv) {
+    SharedLock lock(this);
     Assert(nv->HasMaximizedReferenceCount());
     if(Debug.isOn("gc")) {
       Debug("gc") << "marking node value " << nv
@@ -314,9 +380,19 @@ class NodeManager
   }
 
   /**
-   * Reclaim all zombies.
+   * Get the node manager owning nv. This is the thread-safe node manager
+   * recorded in nv, if any, and the node manager of the calling thread
+   * otherwise, since the nodes of other node managers are never shared
+   * between threads.
    */
-  void reclaimZombies();
+  static NodeManager* getOwner(const expr::NodeValue* nv);
+
+  /**
+   * Reclaim zombies. If limit is non-zero, at most limit zombies are
+   * reclaimed, and the remaining ones are left for later rounds. Otherwise,
+   * all zombies are reclaimed.
+   */
+  void reclaimZombies(size_t limit = 0);
 
   /**
    * It is safe to collect zombies.
@@ -387,15 +463,113 @@ class NodeManager
    */
   void init();
 
-  /** The node manager in the current public-facing cvc5 library context */
+  /**
+   * The node manager in the current public-facing cvc5 library context. This
+   * is the node manager of the innermost active NodeManagerScope of the
+   * calling thread if there is one, and the node manager owned by the calling
+   * thread otherwise.
+   */
   static NodeManager* currentNM();
+
+  /**
+   * RAII guard that holds the lock of a thread-safe node manager for its
+   * lifetime. It does nothing for node managers that are not thread-safe.
+   * The lock is recursive.
+   */
+  class SharedLock
+  {
+   public:
+    SharedLock(const NodeManager* nm)
+        : d_mutex(nm->d_threadSafeIndex != 0 ? &nm->d_mutex : nullptr)
+    {
+      if (d_mutex != nullptr)
+      {
+        d_mutex->lock();
+      }
+    }
+    ~SharedLock()
+    {
+      if (d_mutex != nullptr)
+      {
+        d_mutex->unlock();
+      }
+    }
+    SharedLock(const SharedLock&) = delete;
+    SharedLock& operator=(const SharedLock&) = delete;
+
+   private:
+    std::recursive_mutex* d_mutex;
+  };
+
+  /**
+   * Make this node manager thread-safe, so that other threads may enter it
+   * with a NodeManagerScope and share its nodes, e.g., to run several
+   * SolverEngines on the same terms in parallel.
+   *
+   * From then on, hash-consing, node attributes and types, and the caches of
+   * this node manager are protected by a (recursive) lock. Each node of this
+   * node manager records its index (see d_threadSafeIndex), so that its
+   * reference count is updated atomically and it becomes a zombie of this
+   * node manager in whichever thread it is released. Nodes of other node
+   * managers keep the non-atomic reference counting. Listeners (see
+   * subscribeEvents()) are notified under the lock, from whichever thread
+   * creates or releases a node.
+   *
+   * Zombies may be reclaimed while other threads are in a NodeManagerScope
+   * of this node manager. As for a single thread, a thread must hence keep
+   * the nodes it refers to by TNodes alive by Nodes.
+   *
+   * This must be called by the thread owning this node manager before this
+   * node manager creates any node (in particular, before init()), and cannot
+   * be undone. As the index is stored in the 4 bits of NodeValue::d_nmIndex
+   * and 0 is reserved, at most 15 node managers can be thread-safe at the
+   * same time; the index of a node manager is only reused once it is
+   * destroyed. Exceeding this limit is a fatal error, also in production
+   * builds.
+   */
+  void setThreadSafe();
+  /** Is this node manager thread-safe? */
+  bool isThreadSafe() const { return d_threadSafeIndex != 0; }
   /** Get this node manager's skolem manager */
   SkolemManager* getSkolemManager() { return d_skManager.get(); }
   /** Get this node manager's bound variable manager */
   BoundVarManager* getBoundVarManager() { return d_bvManager.get(); }
+  /**
+   * Configure zombie reclamation: a round of reclamation is triggered when
+   * more than threshold zombies are pending; if batch is non-zero, each round
+   * reclaims at most batch zombies (see d_zombieReclaimBatch).
+   *
+   * These settings are per node manager and have a single owner, which is
+   * the first non-null owner to configure them (in practice, the first
+   * SolverEngine initialized in the thread of this node manager). Calls by
+   * other owners are ignored until the owner releases the settings with
+   * releaseZombieReclamation(). A null owner configures the settings without
+   * claiming them, provided they are not owned.
+   *
+   * @return true if the settings were applied
+   */
+  bool setZombieReclamation(const void* owner, size_t threshold, size_t batch);
+  /**
+   * Release the ownership of the zombie reclamation settings if owner holds
+   * it. The settings keep their values until they are configured again.
+   */
+  void releaseZombieReclamation(const void* owner);
+  /**
+   * Set the timer used for zombie reclamation, or unset it if timer is null.
+   * The timer must outlive its use by this node manager.
+   */
+  void setReclaimTimer(TimerStat* timer) { d_reclaimTimer = timer; }
+  /** Get the timer used for zombie reclamation, if any */
+  TimerStat* getReclaimTimer() const { return d_reclaimTimer; }
+  /** Get the allocator for the NodeValues of this node manager */
+  const expr::NodeValueAllocator& getNodeValueAllocator() const
+  {
+    return d_nvAllocator;
+  }
 
   /** Subscribe to NodeManager events */
   void subscribeEvents(NodeManagerListener* listener) {
+    SharedLock lock(this);
     Assert(std::find(d_listeners.begin(), d_listeners.end(), listener)
            == d_listeners.end())
         << "listener already subscribed";
@@ -404,6 +578,7 @@ class NodeManager
 
   /** Unsubscribe from NodeManager events */
   void unsubscribeEvents(NodeManagerListener* listener) {
+    SharedLock lock(this);
     std::vector<NodeManagerListener*>::iterator elt = std::find(d_listeners.begin(), d_listeners.end(), listener);
     Assert(elt != d_listeners.end()) << "listener not subscribed";
     d_listeners.erase(elt);
@@ -1062,6 +1237,26 @@ class NodeManager
   void debugHook(int debugFlag);
 }; /* class NodeManager */
 
+/**
+ * Makes a node manager the current node manager of the calling thread (see
+ * NodeManager::currentNM()) for the lifetime of this object. This is how a
+ * thread enters a thread-safe node manager owned by another thread.
+ */
+class NodeManagerScope
+{
+ public:
+  NodeManagerScope(NodeManager* nm);
+  ~NodeManagerScope();
+  NodeManagerScope(const NodeManagerScope&) = delete;
+  NodeManagerScope& operator=(const NodeManagerScope&) = delete;
+
+ private:
+  /** The node manager of this scope */
+  NodeManager* d_nm;
+  /** The node manager of the enclosing scope, if any */
+  NodeManager* d_prev;
+}; /* class NodeManagerScope */
+
 inline TypeNode NodeManager::mkArrayType(TypeNode indexType,
                                          TypeNode constituentType) {
   CheckArgument(!indexType.isNull(), indexType,
@@ -1081,25 +1276,19 @@ inline TypeNode NodeManager::mkSetType(TypeNode elementType) {
 }
 
 inline expr::NodeValue* NodeManager::poolLookup(expr::NodeValue* nv) const {
-  NodeValuePool::const_iterator find = d_nodeValuePool.find(nv);
-  if(find == d_nodeValuePool.end()) {
-    return NULL;
-  } else {
-    return *find;
-  }
+  return d_nodeValuePool.find(nv);
 }
 
 inline void NodeManager::poolInsert(expr::NodeValue* nv) {
-  Assert(d_nodeValuePool.find(nv) == d_nodeValuePool.end())
+  Assert(d_nodeValuePool.find(nv) == nullptr)
       << "NodeValue already in the pool!";
-  d_nodeValuePool.insert(nv);// FIXME multithreading
+  d_nodeValuePool.insert(nv);
 }
 
 inline void NodeManager::poolRemove(expr::NodeValue* nv) {
-  Assert(d_nodeValuePool.find(nv) != d_nodeValuePool.end())
-      << "NodeValue is not in the pool!";
+  Assert(d_nodeValuePool.find(nv) == nv) << "NodeValue is not in the pool!";
 
-  d_nodeValuePool.erase(nv);// FIXME multithreading
+  d_nodeValuePool.erase(nv);
 }
 
 }  // namespace cvc5
@@ -1283,6 +1472,7 @@ TypeNode NodeManager::mkTypeConst(const T& val) {
 
 template <class NodeClass, class T>
 NodeClass NodeManager::mkConstInternal(const T& val) {
+  SharedLock lock(this);
   // typedef typename kind::metakind::constantMap<T>::OwningTheory theory_t;
   NVStorage<1> nvStorage;
   expr::NodeValue& nvStack = reinterpret_cast<expr::NodeValue&>(nvStorage);
@@ -1317,7 +1507,8 @@ NodeClass NodeManager::mkConstInternal(const T& val) {
 
   nv->d_nchildren = 0;
   nv->d_kind = kind::metakind::ConstantMap<T>::kind;
-  nv->d_id = next_id++;// FIXME multithreading
+  nv->d_id = next_id++;
+  nv->d_nmIndex = d_threadSafeIndex;
   nv->d_rc = 0;
 
   //OwningTheory::mkConst(val);
@@ -34,7 +34,7 @@ namespace attr {
 
 typedef Attribute<attr::VarNameTag, std::string> VarNameAttr;
 typedef Attribute<attr::SortArityTag, uint64_t> SortArityAttr;
-typedef expr::Attribute<expr::attr::TypeTag, TypeNode> TypeAttr;
+typedef expr::DenseAttribute<expr::attr::TypeTag, TypeNode> TypeAttr;
 typedef expr::Attribute<expr::attr::TypeCheckedTag, bool> TypeCheckedAttr;
 
 }  // namespace expr
@@ -162,7 +162,11 @@ class NodeValue
   }
 
   /* ------------------------------ Header ---------------------------------- */
-  /** Number of bits reserved for reference counting. */
+  /**
+   * Number of bits used for reference counting. The reference count is
+   * stored in a full 32-bit word so that it can be updated atomically (see
+   * inc()), but it saturates at MAX_RC.
+   */
   static constexpr uint32_t NBITS_REFCOUNT = 20;
   /** Number of bits reserved for node kind. */
   static constexpr uint32_t NBITS_KIND = 10;
@@ -170,15 +174,26 @@ class NodeValue
   static constexpr uint32_t NBITS_ID = 40;
   /** Number of bits reserved for number of children. */
   static const uint32_t NBITS_NCHILDREN = 26;
-  static_assert(NBITS_REFCOUNT + NBITS_KIND + NBITS_ID + NBITS_NCHILDREN == 96,
-                "NodeValue header bit assignment does not sum to 96 !");
-  /* ------------------- This header fits into 96 bits ---------------------- */
+  /**
+   * Number of bits reserved for the index of a thread-safe node manager. This
+   * limits the number of node managers that are thread-safe at the same time
+   * to 15 (see NodeManager::setThreadSafe()).
+   */
+  static constexpr uint32_t NBITS_NM_INDEX = 4;
+  static_assert(32 + NBITS_KIND + NBITS_ID + NBITS_NCHILDREN + NBITS_NM_INDEX
+                    <= 128,
+                "NodeValue header bit assignment exceeds 128 bits !");
+  /* ------------------- This header fits into 128 bits --------------------- */
 
   /** Maximum number of children possible. */
   static constexpr uint32_t MAX_CHILDREN =
       (static_cast<uint32_t>(1) << NBITS_NCHILDREN) - 1;
 
-  uint32_t getRefCount() const { return d_rc; }
+  uint32_t getRefCount() const
+  {
+    // atomic, since the node may be shared by several threads
+    return __atomic_load_n(&d_rc, __ATOMIC_RELAXED);
+  }
 
   NodeValue* getOperator() const;
   NodeValue* getChild(int i) const;
@@ -299,6 +314,9 @@ class NodeValue
 
   void inc();
   void dec();
+  /** Atomic versions of inc() and dec(), for thread-safe node managers. */
+  void incAtomic();
+  void decAtomic();
 
   /** Decrement ref counts of children */
   inline void decrRefCounts();
@@ -330,15 +348,26 @@ class NodeValue
   /** The ID (0 is reserved for the null value) */
   uint64_t d_id : NBITS_ID;
 
-  /** The expression's reference count. */
-  uint32_t d_rc : NBITS_REFCOUNT;
-
   /** Kind of the expression */
   uint32_t d_kind : NBITS_KIND;
 
+  /**
+   * The index of the thread-safe node manager owning this node (see
+   * NodeManager::setThreadSafe()), or 0 if its node manager is not
+   * thread-safe. Nodes with a non-zero index are reference counted
+   * atomically.
+   */
+  uint32_t d_nmIndex : NBITS_NM_INDEX;
+
   /** Number of children */
   uint32_t d_nchildren : NBITS_NCHILDREN;
 
+  /**
+   * The expression's reference count. This is not a bit-field so that it can
+   * be updated atomically.
+   */
+  uint32_t d_rc;
+
   /** Variable number of child nodes */
   NodeValue* d_children[0];
 }; /* class NodeValue */
@@ -402,11 +431,13 @@ inline std::ostream& operator<<(std::ostream& out, const NodeValue& nv);
 namespace cvc5 {
 namespace expr {
 
-inline NodeValue::NodeValue(int) :
-  d_id(0),
-  d_rc(MAX_RC),
-  d_kind(kind::NULL_EXPR),
-  d_nchildren(0) {
+inline NodeValue::NodeValue(int)
+    : d_id(0),
+      d_kind(kind::NULL_EXPR),
+      d_nmIndex(0),
+      d_nchildren(0),
+      d_rc(MAX_RC)
+{
 }
 
 inline void NodeValue::decrRefCounts() {
@@ -419,33 +450,84 @@ inline void NodeValue::inc() {
   Assert(!isBeingDeleted())
       << "NodeValue is currently being deleted "
          "and increment is being called on it. Don't Do That!";
-  // FIXME multithreading
+  if (__builtin_expect((d_nmIndex != 0), false))
+  {
+    incAtomic();
+    return;
+  }
   if (__builtin_expect((d_rc < MAX_RC - 1), true)) {
     ++d_rc;
   } else if (__builtin_expect((d_rc == MAX_RC - 1), false)) {
     ++d_rc;
-    Assert(NodeManager::currentNM() != NULL)
-        << "No current NodeManager on incrementing of NodeValue: "
-           "maybe a public cvc5 interface function is missing a "
-           "NodeManagerScope ?";
-    NodeManager::currentNM()->markRefCountMaxedOut(this);
+    NodeManager::getOwner(this)->markRefCountMaxedOut(this);
   }
 }
 
 inline void NodeValue::dec() {
-  // FIXME multithreading
+  if (__builtin_expect((d_nmIndex != 0), false))
+  {
+    decAtomic();
+    return;
+  }
   if(__builtin_expect( ( d_rc < MAX_RC ), true )) {
     --d_rc;
     if(__builtin_expect( ( d_rc == 0 ), false )) {
-      Assert(NodeManager::currentNM() != NULL)
-          << "No current NodeManager on destruction of NodeValue: "
-             "maybe a public cvc5 interface function is missing a "
-             "NodeManagerScope ?";
-      NodeManager::currentNM()->markForDeletion(this);
+      NodeManager::getOwner(this)->markForDeletion(this);
+    }
+  }
+}
+
+inline void NodeValue::incAtomic()
+{
+  uint32_t rc = __atomic_load_n(&d_rc, __ATOMIC_RELAXED);
+  do
+  {
+    if (rc == MAX_RC)
+    {
+      return;
     }
+  } while (!__atomic_compare_exchange_n(
+      &d_rc, &rc, rc + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+  if (__builtin_expect((rc + 1 == MAX_RC), false))
+  {
+    NodeManager::getOwner(this)->markRefCountMaxedOut(this);
   }
 }
 
+inline void NodeValue::decAtomic()
+{
+  uint32_t rc = __atomic_load_n(&d_rc, __ATOMIC_RELAXED);
+  do
+  {
+    if (rc == MAX_RC)
+    {
+      return;
+    }
+    Assert(rc > 0) << "NodeValue reference count would be negative";
+    if (__builtin_expect((rc == 1), false))
+    {
+      // The count only drops to zero under the lock of the node manager, as
+      // zombies are only resurrected (through the pool) and reclaimed under
+      // that lock. Otherwise, this node could be reclaimed by another thread
+      // before it is marked for deletion here.
+      NodeManager* nm = NodeManager::getOwner(this);
+      NodeManager::SharedLock lock(nm);
+      rc = __atomic_load_n(&d_rc, __ATOMIC_RELAXED);
+      while (rc != MAX_RC
+             && !__atomic_compare_exchange_n(
+                 &d_rc, &rc, rc - 1, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+      {
+      }
+      if (rc == 1)
+      {
+        nm->markForDeletion(this);
+      }
+      return;
+    }
+  } while (!__atomic_compare_exchange_n(
+      &d_rc, &rc, rc - 1, true, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+}
+
 inline NodeValue::nv_iterator NodeValue::nv_begin() {
   return d_children;
 }
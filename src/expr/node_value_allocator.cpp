@@ -0,0 +1,295 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A size-class slab allocator for NodeValues.
+ */
+
+#include "expr/node_value_allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "base/check.h"
+#include "base/output.h"
+#include "expr/node_value.h"
+
+namespace cvc5 {
+namespace expr {
+
+/**
+ * The header of a slab. It is placed at the beginning of the slab and is
+ * followed by the objects of the slab.
+ */
+struct NodeValueAllocator::Slab
+{
+  /** Previous slab in the list this slab is linked into. */
+  Slab* d_prev;
+  /** Next slab in the list this slab is linked into. */
+  Slab* d_next;
+  /** Intrusive list of freed objects of this slab. */
+  void* d_free;
+  /** The first object of this slab that was never handed out. */
+  char* d_bump;
+  /** One past the last byte of this slab. */
+  char* d_end;
+  /** Number of live objects in this slab. */
+  uint32_t d_live;
+  /** The size class of this slab. */
+  uint32_t d_class;
+};
+
+namespace {
+
+/** Offset of the first object in a slab. */
+constexpr size_t slabHeaderBytes =
+    (sizeof(void*) * 8 + alignof(std::max_align_t) - 1)
+    & ~(alignof(std::max_align_t) - 1);
+
+}  // namespace
+
+NodeValueAllocator::NodeValueAllocator()
+    : d_emptySlabs(0),
+      d_slabsAllocated(0),
+      d_slabsReleased(0),
+      d_slabs(0),
+      d_slabObjects(0),
+      d_slabBytesUsed(0)
+{
+  static_assert((slabSizeBytes & (slabSizeBytes - 1)) == 0,
+                "slab size must be a power of two");
+  static_assert(sizeof(Slab) <= slabHeaderBytes, "slab header too small");
+  for (size_t c = 0; c <= maxSlabChildren; ++c)
+  {
+    d_classes[c].d_objSize = sizeof(NodeValue) + c * sizeof(NodeValue*);
+    d_classes[c].d_partial = nullptr;
+    d_classes[c].d_full = nullptr;
+    d_classes[c].d_empty = 0;
+  }
+}
+
+NodeValueAllocator::~NodeValueAllocator()
+{
+  for (SizeClass& sc : d_classes)
+  {
+    while (sc.d_partial != nullptr)
+    {
+      Slab* s = sc.d_partial;
+      unlink(sc.d_partial, s);
+      freeSlab(s);
+    }
+    while (sc.d_full != nullptr)
+    {
+      Slab* s = sc.d_full;
+      unlink(sc.d_full, s);
+      freeSlab(s);
+    }
+  }
+}
+
+NodeValueAllocator::Slab* NodeValueAllocator::slabOf(void* p)
+{
+  return reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(p)
+                                 & ~(uintptr_t)(slabSizeBytes - 1));
+}
+
+bool NodeValueAllocator::isFull(const SizeClass& sc, const Slab* s)
+{
+  return s->d_free == nullptr && s->d_bump + sc.d_objSize > s->d_end;
+}
+
+void NodeValueAllocator::link(Slab*& list, Slab* s)
+{
+  s->d_prev = nullptr;
+  s->d_next = list;
+  if (list != nullptr)
+  {
+    list->d_prev = s;
+  }
+  list = s;
+}
+
+void NodeValueAllocator::unlink(Slab*& list, Slab* s)
+{
+  if (s->d_prev != nullptr)
+  {
+    s->d_prev->d_next = s->d_next;
+  }
+  else
+  {
+    Assert(list == s);
+    list = s->d_next;
+  }
+  if (s->d_next != nullptr)
+  {
+    s->d_next->d_prev = s->d_prev;
+  }
+  s->d_prev = nullptr;
+  s->d_next = nullptr;
+}
+
+NodeValueAllocator::Slab* NodeValueAllocator::newSlab(size_t c)
+{
+  char* mem =
+      static_cast<char*>(std::aligned_alloc(slabSizeBytes, slabSizeBytes));
+  if (mem == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  Slab* s = reinterpret_cast<Slab*>(mem);
+  s->d_free = nullptr;
+  s->d_bump = mem + slabHeaderBytes;
+  s->d_end = mem + slabSizeBytes;
+  s->d_live = 0;
+  s->d_class = c;
+  link(d_classes[c].d_partial, s);
+  ++d_slabsAllocated;
+  ++d_slabs;
+  notifyEmpty(s, true);
+  Debug("nv-alloc") << "new slab " << s << " for size class " << c
+                    << std::endl;
+  return s;
+}
+
+void NodeValueAllocator::freeSlab(Slab* s)
+{
+  Debug("nv-alloc") << "releasing slab " << s << " of size class "
+                    << s->d_class << std::endl;
+  if (s->d_live == 0)
+  {
+    notifyEmpty(s, false);
+  }
+  ++d_slabsReleased;
+  --d_slabs;
+  std::free(s);
+}
+
+NodeValue* NodeValueAllocator::allocate(size_t nchildren)
+{
+  if (nchildren > maxSlabChildren)
+  {
+    void* mem =
+        std::malloc(sizeof(NodeValue) + nchildren * sizeof(NodeValue*));
+    if (mem == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+    return static_cast<NodeValue*>(mem);
+  }
+
+  SizeClass& sc = d_classes[nchildren];
+  Slab* s = sc.d_partial != nullptr ? sc.d_partial : newSlab(nchildren);
+  Assert(!isFull(sc, s));
+
+  void* obj;
+  if (s->d_free != nullptr)
+  {
+    obj = s->d_free;
+    s->d_free = *static_cast<void**>(obj);
+  }
+  else
+  {
+    obj = s->d_bump;
+    s->d_bump += sc.d_objSize;
+  }
+  if (s->d_live++ == 0)
+  {
+    notifyEmpty(s, false);
+  }
+  if (isFull(sc, s))
+  {
+    unlink(sc.d_partial, s);
+    link(sc.d_full, s);
+  }
+  ++d_slabObjects;
+  d_slabBytesUsed += sc.d_objSize;
+  return static_cast<NodeValue*>(obj);
+}
+
+void NodeValueAllocator::deallocate(NodeValue* nv, size_t nchildren)
+{
+  if (nchildren > maxSlabChildren)
+  {
+    std::free(nv);
+    return;
+  }
+
+  SizeClass& sc = d_classes[nchildren];
+  Slab* s = slabOf(nv);
+  Assert(s->d_class == nchildren) << "NodeValue freed with wrong size class";
+  Assert(s->d_live > 0);
+
+  if (isFull(sc, s))
+  {
+    unlink(sc.d_full, s);
+    link(sc.d_partial, s);
+  }
+  *reinterpret_cast<void**>(nv) = s->d_free;
+  s->d_free = nv;
+  if (--s->d_live == 0)
+  {
+    notifyEmpty(s, true);
+  }
+  --d_slabObjects;
+  d_slabBytesUsed -= sc.d_objSize;
+}
+
+void NodeValueAllocator::notifyEmpty(Slab* s, bool empty)
+{
+  if (empty)
+  {
+    ++d_classes[s->d_class].d_empty;
+    ++d_emptySlabs;
+  }
+  else
+  {
+    --d_classes[s->d_class].d_empty;
+    --d_emptySlabs;
+  }
+}
+
+void NodeValueAllocator::releaseEmptySlabs()
+{
+  if (d_emptySlabs == 0)
+  {
+    return;
+  }
+  for (SizeClass& sc : d_classes)
+  {
+    // only walk the classes with more empty slabs than the reserve
+    if (sc.d_empty <= 1)
+    {
+      continue;
+    }
+    // keep the first empty slab of each class as a reserve
+    bool keptOne = false;
+    Slab* s = sc.d_partial;
+    while (s != nullptr && sc.d_empty > 1)
+    {
+      Slab* next = s->d_next;
+      if (s->d_live == 0)
+      {
+        if (keptOne)
+        {
+          unlink(sc.d_partial, s);
+          freeSlab(s);
+        }
+        keptOne = true;
+      }
+      s = next;
+    }
+  }
+}
+
+}  // namespace expr
+}  // namespace cvc5
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A size-class slab allocator for NodeValues.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__EXPR__NODE_VALUE_ALLOCATOR_H
+#define CVC5__EXPR__NODE_VALUE_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cvc5 {
+namespace expr {
+
+class NodeValue;
+
+/**
+ * Slab allocator for the NodeValues owned by a NodeManager.
+ *
+ * A NodeValue with n children occupies sizeof(NodeValue) + n pointers. For
+ * every n up to maxSlabChildren there is one size class, whose objects are
+ * carved out of fixed-size, size-aligned slabs. Each slab keeps its own free
+ * list and a count of live objects, so that the slab owning a NodeValue can
+ * be found by masking its address, and a slab whose objects have all been
+ * freed can be handed back to the system in one piece.
+ *
+ * Slabs that become empty are not released immediately (this would make a
+ * node that is repeatedly created and garbage collected thrash the system
+ * allocator). Instead, the NodeManager calls releaseEmptySlabs() once it has
+ * finished reclaiming a batch of zombies.
+ *
+ * NodeValues with more than maxSlabChildren children are allocated with
+ * malloc() as before. Constants are not handled by this allocator since the
+ * size of their payload is not recoverable from the NodeValue itself.
+ */
+class NodeValueAllocator
+{
+ public:
+  /** The largest number of children served from a slab. */
+  static constexpr size_t maxSlabChildren = 32;
+  /** The size (and alignment) of a slab in bytes. */
+  static constexpr size_t slabSizeBytes = 64 * 1024;
+
+  NodeValueAllocator();
+  ~NodeValueAllocator();
+
+  /**
+   * Allocate uninitialized storage for a NodeValue with `nchildren`
+   * children. Throws std::bad_alloc on failure.
+   */
+  NodeValue* allocate(size_t nchildren);
+
+  /**
+   * Release the storage of `nv`, which must have been obtained from
+   * allocate(nchildren) of this allocator.
+   */
+  void deallocate(NodeValue* nv, size_t nchildren);
+
+  /**
+   * Return all slabs without live objects to the system, keeping at most one
+   * empty slab per size class as a reserve.
+   */
+  void releaseEmptySlabs();
+
+  /** Number of slabs allocated over the lifetime of this allocator. */
+  const uint64_t& numSlabsAllocated() const { return d_slabsAllocated; }
+  /** Number of slabs released over the lifetime of this allocator. */
+  const uint64_t& numSlabsReleased() const { return d_slabsReleased; }
+  /** Number of slabs currently held by this allocator. */
+  const uint64_t& numSlabs() const { return d_slabs; }
+  /** Number of NodeValues currently living in slabs. */
+  const uint64_t& numSlabObjects() const { return d_slabObjects; }
+  /** Number of bytes used by live NodeValues in slabs. */
+  const uint64_t& numSlabBytesUsed() const { return d_slabBytesUsed; }
+
+ private:
+  struct Slab;
+
+  /** The slabs of one size class. */
+  struct SizeClass
+  {
+    /** Size of one object of this class in bytes. */
+    size_t d_objSize;
+    /** Slabs of this class with at least one free object. */
+    Slab* d_partial;
+    /** Slabs of this class without free objects. */
+    Slab* d_full;
+    /** Number of slabs of this class without live objects. */
+    size_t d_empty;
+  };
+
+  /** Get the slab containing `p`. */
+  static Slab* slabOf(void* p);
+  /** Is slab `s` of size class `sc` full? */
+  static bool isFull(const SizeClass& sc, const Slab* s);
+  /** Link `s` at the front of list `list`. */
+  static void link(Slab*& list, Slab* s);
+  /** Unlink `s` from list `list`. */
+  static void unlink(Slab*& list, Slab* s);
+
+  /** Allocate a new slab for size class `c` and put it on its partial list. */
+  Slab* newSlab(size_t c);
+  /** Free slab `s`. */
+  void freeSlab(Slab* s);
+  /** Update the empty slab counts after slab `s` became (non-)empty. */
+  void notifyEmpty(Slab* s, bool empty);
+
+  /** The size classes, indexed by number of children. */
+  SizeClass d_classes[maxSlabChildren + 1];
+
+  /** Number of slabs without live objects. */
+  size_t d_emptySlabs;
+
+  /* Statistics, see accessors above. */
+  uint64_t d_slabsAllocated;
+  uint64_t d_slabsReleased;
+  uint64_t d_slabs;
+  uint64_t d_slabObjects;
+  uint64_t d_slabBytesUsed;
+}; /* class NodeValueAllocator */
+
+}  // namespace expr
+}  // namespace cvc5
+
+#endif /* CVC5__EXPR__NODE_VALUE_ALLOCATOR_H */
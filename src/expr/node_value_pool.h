@@ -0,0 +1,258 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * An open-addressing hash-consing table for NodeValues.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__EXPR__NODE_VALUE_POOL_H
+#define CVC5__EXPR__NODE_VALUE_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "base/check.h"
+#include "expr/metakind.h"
+#include "expr/node_value.h"
+
+namespace cvc5 {
+namespace expr {
+
+/**
+ * The pool of NodeValues used by the NodeManager for hash-consing.
+ *
+ * This is a Robin Hood hash table with linear probing and backward-shift
+ * deletion. Each slot stores the NodeValue together with its pool hash, so
+ * that probing only dereferences NodeValues whose hash matches the one being
+ * looked up, and the probe sequence of a lookup stays in a few contiguous
+ * cache lines.
+ *
+ * Lookups use structural equality (NodeValuePoolEq), hence may be given a
+ * NodeValue that is not fully constructed (see NodeManager::poolLookup()).
+ * Removal uses pointer equality.
+ */
+class NodeValuePool
+{
+  /** A slot of the table. A slot is empty iff d_nv is null. */
+  struct Slot
+  {
+    NodeValue* d_nv;
+    size_t d_hash;
+  };
+
+ public:
+  /** Iterator over the NodeValues in the pool, in no particular order. */
+  class const_iterator
+  {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = NodeValue*;
+    using difference_type = std::ptrdiff_t;
+    using pointer = NodeValue* const*;
+    using reference = NodeValue* const&;
+
+    const_iterator(const Slot* cur, const Slot* end) : d_cur(cur), d_end(end)
+    {
+      skipEmpty();
+    }
+    reference operator*() const { return d_cur->d_nv; }
+    const_iterator& operator++()
+    {
+      ++d_cur;
+      skipEmpty();
+      return *this;
+    }
+    bool operator==(const const_iterator& other) const
+    {
+      return d_cur == other.d_cur;
+    }
+    bool operator!=(const const_iterator& other) const
+    {
+      return d_cur != other.d_cur;
+    }
+
+   private:
+    void skipEmpty()
+    {
+      while (d_cur != d_end && d_cur->d_nv == nullptr)
+      {
+        ++d_cur;
+      }
+    }
+    const Slot* d_cur;
+    const Slot* d_end;
+  };
+
+  NodeValuePool() : d_size(0), d_shift(64 - initialLog2Capacity)
+  {
+    d_slots.resize(static_cast<size_t>(1) << initialLog2Capacity,
+                   Slot{nullptr, 0});
+  }
+  NodeValuePool(const NodeValuePool&) = delete;
+  NodeValuePool& operator=(const NodeValuePool&) = delete;
+
+  /** The number of NodeValues in the pool. */
+  size_t size() const { return d_size; }
+  /** The number of slots of the table. */
+  size_t capacity() const { return d_slots.size(); }
+
+  const_iterator begin() const
+  {
+    return const_iterator(d_slots.data(), d_slots.data() + d_slots.size());
+  }
+  const_iterator end() const
+  {
+    const Slot* e = d_slots.data() + d_slots.size();
+    return const_iterator(e, e);
+  }
+
+  /**
+   * Get the NodeValue in the pool that is structurally equal to nv, or null
+   * if there is none.
+   */
+  NodeValue* find(const NodeValue* nv) const
+  {
+    size_t h = NodeValuePoolHashFunction()(nv);
+    size_t mask = d_slots.size() - 1;
+    size_t i = home(h);
+    for (size_t dist = 0;; ++dist, i = (i + 1) & mask)
+    {
+      const Slot& s = d_slots[i];
+      // Robin Hood invariant: the entry cannot be further away from its
+      // home slot than the resident of this slot is from its own
+      if (s.d_nv == nullptr || probeDistance(i, s.d_hash) < dist)
+      {
+        return nullptr;
+      }
+      if (s.d_hash == h && NodeValuePoolEq()(s.d_nv, nv))
+      {
+        return s.d_nv;
+      }
+    }
+  }
+
+  /**
+   * Insert nv into the pool. It is an error to insert a NodeValue that is
+   * structurally equal to one in the pool.
+   */
+  void insert(NodeValue* nv)
+  {
+    if ((d_size + 1) * maxLoadDen > d_slots.size() * maxLoadNum)
+    {
+      grow();
+    }
+    insertSlot(Slot{nv, NodeValuePoolHashFunction()(nv)});
+    ++d_size;
+  }
+
+  /** Remove nv from the pool. It is an error if nv is not in the pool. */
+  void erase(const NodeValue* nv)
+  {
+    size_t h = NodeValuePoolHashFunction()(nv);
+    size_t mask = d_slots.size() - 1;
+    size_t i = home(h);
+    while (d_slots[i].d_nv != nv)
+    {
+      Assert(d_slots[i].d_nv != nullptr) << "NodeValue is not in the pool!";
+      i = (i + 1) & mask;
+    }
+    // shift the following entries of the cluster back by one slot
+    size_t j = (i + 1) & mask;
+    while (d_slots[j].d_nv != nullptr
+           && probeDistance(j, d_slots[j].d_hash) > 0)
+    {
+      d_slots[i] = d_slots[j];
+      i = j;
+      j = (j + 1) & mask;
+    }
+    d_slots[i] = Slot{nullptr, 0};
+    --d_size;
+  }
+
+ private:
+  /** The initial capacity is 2^initialLog2Capacity slots. */
+  static constexpr size_t initialLog2Capacity = 12;
+  /** The table grows once its load exceeds maxLoadNum / maxLoadDen. */
+  static constexpr size_t maxLoadNum = 7;
+  static constexpr size_t maxLoadDen = 8;
+
+  /**
+   * The home slot of an entry with hash h. The pool hash of non-constant
+   * NodeValues is weak in its low bits, so we use Fibonacci hashing to pick
+   * the high bits of the product.
+   */
+  size_t home(size_t h) const
+  {
+    return static_cast<size_t>(
+        (static_cast<uint64_t>(h) * UINT64_C(0x9e3779b97f4a7c15)) >> d_shift);
+  }
+
+  /** The distance of slot i from the home slot of an entry with hash h. */
+  size_t probeDistance(size_t i, size_t h) const
+  {
+    return (i - home(h)) & (d_slots.size() - 1);
+  }
+
+  /** Insert slot s, which is known not to be in the table. */
+  void insertSlot(Slot s)
+  {
+    size_t mask = d_slots.size() - 1;
+    size_t i = home(s.d_hash);
+    for (size_t dist = 0;; ++dist, i = (i + 1) & mask)
+    {
+      Slot& cur = d_slots[i];
+      if (cur.d_nv == nullptr)
+      {
+        cur = s;
+        return;
+      }
+      size_t curDist = probeDistance(i, cur.d_hash);
+      if (curDist < dist)
+      {
+        // take the slot from the richer entry, continue with that one
+        std::swap(cur, s);
+        dist = curDist;
+      }
+    }
+  }
+
+  /** Double the capacity of the table. */
+  void grow()
+  {
+    std::vector<Slot> old(d_slots.size() * 2, Slot{nullptr, 0});
+    old.swap(d_slots);
+    --d_shift;
+    for (const Slot& s : old)
+    {
+      if (s.d_nv != nullptr)
+      {
+        insertSlot(s);
+      }
+    }
+  }
+
+  /** The slots, the number of slots is a power of two. */
+  std::vector<Slot> d_slots;
+  /** The number of NodeValues in the pool. */
+  size_t d_size;
+  /** 64 - log2 of the number of slots. */
+  uint32_t d_shift;
+}; /* class NodeValuePool */
+
+}  // namespace expr
+}  // namespace cvc5
+
+#endif /* CVC5__EXPR__NODE_VALUE_POOL_H */
@@ -72,6 +72,7 @@ Node SkolemManager::mkSkolem(Node v,
                              int flags,
                              ProofGenerator* pg)
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   // We do not currently insist that pred does not contain witness terms
   Assert(v.getKind() == BOUND_VARIABLE);
   // make the witness term
@@ -180,6 +181,7 @@ Node SkolemManager::mkPurifySkolem(Node t,
                                    const std::string& comment,
                                    int flags)
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   Node to = getOriginalForm(t);
   // We do not currently insist that to does not contain witness terms
 
@@ -198,6 +200,7 @@ Node SkolemManager::mkSkolemFunction(SkolemFunId id,
                                      Node cacheVal,
                                      int flags)
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   std::tuple<SkolemFunId, TypeNode, Node> key(id, tn, cacheVal);
   std::map<std::tuple<SkolemFunId, TypeNode, Node>, Node>::iterator it =
       d_skolemFuns.find(key);
@@ -228,6 +231,7 @@ bool SkolemManager::isSkolemFunction(Node k,
                                      SkolemFunId& id,
                                      Node& cacheVal) const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   std::map<Node, std::tuple<SkolemFunId, TypeNode, Node>>::const_iterator it =
       d_skolemFunMap.find(k);
   if (it == d_skolemFunMap.end())
@@ -249,6 +253,7 @@ Node SkolemManager::mkDummySkolem(const std::string& prefix,
 
 ProofGenerator* SkolemManager::getProofGenerator(Node t) const
 {
+  NodeManager::SharedLock lock(NodeManager::currentNM());
   std::map<Node, ProofGenerator*>::const_iterator it = d_gens.find(t);
   if (it != d_gens.end())
   {
@@ -19,12 +19,15 @@
 #  include <sys/resource.h>
 #endif /* ! __WIN32__ */
 
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "base/exception.h"
+#include "main/cube_and_conquer.h"
 #include "main/main.h"
 #include "smt/command.h"
 #include "smt/solver_engine.h"
@@ -118,13 +121,24 @@ void CommandExecutor::reset()
 
 bool CommandExecutor::doCommandSingleton(Command* cmd)
 {
-  bool status = solverInvoke(
-      d_solver.get(), d_symman.get(), cmd, d_solver->getDriverOptions().out());
-
+  bool status;
   api::Result res;
   const CheckSatCommand* cs = dynamic_cast<const CheckSatCommand*>(cmd);
-  if(cs != nullptr) {
-    d_result = res = cs->getResult();
+  if (cs != nullptr
+      && d_solver->getOptionInfo("cube-and-conquer").uintValue() > 1
+      && !d_solver->getOptionInfo("parse-only").boolValue())
+  {
+    status = doCubeAndConquer(res);
+    d_result = res;
+  }
+  else
+  {
+    status = solverInvoke(
+        d_solver.get(), d_symman.get(), cmd, d_solver->getDriverOptions().out());
+    if (cs != nullptr)
+    {
+      d_result = res = cs->getResult();
+    }
   }
   const CheckSatAssumingCommand* csa =
       dynamic_cast<const CheckSatAssumingCommand*>(cmd);
@@ -192,6 +206,40 @@ bool CommandExecutor::doCommandSingleton(Command* cmd)
   return status;
 }
 
+bool CommandExecutor::doCubeAndConquer(api::Result& res)
+{
+  std::ostream& out = d_solver->getDriverOptions().out();
+  try
+  {
+    std::vector<std::vector<api::Term>> cubes = getCubes(
+        *d_solver, d_solver->getOptionInfo("cube-and-conquer").uintValue());
+    std::string filename = d_solver->getOption("cubes-out");
+    if (!filename.empty())
+    {
+      std::ofstream fs(filename);
+      printCubes(fs, cubes);
+      if (!fs)
+      {
+        throw Exception("cannot write cubes to " + filename);
+      }
+      // the check-sat command is not answered
+      return true;
+    }
+    CubeResult r = solveCubes(
+        *d_solver,
+        cubes,
+        d_solver->getOptionInfo("cube-workers").uintValue(),
+        res);
+    out << r << std::endl;
+  }
+  catch (std::exception& e)
+  {
+    out << "(error \"" << e.what() << "\")" << std::endl;
+    return false;
+  }
+  return true;
+}
+
 bool solverInvoke(api::Solver* solver,
                   SymbolManager* sm,
                   Command* cmd,
@@ -100,6 +100,14 @@ protected:
   /** Executes treating cmd as a singleton */
  virtual bool doCommandSingleton(cvc5::Command* cmd);
 
+ /**
+  * Executes a check-sat command by splitting the assertions into cubes (see
+  * --cube-and-conquer), and prints the combined result. If the result is sat,
+  * it is stored in res. With --cubes-out, the cubes are written to a file
+  * instead and nothing is printed.
+  */
+ bool doCubeAndConquer(api::Result& res);
+
 private:
   CommandExecutor();
 
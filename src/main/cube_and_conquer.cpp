@@ -0,0 +1,342 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Cube-and-conquer splitting of check-sat commands, as imposed by the
+ * --cube-and-conquer option.
+ */
+
+#include "main/cube_and_conquer.h"
+
+#include "base/cvc5config.h"
+
+#if HAVE_FORK
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+#include "base/exception.h"
+#include "main/portfolio.h"
+#include "main/time_limit.h"
+
+namespace cvc5 {
+namespace main {
+
+namespace {
+
+/**
+ * Computes the Jeroslow-Wang score of the Boolean atoms in the assertions.
+ * Every atom below a disjunction of n children scores 2^-n, atoms below
+ * conjunctions and negations inherit the score of their parent, and atoms
+ * below other Boolean connectives get half of it. A term shared by several
+ * parents is only traversed with the weight of its first parent. Returns the
+ * atoms in the order of their first occurrence.
+ */
+std::vector<api::Term> scoreAtoms(
+    const std::vector<api::Term>& assertions,
+    std::unordered_map<api::Term, double>& scores)
+{
+  std::vector<api::Term> atoms;
+  std::unordered_map<api::Term, bool> visited;
+  std::vector<std::pair<api::Term, double>> toVisit;
+  for (auto it = assertions.rbegin(); it != assertions.rend(); ++it)
+  {
+    toVisit.emplace_back(*it, 1.0);
+  }
+  while (!toVisit.empty())
+  {
+    api::Term t = toVisit.back().first;
+    double weight = toVisit.back().second;
+    toVisit.pop_back();
+    double childWeight;
+    switch (t.getKind())
+    {
+      case api::CONST_BOOLEAN:
+      case api::FORALL:
+      case api::EXISTS: continue;
+      case api::AND:
+      case api::NOT: childWeight = weight; break;
+      case api::OR:
+      case api::IMPLIES:
+      {
+        int width = std::min(static_cast<int>(t.getNumChildren()), 64);
+        childWeight = std::ldexp(weight, -width);
+        break;
+      }
+      case api::XOR: childWeight = weight / 2; break;
+      case api::EQUAL:
+      case api::ITE:
+        // the last child is Boolean for Boolean equalities and ites
+        if (t[t.getNumChildren() - 1].getSort().isBoolean())
+        {
+          childWeight = weight / 2;
+          break;
+        }
+        CVC5_FALLTHROUGH;
+      default:
+      {
+        // an atom
+        auto it = scores.find(t);
+        if (it == scores.end())
+        {
+          scores[t] = weight;
+          atoms.push_back(t);
+        }
+        else
+        {
+          it->second += weight;
+        }
+        continue;
+      }
+    }
+    if (visited.find(t) != visited.end())
+    {
+      continue;
+    }
+    visited[t] = true;
+    for (size_t i = t.getNumChildren(); i > 0; --i)
+    {
+      toVisit.emplace_back(t[i - 1], childWeight);
+    }
+  }
+  return atoms;
+}
+
+}  // namespace
+
+std::vector<std::vector<api::Term>> getCubes(const api::Solver& solver,
+                                             size_t k)
+{
+  std::unordered_map<api::Term, double> scores;
+  std::vector<api::Term> atoms = scoreAtoms(solver.getAssertions(), scores);
+  std::stable_sort(atoms.begin(),
+                   atoms.end(),
+                   [&scores](const api::Term& a, const api::Term& b) {
+                     return scores[a] > scores[b];
+                   });
+  size_t depth = 0;
+  while (depth < atoms.size() && (size_t(2) << depth) <= k)
+  {
+    ++depth;
+  }
+  std::vector<std::vector<api::Term>> cubes(1);
+  for (size_t i = 0; i < depth; ++i)
+  {
+    std::vector<std::vector<api::Term>> split;
+    for (const std::vector<api::Term>& cube : cubes)
+    {
+      split.push_back(cube);
+      split.back().push_back(atoms[i]);
+      split.push_back(cube);
+      split.back().push_back(atoms[i].notTerm());
+    }
+    cubes = std::move(split);
+  }
+  return cubes;
+}
+
+std::ostream& operator<<(std::ostream& out, CubeResult r)
+{
+  switch (r)
+  {
+    case CubeResult::SAT: return out << "sat";
+    case CubeResult::UNSAT: return out << "unsat";
+    default: return out << "unknown";
+  }
+}
+
+void printCubes(std::ostream& out,
+                const std::vector<std::vector<api::Term>>& cubes)
+{
+  for (const std::vector<api::Term>& cube : cubes)
+  {
+    out << "(check-sat-assuming (";
+    for (size_t i = 0; i < cube.size(); ++i)
+    {
+      out << (i > 0 ? " " : "") << cube[i];
+    }
+    out << "))" << std::endl;
+  }
+}
+
+namespace {
+
+/**
+ * Checks the cubes with index i, i + step, i + 2 * step, ... Returns SAT as
+ * soon as a cube is satisfiable, and stores its index in satCube.
+ */
+#if HAVE_FORK
+/** The message by which a worker reports its result to the parent process. */
+struct CubeMessage
+{
+  /** The CubeResult of the worker */
+  uint32_t d_result = static_cast<uint32_t>(CubeResult::UNKNOWN);
+  /** The index of the satisfiable cube, if the result is sat */
+  uint32_t d_cube = 0;
+};
+
+/** Reads the next message, returns false once all workers closed the pipe. */
+bool readMessage(int fd, CubeMessage& msg)
+{
+  char* buf = reinterpret_cast<char*>(&msg);
+  size_t size = 0;
+  while (size < sizeof(msg))
+  {
+    ssize_t n = read(fd, buf + size, sizeof(msg) - size);
+    if (n < 0 && errno == EINTR)
+    {
+      continue;
+    }
+    if (n <= 0)
+    {
+      return false;
+    }
+    size += n;
+  }
+  return true;
+}
+#endif /* HAVE_FORK */
+
+CubeResult solveCubesSequential(
+    api::Solver& solver,
+    const std::vector<std::vector<api::Term>>& cubes,
+    size_t i,
+    size_t step,
+    api::Result& satResult,
+    size_t& satCube)
+{
+  CubeResult res = CubeResult::UNSAT;
+  for (; i < cubes.size(); i += step)
+  {
+    api::Result r = solver.checkSatAssuming(cubes[i]);
+    if (r.isSat())
+    {
+      satResult = r;
+      satCube = i;
+      return CubeResult::SAT;
+    }
+    if (!r.isUnsat())
+    {
+      res = CubeResult::UNKNOWN;
+    }
+  }
+  return res;
+}
+
+}  // namespace
+
+CubeResult solveCubes(api::Solver& solver,
+                      const std::vector<std::vector<api::Term>>& cubes,
+                      size_t workers,
+                      api::Result& satResult)
+{
+  size_t satCube = cubes.size();
+#if HAVE_FORK
+  if (workers > 1 && cubes.size() > 1)
+  {
+    // The workers report their result and the index of a satisfiable cube in
+    // a message on a pipe shared by all workers. They form a process group
+    // with the workers of a portfolio (see forkWorker()), so that they are
+    // killed if the driver is terminated by a timeout or a signal.
+    workers = std::min(workers, cubes.size());
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+      throw Exception(std::string("cube-and-conquer: pipe() failed: ")
+                      + std::strerror(errno));
+    }
+    std::cout.flush();
+    std::cerr.flush();
+    for (size_t w = 0; w < workers; ++w)
+    {
+      int pid = forkWorker();
+      if (pid < 0)
+      {
+        int err = errno;
+        close(fds[0]);
+        close(fds[1]);
+        killPortfolioWorkers();
+        throw Exception(std::string("cube-and-conquer: fork() failed: ")
+                        + std::strerror(err));
+      }
+      if (pid == 0)
+      {
+        // worker process, timers are not inherited by forked processes
+        close(fds[0]);
+        install_time_limit(solver.getOptionInfo("tlimit").uintValue());
+        CubeMessage msg;
+        try
+        {
+          api::Result r;
+          msg.d_result = static_cast<uint32_t>(
+              solveCubesSequential(solver, cubes, w, workers, r, satCube));
+          msg.d_cube = satCube;
+        }
+        catch (...)
+        {
+          // never return to the driver from a worker
+        }
+        // messages up to PIPE_BUF bytes are written atomically
+        CVC5_UNUSED ssize_t n = write(fds[1], &msg, sizeof(msg));
+        _exit(0);
+      }
+    }
+    close(fds[1]);
+
+    // workers that terminate without a message count as unknown
+    CubeResult res = CubeResult::UNSAT;
+    size_t reported = 0;
+    CubeMessage msg;
+    while (res != CubeResult::SAT && readMessage(fds[0], msg))
+    {
+      ++reported;
+      if (msg.d_result == static_cast<uint32_t>(CubeResult::SAT)
+          && msg.d_cube < cubes.size())
+      {
+        satCube = msg.d_cube;
+        res = CubeResult::SAT;
+      }
+      else if (msg.d_result != static_cast<uint32_t>(CubeResult::UNSAT))
+      {
+        res = CubeResult::UNKNOWN;
+      }
+    }
+    if (res != CubeResult::SAT && reported < workers)
+    {
+      res = CubeResult::UNKNOWN;
+    }
+    close(fds[0]);
+    killPortfolioWorkers();
+    if (res != CubeResult::SAT)
+    {
+      return res;
+    }
+    // check the satisfiable cube again to provide the model
+    api::Result r = solver.checkSatAssuming(cubes[satCube]);
+    if (r.isSat())
+    {
+      satResult = r;
+      return CubeResult::SAT;
+    }
+    return CubeResult::UNKNOWN;
+  }
+#endif /* HAVE_FORK */
+  return solveCubesSequential(solver, cubes, 0, 1, satResult, satCube);
+}
+
+}  // namespace main
+}  // namespace cvc5
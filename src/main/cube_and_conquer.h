@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Cube-and-conquer splitting of check-sat commands, as imposed by the
+ * --cube-and-conquer option.
+ */
+
+#ifndef CVC5__MAIN__CUBE_AND_CONQUER_H
+#define CVC5__MAIN__CUBE_AND_CONQUER_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+#include "api/cpp/cvc5.h"
+
+namespace cvc5 {
+namespace main {
+
+/**
+ * Splits the current assertions of solver into at most k cubes, i.e.,
+ * conjunctions of literals, whose disjunction is valid. The cubes consist of
+ * all combinations of polarities of the floor(log2(k)) Boolean atoms with the
+ * highest (Jeroslow-Wang) score in the Boolean structure of the assertions,
+ * that is, the atoms that occur most often in the shortest clauses.
+ */
+std::vector<std::vector<api::Term>> getCubes(const api::Solver& solver,
+                                             size_t k);
+
+/** The combined result of checking the cubes. */
+enum class CubeResult
+{
+  SAT,
+  UNSAT,
+  UNKNOWN
+};
+
+std::ostream& operator<<(std::ostream& out, CubeResult r);
+
+/** Writes the cubes as check-sat-assuming commands to out. */
+void printCubes(std::ostream& out,
+                const std::vector<std::vector<api::Term>>& cubes);
+
+/**
+ * Checks satisfiability of the assertions of solver by checking each cube as
+ * assumptions. The result is sat if some cube is satisfiable, unsat if all
+ * cubes are unsatisfiable, and unknown otherwise. If the result is sat, the
+ * last call to checkSatAssuming() of solver was for a satisfiable cube, whose
+ * result is stored in satResult, and a model is available.
+ *
+ * If workers > 1, the cubes are distributed over this number of forked worker
+ * processes (on platforms with fork()), and a satisfiable cube found by a
+ * worker is checked again by solver to provide the model.
+ */
+CubeResult solveCubes(api::Solver& solver,
+                      const std::vector<std::vector<api::Term>>& cubes,
+                      size_t workers,
+                      api::Result& satResult);
+
+}  // namespace main
+}  // namespace cvc5
+
+#endif /* CVC5__MAIN__CUBE_AND_CONQUER_H */
@@ -22,6 +22,7 @@
 #include <iostream>
 #include <memory>
 #include <new>
+#include <sstream>
 
 #include "api/cpp/cvc5.h"
 #include "base/configuration.h"
@@ -31,6 +32,7 @@
 #include "main/interactive_shell.h"
 #include "main/main.h"
 #include "main/options.h"
+#include "main/portfolio.h"
 #include "main/signal_handlers.h"
 #include "main/time_limit.h"
 #include "parser/parser.h"
@@ -153,6 +155,57 @@ int runCvc5(int argc, char* argv[], std::unique_ptr<api::Solver>& solver)
   {
     solver->setOption("output-language", solver->getOption("input-language"));
   }
+
+  // In portfolio mode, the commands are executed by forked worker processes
+  // with different configurations, and the parent process only reports the
+  // output of the first worker that gives a definitive answer.
+  bool portfolioWorker = false;
+  std::string portfolioInput;
+  size_t portfolioSize = solver->getOptionInfo("portfolio").uintValue();
+  if (portfolioSize > 1 && !solver->getOptionInfo("interactive").boolValue())
+  {
+    if (inputFromStdin)
+    {
+      // read the input once, it is parsed by every worker
+      std::stringstream ss;
+      ss << cin.rdbuf();
+      portfolioInput = ss.str();
+    }
+    std::string shareDir;
+    if (solver->getOptionInfo("portfolio-share").boolValue()
+        && !solver->getOptionInfo("clause-sharing-dir").setByUser)
+    {
+      shareDir = createPortfolioShareDir();
+    }
+    int exitCode = 0;
+    size_t worker =
+        forkPortfolio(portfolioSize, dopts.out(), dopts.err(), exitCode);
+    if (worker == portfolioSize)
+    {
+      if (!shareDir.empty())
+      {
+        removePortfolioShareDir(shareDir);
+      }
+      pExecutor.reset();
+      signal_handlers::cleanup();
+      return exitCode;
+    }
+    portfolioWorker = true;
+    // timers are not inherited by forked processes
+    limit = install_time_limit(solver->getOptionInfo("tlimit").uintValue());
+    for (const auto& opt : getPortfolioConfig(worker))
+    {
+      if (!solver->getOptionInfo(opt.first).setByUser)
+      {
+        solver->setOption(opt.first, opt.second);
+      }
+    }
+    if (!shareDir.empty())
+    {
+      solver->setOption("clause-sharing-dir", shareDir);
+      solver->setOption("clause-sharing-id", std::to_string(worker));
+    }
+  }
   pExecutor->storeOptionsAsOriginal();
 
   // Determine which messages to show based on smtcomp_mode and verbosity
@@ -217,7 +270,10 @@ int runCvc5(int argc, char* argv[], std::unique_ptr<api::Solver>& solver)
     {
       if (!solver->getOptionInfo("incremental").setByUser)
       {
-        cmd.reset(new SetOptionCommand("incremental", "false"));
+        // cube-and-conquer checks the cubes as assumptions of the same solver
+        bool cubes = solver->getOptionInfo("cube-and-conquer").uintValue() > 1;
+        cmd.reset(
+            new SetOptionCommand("incremental", cubes ? "true" : "false"));
         cmd->setMuted(true);
         pExecutor->doCommand(cmd);
       }
@@ -225,7 +281,13 @@ int runCvc5(int argc, char* argv[], std::unique_ptr<api::Solver>& solver)
       ParserBuilder parserBuilder(
           pExecutor->getSolver(), pExecutor->getSymbolManager(), true);
       std::unique_ptr<Parser> parser(parserBuilder.build());
-      if( inputFromStdin ) {
+      if (portfolioWorker && inputFromStdin)
+      {
+        parser->setInput(Input::newStringInput(
+            solver->getOption("input-language"), portfolioInput, filename));
+      }
+      else if (inputFromStdin)
+      {
         parser->setInput(Input::newStreamInput(
             solver->getOption("input-language"), cin, filename));
       }
@@ -274,6 +336,16 @@ int runCvc5(int argc, char* argv[], std::unique_ptr<api::Solver>& solver)
       returnValue = 1;
     }
 
+    if (portfolioWorker)
+    {
+      // report to the parent process whether the answer is definitive, the
+      // statistics are printed to the error output, which the parent process
+      // forwards for the winning worker
+      returnValue = getPortfolioExitCode(returnValue, result);
+      pExecutor->flushOutputStreams();
+      _exit(returnValue);
+    }
+
 #ifdef CVC5_COMPETITION_MODE
     dopts.out() << std::flush;
     // exit, don't return (don't want destructors to run)
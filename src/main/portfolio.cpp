@@ -0,0 +1,434 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Parallel portfolio of differently configured solvers, as imposed by the
+ * --portfolio option.
+ *
+ * The workers run in forked processes rather than threads, since solvers in
+ * the same process share global state. The parent process only collects the
+ * output of the workers and waits for the first definitive answer, which is
+ * signalled by the exit code of the worker. The workers form their own
+ * process group, so that they can be killed at once when the parent process
+ * terminates early.
+ */
+
+#include "main/portfolio.h"
+
+#include "base/cvc5config.h"
+
+#if HAVE_FORK
+#include <dirent.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "base/exception.h"
+
+namespace cvc5 {
+namespace main {
+
+namespace {
+
+/**
+ * Added to the exit code of workers that did not give a definitive answer.
+ */
+const int s_indefinite = 16;
+
+/** Configurations cycled through by workers 1, 2, ... */
+const std::vector<std::vector<std::pair<std::string, std::string>>>
+    s_configs = {
+        {},
+        {{"decision", "internal"}},
+        {{"use-soi", "true"}},
+        {{"full-saturate-quant", "true"}},
+        {{"use-fcsimplex", "true"}},
+        {{"decision", "justification-old"}},
+        {{"random-freq", "0.02"}},
+        {{"restart-int-base", "50"}},
+};
+
+}  // namespace
+
+std::vector<std::pair<std::string, std::string>> getPortfolioConfig(size_t i)
+{
+  if (i == 0)
+  {
+    return {};
+  }
+  std::vector<std::pair<std::string, std::string>> config = {
+      {"seed", std::to_string(i)}, {"random-seed", std::to_string(i)}};
+  const auto& diverse = s_configs[(i - 1) % s_configs.size()];
+  config.insert(config.end(), diverse.begin(), diverse.end());
+  return config;
+}
+
+#if HAVE_FORK
+
+namespace {
+
+/** A worker process of the portfolio, as seen by the parent process. */
+struct Worker
+{
+  /** The process id of the worker */
+  pid_t d_pid = -1;
+  /** The read end of the pipe connected to the standard output */
+  int d_fd = -1;
+  /** The read end of the pipe connected to the standard error */
+  int d_errFd = -1;
+  /** The output of the worker read so far */
+  std::string d_output;
+  /** The error output of the worker read so far */
+  std::string d_errors;
+  /** Whether the worker terminated */
+  bool d_done = false;
+  /** The status reported by waitpid() for the worker, if done */
+  int d_status = 0;
+};
+
+void throwErrno(const std::string& what)
+{
+  throw Exception("portfolio: " + what + " failed: " + std::strerror(errno));
+}
+
+/** The process group of the running workers, 0 if there are none */
+volatile sig_atomic_t s_workerGroup = 0;
+
+/**
+ * Reads the pending output of a pipe of the worker into output. At end of
+ * file, closes the pipe and sets fd to -1.
+ */
+void readOutput(int& fd, std::string& output)
+{
+  char buf[4096];
+  ssize_t n = read(fd, buf, sizeof(buf));
+  while (n < 0 && errno == EINTR)
+  {
+    n = read(fd, buf, sizeof(buf));
+  }
+  if (n > 0)
+  {
+    output.append(buf, n);
+    return;
+  }
+  close(fd);
+  fd = -1;
+}
+
+/** Closes the pipes of the worker and waits for its termination. */
+void reap(Worker& w)
+{
+  for (int* fd : {&w.d_fd, &w.d_errFd})
+  {
+    if (*fd >= 0)
+    {
+      close(*fd);
+      *fd = -1;
+    }
+  }
+  while (waitpid(w.d_pid, &w.d_status, 0) < 0 && errno == EINTR)
+  {
+  }
+  w.d_done = true;
+}
+
+/**
+ * Forks the workers and collects their output, see forkPortfolio(). The
+ * workers are added to the given vector as they are forked.
+ */
+size_t collectPortfolio(std::vector<Worker>& workers,
+                        std::ostream& out,
+                        std::ostream& err,
+                        int& exitCode)
+{
+  size_t n = workers.size();
+  for (size_t i = 0; i < n; ++i)
+  {
+    int fds[2];
+    int errFds[2];
+    if (pipe(fds) != 0)
+    {
+      throwErrno("pipe()");
+    }
+    if (pipe(errFds) != 0)
+    {
+      close(fds[0]);
+      close(fds[1]);
+      throwErrno("pipe()");
+    }
+    pid_t pid = forkWorker();
+    if (pid < 0)
+    {
+      for (int fd : {fds[0], fds[1], errFds[0], errFds[1]})
+      {
+        close(fd);
+      }
+      throwErrno("fork()");
+    }
+    if (pid == 0)
+    {
+      // worker process
+      for (size_t j = 0; j < i; ++j)
+      {
+        close(workers[j].d_fd);
+        close(workers[j].d_errFd);
+      }
+      close(fds[0]);
+      close(errFds[0]);
+      dup2(fds[1], STDOUT_FILENO);
+      dup2(errFds[1], STDERR_FILENO);
+      close(fds[1]);
+      close(errFds[1]);
+      return i;
+    }
+    close(fds[1]);
+    close(errFds[1]);
+    workers[i].d_pid = pid;
+    workers[i].d_fd = fds[0];
+    workers[i].d_errFd = errFds[0];
+  }
+
+  // parent process: collect output until the first definitive answer
+  size_t winner = n;
+  size_t running = n;
+  std::vector<pollfd> pfds;
+  std::vector<size_t> pidx;
+  while (running > 0 && winner == n)
+  {
+    pfds.clear();
+    pidx.clear();
+    for (size_t i = 0; i < n; ++i)
+    {
+      for (int fd : {workers[i].d_fd, workers[i].d_errFd})
+      {
+        if (fd >= 0)
+        {
+          pfds.push_back({fd, POLLIN, 0});
+          pidx.push_back(i);
+        }
+      }
+    }
+    if (poll(pfds.data(), pfds.size(), -1) < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      throwErrno("poll()");
+    }
+    for (size_t k = 0; k < pfds.size(); ++k)
+    {
+      if (pfds[k].revents == 0)
+      {
+        continue;
+      }
+      Worker& w = workers[pidx[k]];
+      if (pfds[k].fd == w.d_fd)
+      {
+        readOutput(w.d_fd, w.d_output);
+      }
+      else if (pfds[k].fd == w.d_errFd)
+      {
+        readOutput(w.d_errFd, w.d_errors);
+      }
+      // the worker terminated once both of its pipes are closed
+      if (w.d_done || w.d_fd >= 0 || w.d_errFd >= 0)
+      {
+        continue;
+      }
+      reap(w);
+      --running;
+      if (WIFEXITED(w.d_status) && WEXITSTATUS(w.d_status) == 0)
+      {
+        winner = pidx[k];
+        break;
+      }
+    }
+  }
+
+  for (Worker& w : workers)
+  {
+    if (!w.d_done)
+    {
+      kill(w.d_pid, SIGKILL);
+      reap(w);
+    }
+  }
+  s_workerGroup = 0;
+  if (winner == n)
+  {
+    // no definitive answer, prefer the workers with smaller index
+    winner = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (WIFEXITED(workers[i].d_status))
+      {
+        winner = i;
+        break;
+      }
+    }
+  }
+  const Worker& w = workers[winner];
+  exitCode =
+      WIFEXITED(w.d_status) ? WEXITSTATUS(w.d_status) % s_indefinite : 1;
+  out << w.d_output << std::flush;
+  // the error output includes the statistics of the worker
+  err << w.d_errors << std::flush;
+  return n;
+}
+
+}  // namespace
+
+size_t forkPortfolio(size_t n,
+                     std::ostream& out,
+                     std::ostream& err,
+                     int& exitCode)
+{
+  // do not duplicate buffered output in the workers
+  std::cout.flush();
+  std::cerr.flush();
+  out.flush();
+  err.flush();
+
+  std::vector<Worker> workers(n);
+  try
+  {
+    return collectPortfolio(workers, out, err, exitCode);
+  }
+  catch (...)
+  {
+    for (Worker& w : workers)
+    {
+      for (int fd : {w.d_fd, w.d_errFd})
+      {
+        if (fd >= 0)
+        {
+          close(fd);
+        }
+      }
+    }
+    killPortfolioWorkers();
+    throw;
+  }
+}
+
+int forkWorker()
+{
+  pid_t pid = fork();
+  if (pid < 0)
+  {
+    return pid;
+  }
+  // the first worker is the leader of the process group of the workers
+  pid_t group = s_workerGroup > 0 ? s_workerGroup : pid;
+  if (pid == 0)
+  {
+    setpgid(0, s_workerGroup);
+    // the workers of a worker form a group of their own
+    s_workerGroup = 0;
+    return pid;
+  }
+  // also set by the worker, whichever runs first
+  setpgid(pid, group);
+  s_workerGroup = group;
+  return pid;
+}
+
+void killPortfolioWorkers()
+{
+  pid_t group = s_workerGroup;
+  if (group <= 0)
+  {
+    return;
+  }
+  s_workerGroup = 0;
+  kill(-group, SIGKILL);
+  while (waitpid(-group, nullptr, 0) > 0 || errno == EINTR)
+  {
+  }
+}
+
+std::string createPortfolioShareDir()
+{
+  const char* tmpdir = std::getenv("TMPDIR");
+  std::string pattern = std::string(tmpdir != nullptr ? tmpdir : "/tmp")
+                        + "/cvc5-portfolio-XXXXXX";
+  std::vector<char> path(pattern.begin(), pattern.end());
+  path.push_back('\0');
+  if (mkdtemp(path.data()) == nullptr)
+  {
+    throwErrno("mkdtemp()");
+  }
+  return path.data();
+}
+
+void removePortfolioShareDir(const std::string& dir)
+{
+  if (DIR* d = opendir(dir.c_str()))
+  {
+    while (struct dirent* entry = readdir(d))
+    {
+      std::string name = entry->d_name;
+      if (name != "." && name != "..")
+      {
+        unlink((dir + "/" + name).c_str());
+      }
+    }
+    closedir(d);
+  }
+  rmdir(dir.c_str());
+}
+
+#else /* HAVE_FORK */
+
+size_t forkPortfolio(size_t n,
+                     std::ostream& out,
+                     std::ostream& err,
+                     int& exitCode)
+{
+  throw Exception("portfolio: not supported on this platform");
+}
+
+int forkWorker()
+{
+  errno = ENOSYS;
+  return -1;
+}
+
+void killPortfolioWorkers() {}
+
+std::string createPortfolioShareDir()
+{
+  throw Exception("portfolio: not supported on this platform");
+}
+
+void removePortfolioShareDir(const std::string& dir) {}
+
+#endif /* HAVE_FORK */
+
+int getPortfolioExitCode(int returnValue, const api::Result& result)
+{
+  bool definitive =
+      !result.isNull()
+      && (result.isSat() || result.isUnsat() || result.isEntailed()
+          || result.isNotEntailed());
+  return returnValue == 0 && definitive ? 0 : s_indefinite + returnValue;
+}
+
+}  // namespace main
+}  // namespace cvc5
@@ -0,0 +1,108 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Parallel portfolio of differently configured solvers, as imposed by the
+ * --portfolio option.
+ */
+
+#ifndef CVC5__MAIN__PORTFOLIO_H
+#define CVC5__MAIN__PORTFOLIO_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "api/cpp/cvc5.h"
+
+namespace cvc5 {
+namespace main {
+
+/**
+ * Returns the options that are set for the i-th worker of a portfolio. Worker
+ * 0 runs the configuration given by the user, the other workers use different
+ * random seeds and cycle through a list of diverse configurations. Options
+ * that were set by the user are not overwritten by the driver.
+ */
+std::vector<std::pair<std::string, std::string>> getPortfolioConfig(size_t i);
+
+/**
+ * Runs a portfolio of n workers, each in its own process, which is necessary
+ * since solvers share global state (e.g., the node manager and the output
+ * channels).
+ *
+ * Forks n worker processes. In each worker, this function returns the index
+ * of the worker in [0, n), with the standard output and the standard error of
+ * the worker redirected to the parent process.
+ *
+ * The workers run in their own process group, which is killed by
+ * killPortfolioWorkers() if the parent process terminates early.
+ *
+ * In the parent process, this function collects the output of the workers
+ * until the first worker terminates with a definitive answer (see
+ * getPortfolioExitCode()), kills the remaining workers, writes the output and
+ * the error output (e.g., the statistics) of the winning worker to out and
+ * err, and returns n. If no worker gives a definitive
+ * answer, the output of the worker with the smallest index that terminated
+ * normally is used.
+ * The exit code of the chosen worker is stored in exitCode. If an error
+ * occurs, all workers are killed before the exception is thrown.
+ *
+ * This is only supported on platforms with fork(), elsewhere an exception is
+ * thrown.
+ */
+size_t forkPortfolio(size_t n,
+                     std::ostream& out,
+                     std::ostream& err,
+                     int& exitCode);
+
+/**
+ * Forks a worker process that joins the process group of the running workers,
+ * of which the first worker becomes the leader. Returns 0 in the worker, the
+ * process id of the worker in the parent process, and -1 with errno set if
+ * the worker could not be forked. The workers are killed and reaped by
+ * killPortfolioWorkers(), including on a timeout or a signal.
+ *
+ * This is used by forkPortfolio() and the cube-and-conquer workers.
+ */
+int forkWorker();
+
+/**
+ * Kills and reaps the workers of a running portfolio, if any. This is called
+ * when the parent process is terminated by a timeout or a signal, and is
+ * async-signal-safe.
+ */
+void killPortfolioWorkers();
+
+/**
+ * Creates a fresh temporary directory through which the workers of a
+ * portfolio exchange learned clauses (see --clause-sharing-dir), and returns
+ * its path. Throws an exception if the directory cannot be created.
+ */
+std::string createPortfolioShareDir();
+
+/** Removes the directory and the files of the exchanged clauses in it. */
+void removePortfolioShareDir(const std::string& dir);
+
+/**
+ * Returns the exit code of a portfolio worker with the given return value and
+ * the result of the last check-sat command. It is 0 if and only if the return
+ * value is 0 and the result is definitive, i.e., sat or unsat (or entailed or
+ * not entailed).
+ */
+int getPortfolioExitCode(int returnValue, const api::Result& result);
+
+}  // namespace main
+}  // namespace cvc5
+
+#endif /* CVC5__MAIN__PORTFOLIO_H */
@@ -36,6 +36,7 @@
 #include "base/exception.h"
 #include "main/command_executor.h"
 #include "main/main.h"
+#include "main/portfolio.h"
 #include "util/safe_print.h"
 
 using cvc5::Exception;
@@ -65,6 +66,7 @@ void timeout_handler()
 {
   safe_print(STDERR_FILENO, "cvc5 interrupted by timeout.\n");
   print_statistics();
+  killPortfolioWorkers();
   abort();
 }
 
@@ -83,6 +85,7 @@ void sigterm_handler(int sig, siginfo_t* info, void*)
 {
   safe_print(STDERR_FILENO, "cvc5 interrupted by SIGTERM.\n");
   print_statistics();
+  killPortfolioWorkers();
   signal(sig, SIG_DFL);
   raise(sig);
 }
@@ -92,6 +95,7 @@ void sigint_handler(int sig, siginfo_t* info, void*)
 {
   safe_print(STDERR_FILENO, "cvc5 interrupted by user.\n");
   print_statistics();
+  killPortfolioWorkers();
   signal(sig, SIG_DFL);
   raise(sig);
 }
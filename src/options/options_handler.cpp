@@ -339,6 +339,21 @@ void OptionsHandler::abcEnabledBuild(const std::string& option,
 #endif /* CVC5_USE_ABC */
 }
 
+void OptionsHandler::checkSatSolver(const std::string& option,
+                                    const std::string& flag,
+                                    CDCLTSatSolverMode m)
+{
+  if (m == CDCLTSatSolverMode::CADICAL
+      && !Configuration::isBuiltWithCadicalPropagator())
+  {
+    std::stringstream ss;
+    ss << "option `" << option
+       << "' requires a CaDiCaL version with support for external "
+          "propagators; this binary was not built with such a version";
+    throw OptionException(ss.str());
+  }
+}
+
 void OptionsHandler::checkBvSatSolver(const std::string& option,
                                       const std::string& flag,
                                       SatSolverMode m)
@@ -486,6 +501,8 @@ void OptionsHandler::showConfiguration(const std::string& option,
   print_config_cond("abc", Configuration::isBuiltWithAbc());
   print_config_cond("cln", Configuration::isBuiltWithCln());
   print_config_cond("glpk", Configuration::isBuiltWithGlpk());
+  print_config_cond("cadical-propagator",
+                    Configuration::isBuiltWithCadicalPropagator());
   print_config_cond("cryptominisat", Configuration::isBuiltWithCryptominisat());
   print_config_cond("gmp", Configuration::isBuiltWithGmp());
   print_config_cond("kissat", Configuration::isBuiltWithKissat());
@@ -27,6 +27,7 @@
 #include "options/language.h"
 #include "options/managed_streams.h"
 #include "options/option_exception.h"
+#include "options/prop_options.h"
 #include "options/quantifiers_options.h"
 
 namespace cvc5 {
@@ -143,6 +144,10 @@ class OptionsHandler
   void checkBvSatSolver(const std::string& option,
                         const std::string& flag,
                         SatSolverMode m);
+  /** Check that the CDCL(T) sat solver is supported by this build */
+  void checkSatSolver(const std::string& option,
+                      const std::string& flag,
+                      CDCLTSatSolverMode m);
   /** Check that we use eager bitblasting for aig */
   void setBitblastAig(const std::string& option,
                       const std::string& flag,
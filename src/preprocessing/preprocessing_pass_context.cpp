@@ -15,7 +15,6 @@
 
 #include "preprocessing/preprocessing_pass_context.h"
 
-#include "expr/node_algorithm.h"
 #include "smt/env.h"
 #include "theory/theory_engine.h"
 #include "theory/theory_model.h"
@@ -33,7 +32,8 @@ PreprocessingPassContext::PreprocessingPassContext(
       d_propEngine(pe),
       d_circuitPropagator(circuitPropagator),
       d_llm(env),
-      d_symsInAssertions(userContext())
+      d_symsInAssertions(userContext()),
+      d_visitedInAssertions(userContext())
 {
 }
 
@@ -59,15 +59,28 @@ void PreprocessingPassContext::spendResource(Resource r)
 void PreprocessingPassContext::recordSymbolsInAssertions(
     const std::vector<Node>& assertions)
 {
-  std::unordered_set<TNode> visited;
-  std::unordered_set<Node> syms;
-  for (TNode cn : assertions)
+  // The terms visited when recording the assertions of this or a lower user
+  // context level have their symbols in d_symsInAssertions already, and are
+  // not traversed again.
+  std::vector<TNode> visit(assertions.begin(), assertions.end());
+  while (!visit.empty())
   {
-    expr::getSymbols(cn, syms, visited);
-  }
-  for (const Node& s : syms)
-  {
-    d_symsInAssertions.insert(s);
+    TNode cur = visit.back();
+    visit.pop_back();
+    if (d_visitedInAssertions.contains(cur))
+    {
+      continue;
+    }
+    d_visitedInAssertions.insert(cur);
+    if (cur.isVar() && cur.getKind() != kind::BOUND_VARIABLE)
+    {
+      d_symsInAssertions.insert(cur);
+    }
+    if (cur.hasOperator())
+    {
+      visit.push_back(cur.getOperator());
+    }
+    visit.insert(visit.end(), cur.begin(), cur.end());
   }
 }
 
@@ -135,6 +135,11 @@ class PreprocessingPassContext : protected EnvObj
    * assertion in the current user context.
    */
   context::CDHashSet<Node> d_symsInAssertions;
+  /**
+   * The (user-context-dependent) set of terms that were traversed by
+   * recordSymbolsInAssertions in the current user context.
+   */
+  context::CDHashSet<Node> d_visitedInAssertions;
 
 };  // class PreprocessingPassContext
 
@@ -12,12 +12,18 @@
  *
  * Wrapper for CaDiCaL SAT Solver.
  *
- * Implementation of the CaDiCaL SAT solver for cvc5 (bit-vectors).
+ * Implementation of the CaDiCaL SAT solver for cvc5 (bit-vectors), and of
+ * its use as CDCL(T) SAT solver via the external propagator interface.
  */
 
 #include "prop/cadical.h"
 
 #include "base/check.h"
+#include "base/exception.h"
+#include "context/context.h"
+#include "options/decision_options.h"
+#include "prop/theory_proxy.h"
+#include "util/resource_manager.h"
 #include "util/statistics_registry.h"
 
 namespace cvc5 {
@@ -53,13 +59,480 @@ CadicalLit toCadicalLit(const SatLiteral lit)
 
 CadicalVar toCadicalVar(SatVariable var) { return var; }
 
+SatLiteral toSatLiteral(CadicalLit lit)
+{
+  return SatLiteral(std::abs(lit), lit < 0);
+}
+
 }  // namespace helper functions
 
+#ifdef CVC5_CADICAL_EXTERNAL_PROPAGATOR
+
+/**
+ * Connects CaDiCaL to the theories via the external propagator interface
+ * (IPASIR-UP). CaDiCaL notifies the propagator about assignments of observed
+ * variables (the theory atoms, and all variables if the decision engine is
+ * used) and about new decision levels and backtracking, which are mirrored in
+ * the SAT context. In turn, the propagator provides theory propagations,
+ * lazily explained on request, theory lemmas and conflicts as external
+ * clauses, and decisions requested by the theories and the decision engine.
+ *
+ * Chronological backtracking is disabled in CaDiCaL, hence every assignment
+ * is notified at the current decision level, and backtracking to a level
+ * unassigns exactly the assignments made above it.
+ */
+class CadicalPropagator : public CaDiCaL::ExternalPropagator
+{
+ public:
+  CadicalPropagator(CaDiCaL::Solver& solver,
+                    TheoryProxy* proxy,
+                    context::Context* context,
+                    IntStat& numTheoryPropagations,
+                    IntStat& numTheoryLemmas)
+      : d_solver(solver),
+        d_proxy(proxy),
+        d_context(context),
+        d_baseContextLevel(context->getLevel()),
+        d_observeAll(options::decisionMode()
+                     != options::DecisionMode::INTERNAL),
+        d_numTheoryPropagations(numTheoryPropagations),
+        d_numTheoryLemmas(numTheoryLemmas)
+  {
+    is_lazy = false;
+    are_reasons_forgettable = false;
+  }
+
+  /** Register new variable var, introduced at the given user level. */
+  void addVar(SatVariable var,
+              bool isTheoryAtom,
+              bool preRegister,
+              uint32_t userLevel)
+  {
+    if (var >= d_varInfo.size())
+    {
+      d_varInfo.resize(var + 1);
+    }
+    VarInfo& info = d_varInfo[var];
+    info.d_introLevel = userLevel;
+    info.d_isTheoryAtom = isTheoryAtom;
+    if (isTheoryAtom || d_observeAll)
+    {
+      info.d_observed = true;
+      d_solver.add_observed_var(toCadicalVar(var));
+    }
+    // Variables registered during search have to be registered again when
+    // backtracking below the decision level they were introduced at.
+    if (preRegister && d_level > 0)
+    {
+      d_varsToRegister.emplace_back(var, d_level);
+    }
+  }
+
+  void notify_assignment(const std::vector<int>& lits) override
+  {
+    for (CadicalLit clit : lits)
+    {
+      SatLiteral lit = toSatLiteral(clit);
+      VarInfo& info = d_varInfo[lit.getSatVariable()];
+      Assert(info.d_observed);
+      if (info.d_assignment != SAT_VALUE_UNKNOWN)
+      {
+        // Fixed literals may be notified again by CaDiCaL.
+        Assert(info.d_level == 0);
+        continue;
+      }
+      info.d_assignment = lit.isNegated() ? SAT_VALUE_FALSE : SAT_VALUE_TRUE;
+      info.d_level = d_level;
+      if (d_level == 0)
+      {
+        if (info.d_isTheoryAtom)
+        {
+          d_fixed.emplace_back(lit, d_userLevel);
+        }
+      }
+      else
+      {
+        d_assignments.push_back(lit);
+      }
+      Trace("cadical::propagator") << "assign " << lit << "@" << d_level
+                                   << std::endl;
+      if (info.d_isTheoryAtom)
+      {
+        d_proxy->enqueueTheoryLiteral(lit);
+      }
+    }
+  }
+
+  void notify_new_decision_level() override
+  {
+    d_context->push();
+    d_assignmentLimits.push_back(d_assignments.size());
+    ++d_level;
+    Assert(static_cast<size_t>(d_context->getLevel() - d_baseContextLevel)
+           == d_level);
+  }
+
+  void notify_backtrack(size_t newLevel) override
+  {
+    // May be notified after resetTrail() already backtracked to level 0.
+    if (newLevel >= d_level)
+    {
+      return;
+    }
+    Trace("cadical::propagator") << "backtrack to " << newLevel << std::endl;
+    d_context->popto(d_baseContextLevel + newLevel);
+    size_t limit = d_assignmentLimits[newLevel];
+    for (size_t i = limit, size = d_assignments.size(); i < size; ++i)
+    {
+      VarInfo& info = d_varInfo[d_assignments[i].getSatVariable()];
+      info.d_assignment = SAT_VALUE_UNKNOWN;
+      info.d_level = -1;
+    }
+    d_assignments.resize(limit);
+    d_assignmentLimits.resize(newLevel);
+    d_level = newLevel;
+    // Pending propagations are not valid anymore
+    d_propagations.clear();
+    d_propagationsHead = 0;
+    // Register variables again that were introduced above the new level, in
+    // the order they were introduced.
+    size_t i = d_varsToRegister.size();
+    while (i > 0 && d_varsToRegister[i - 1].second > d_level)
+    {
+      --i;
+    }
+    for (size_t size = d_varsToRegister.size(); i < size; ++i)
+    {
+      d_varsToRegister[i].second = d_level;
+      d_proxy->variableNotify(d_varsToRegister[i].first);
+    }
+    if (d_level == 0)
+    {
+      d_varsToRegister.clear();
+    }
+  }
+
+  bool cb_check_found_model(const std::vector<int>& model) override
+  {
+    Assert(d_propagationsHead == d_propagations.size());
+    if (hasPendingClauses())
+    {
+      return false;
+    }
+    bool recheck;
+    do
+    {
+      d_proxy->theoryCheck(theory::Theory::EFFORT_FULL);
+      theoryPropagate();
+      // All observed variables are assigned, hence the only propagations that
+      // are relevant are conflicts, which are added as clauses.
+      d_propagations.clear();
+      d_propagationsHead = 0;
+      if (hasPendingClauses())
+      {
+        return false;
+      }
+      recheck = d_proxy->theoryNeedCheck();
+    } while (recheck);
+    return true;
+  }
+
+  int cb_decide() override
+  {
+    d_proxy->spendResource(Resource::DecisionStep);
+    SatLiteral lit = d_proxy->getNextTheoryDecisionRequest();
+    while (lit != undefSatLiteral)
+    {
+      const VarInfo& info = d_varInfo[lit.getSatVariable()];
+      if (!info.d_observed)
+      {
+        break;
+      }
+      if (info.d_assignment == SAT_VALUE_UNKNOWN)
+      {
+        Trace("cadical::propagator") << "theory decision " << lit << std::endl;
+        return toCadicalLit(lit);
+      }
+      lit = d_proxy->getNextTheoryDecisionRequest();
+    }
+    if (d_observeAll)
+    {
+      bool stopSearch = false;
+      lit = d_proxy->getNextDecisionEngineRequest(stopSearch);
+      if (!stopSearch && lit != undefSatLiteral
+          && d_varInfo[lit.getSatVariable()].d_assignment == SAT_VALUE_UNKNOWN)
+      {
+        Trace("cadical::propagator") << "DE decision " << lit << std::endl;
+        return toCadicalLit(lit);
+      }
+    }
+    return 0;
+  }
+
+  int cb_propagate() override
+  {
+    if (d_propagationsHead == d_propagations.size())
+    {
+      d_propagations.clear();
+      d_propagationsHead = 0;
+      d_proxy->theoryCheck(theory::Theory::EFFORT_STANDARD);
+      theoryPropagate();
+    }
+    while (d_propagationsHead < d_propagations.size())
+    {
+      SatLiteral lit = d_propagations[d_propagationsHead++];
+      SatValue value = d_varInfo[lit.getSatVariable()].d_assignment;
+      if (value == SAT_VALUE_UNKNOWN)
+      {
+        ++d_numTheoryPropagations;
+        return toCadicalLit(lit);
+      }
+    }
+    return 0;
+  }
+
+  int cb_add_reason_clause_lit(int propagatedLit) override
+  {
+    if (d_reason.empty())
+    {
+      SatClause explanation;
+      d_proxy->explainPropagation(toSatLiteral(propagatedLit), explanation);
+      Assert(explanation[0] == toSatLiteral(propagatedLit));
+      for (const SatLiteral& lit : explanation)
+      {
+        d_reason.push_back(toCadicalLit(lit));
+      }
+      d_reason.push_back(0);
+      d_reasonHead = 0;
+    }
+    CadicalLit lit = d_reason[d_reasonHead++];
+    if (lit == 0)
+    {
+      d_reason.clear();
+    }
+    return lit;
+  }
+
+  bool cb_has_external_clause(bool& isForgettable) override
+  {
+    if (!hasPendingClauses())
+    {
+      return false;
+    }
+    isForgettable = d_clausesRemovable[d_clausesRemovableHead];
+    return true;
+  }
+
+  int cb_add_external_clause_lit() override
+  {
+    Assert(hasPendingClauses());
+    CadicalLit lit = d_clauses[d_clausesHead++];
+    if (lit == 0)
+    {
+      ++d_clausesRemovableHead;
+      if (d_clausesHead == d_clauses.size())
+      {
+        d_clauses.clear();
+        d_clausesHead = 0;
+        d_clausesRemovable.clear();
+        d_clausesRemovableHead = 0;
+      }
+    }
+    return lit;
+  }
+
+  /** Add clause during search, provided to CaDiCaL as external clause. */
+  void addClause(const std::vector<CadicalLit>& clause, bool removable)
+  {
+    d_clauses.insert(d_clauses.end(), clause.begin(), clause.end());
+    d_clauses.push_back(0);
+    d_clausesRemovable.push_back(removable);
+    ++d_numTheoryLemmas;
+  }
+
+  /** Called before and after CaDiCaL searches. */
+  void setInSearch(bool inSearch) { d_inSearch = inSearch; }
+  bool inSearch() const { return d_inSearch; }
+
+  /** Called after a user push and the corresponding push of the SAT context. */
+  void userPush()
+  {
+    Assert(d_level == 0);
+    ++d_userLevel;
+    d_baseContextLevel = d_context->getLevel();
+  }
+
+  /**
+   * Called after a user pop and the corresponding pop of the SAT context.
+   * Removes the variables introduced at the popped user level and asserts
+   * the fixed theory literals again that were asserted to the theories above
+   * the new user level, since their assertion was popped.
+   */
+  void userPop()
+  {
+    Assert(d_level == 0);
+    Assert(d_userLevel > 0);
+    --d_userLevel;
+    d_baseContextLevel = d_context->getLevel();
+    for (size_t var = 0, size = d_varInfo.size(); var < size; ++var)
+    {
+      VarInfo& info = d_varInfo[var];
+      if (info.d_observed
+          && static_cast<uint32_t>(info.d_introLevel) > d_userLevel)
+      {
+        d_solver.remove_observed_var(toCadicalVar(var));
+        info = VarInfo();
+      }
+    }
+    size_t keep = 0;
+    for (size_t i = 0, size = d_fixed.size(); i < size; ++i)
+    {
+      const SatLiteral& lit = d_fixed[i].first;
+      if (d_varInfo[lit.getSatVariable()].d_observed)
+      {
+        if (d_fixed[i].second > d_userLevel)
+        {
+          d_fixed[i].second = d_userLevel;
+          d_proxy->enqueueTheoryLiteral(lit);
+        }
+        d_fixed[keep++] = d_fixed[i];
+      }
+    }
+    d_fixed.resize(keep);
+  }
+
+  /** Backtrack the SAT context and the assignments to level 0. */
+  void resetTrail()
+  {
+    notify_backtrack(0);
+    d_baseContextLevel = d_context->getLevel();
+  }
+
+  /** Returns the value of lit in the current (partial) assignment. */
+  SatValue value(SatLiteral lit) const
+  {
+    SatVariable var = lit.getSatVariable();
+    if (var >= d_varInfo.size() || !d_varInfo[var].d_observed)
+    {
+      return SAT_VALUE_UNKNOWN;
+    }
+    SatValue value = d_varInfo[var].d_assignment;
+    if (lit.isNegated() && value != SAT_VALUE_UNKNOWN)
+    {
+      return value == SAT_VALUE_TRUE ? SAT_VALUE_FALSE : SAT_VALUE_TRUE;
+    }
+    return value;
+  }
+
+  int32_t getDecisionLevel(SatVariable var) const
+  {
+    return var < d_varInfo.size() ? d_varInfo[var].d_level : -1;
+  }
+
+  int32_t getIntroLevel(SatVariable var) const
+  {
+    return var < d_varInfo.size() ? d_varInfo[var].d_introLevel : -1;
+  }
+
+ private:
+  /** Bookkeeping of a SAT variable. */
+  struct VarInfo
+  {
+    /** The user level the variable was introduced at. */
+    int32_t d_introLevel = -1;
+    /** The decision level of the assignment, -1 if unassigned. */
+    int32_t d_level = -1;
+    /** The current assignment, only maintained for observed variables. */
+    SatValue d_assignment = SAT_VALUE_UNKNOWN;
+    bool d_isTheoryAtom = false;
+    /** Whether CaDiCaL notifies us about assignments of the variable. */
+    bool d_observed = false;
+  };
+
+  /** Collect the theory propagations, conflicts are added as clauses. */
+  void theoryPropagate()
+  {
+    SatClause propagated;
+    d_proxy->theoryPropagate(propagated);
+    for (const SatLiteral& lit : propagated)
+    {
+      if (!d_varInfo[lit.getSatVariable()].d_observed)
+      {
+        continue;
+      }
+      if (value(lit) == SAT_VALUE_FALSE)
+      {
+        // Conflicting propagation, add the explanation as clause
+        SatClause explanation;
+        d_proxy->explainPropagation(lit, explanation);
+        std::vector<CadicalLit> clause;
+        for (const SatLiteral& l : explanation)
+        {
+          clause.push_back(toCadicalLit(l));
+        }
+        addClause(clause, true);
+      }
+      else
+      {
+        d_propagations.push_back(lit);
+      }
+    }
+  }
+
+  bool hasPendingClauses() const { return d_clausesHead < d_clauses.size(); }
+
+  CaDiCaL::Solver& d_solver;
+  TheoryProxy* d_proxy;
+  /** The SAT context, pushed for every decision level of CaDiCaL. */
+  context::Context* d_context;
+  /** The level of the SAT context at decision level 0. */
+  int d_baseContextLevel;
+  /** Whether all variables are observed, for the decision engine. */
+  bool d_observeAll;
+  bool d_inSearch = false;
+  /** The current decision level of CaDiCaL. */
+  size_t d_level = 0;
+  /** The current user level. */
+  uint32_t d_userLevel = 0;
+  /** Indexed by SAT variable. */
+  std::vector<VarInfo> d_varInfo;
+  /** The assignments of observed variables above decision level 0. */
+  std::vector<SatLiteral> d_assignments;
+  /** The start of each decision level > 0 in d_assignments. */
+  std::vector<size_t> d_assignmentLimits;
+  /** Theory literals fixed at level 0, with the user level of assertion. */
+  std::vector<std::pair<SatLiteral, uint32_t>> d_fixed;
+  /** Variables registered during search, with their decision level. */
+  std::vector<std::pair<SatVariable, size_t>> d_varsToRegister;
+  /** Pending theory propagations. */
+  std::vector<SatLiteral> d_propagations;
+  size_t d_propagationsHead = 0;
+  /** The reason clause currently provided to CaDiCaL, 0-terminated. */
+  std::vector<CadicalLit> d_reason;
+  size_t d_reasonHead = 0;
+  /** Pending clauses, 0-terminated, and whether they are removable. */
+  std::vector<CadicalLit> d_clauses;
+  size_t d_clausesHead = 0;
+  std::vector<bool> d_clausesRemovable;
+  size_t d_clausesRemovableHead = 0;
+  IntStat& d_numTheoryPropagations;
+  IntStat& d_numTheoryLemmas;
+};
+
+#else
+
+class CadicalPropagator
+{
+};
+
+#endif
+
 CadicalSolver::CadicalSolver(StatisticsRegistry& registry,
                              const std::string& name)
     : d_solver(new CaDiCaL::Solver()),
       // Note: CaDiCaL variables start with index 1 rather than 0 since negated
       //       literals are represented as the negation of the index.
+      d_context(nullptr),
       d_nextVarIdx(1),
       d_inSatMode(false),
       d_statistics(registry, name)
@@ -82,10 +555,31 @@ CadicalSolver::~CadicalSolver() {}
 
 ClauseId CadicalSolver::addClause(SatClause& clause, bool removable)
 {
+#ifdef CVC5_CADICAL_EXTERNAL_PROPAGATOR
+  if (d_propagator && d_propagator->inSearch())
+  {
+    std::vector<CadicalLit> lits;
+    for (const SatLiteral& lit : clause)
+    {
+      lits.push_back(toCadicalLit(lit));
+    }
+    if (!d_activationLits.empty())
+    {
+      lits.push_back(toCadicalLit(~d_activationLits.back()));
+    }
+    d_propagator->addClause(lits, removable);
+    ++d_statistics.d_numClauses;
+    return ClauseIdError;
+  }
+#endif
   for (const SatLiteral& lit : clause)
   {
     d_solver->add(toCadicalLit(lit));
   }
+  if (!d_activationLits.empty())
+  {
+    d_solver->add(toCadicalLit(~d_activationLits.back()));
+  }
   d_solver->add(0);
   ++d_statistics.d_numClauses;
   return ClauseIdError;
@@ -103,7 +597,18 @@ SatVariable CadicalSolver::newVar(bool isTheoryAtom,
                                   bool canErase)
 {
   ++d_statistics.d_numVariables;
-  return d_nextVarIdx++;
+  SatVariable var = d_nextVarIdx++;
+#ifdef CVC5_CADICAL_EXTERNAL_PROPAGATOR
+  if (d_propagator)
+  {
+    if (!canErase)
+    {
+      d_solver->freeze(toCadicalVar(var));
+    }
+    d_propagator->addVar(var, isTheoryAtom, preRegister, d_activationLits.size());
+  }
+#endif
+  return var;
 }
 
 SatVariable CadicalSolver::trueVar() { return d_true; }
@@ -112,12 +617,8 @@ SatVariable CadicalSolver::falseVar() { return d_false; }
 
 SatValue CadicalSolver::solve()
 {
-  TimerStat::CodeTimer codeTimer(d_statistics.d_solveTime);
   d_assumptions.clear();
-  SatValue res = toSatValue(d_solver->solve());
-  d_inSatMode = (res == SAT_VALUE_TRUE);
-  ++d_statistics.d_numSatCalls;
-  return res;
+  return solveInternal();
 }
 
 SatValue CadicalSolver::solve(long unsigned int&)
@@ -126,15 +627,41 @@ SatValue CadicalSolver::solve(long unsigned int&)
 };
 
 SatValue CadicalSolver::solve(const std::vector<SatLiteral>& assumptions)
+{
+  d_assumptions = assumptions;
+  return solveInternal();
+}
+
+SatValue CadicalSolver::solveInternal()
 {
   TimerStat::CodeTimer codeTimer(d_statistics.d_solveTime);
-  d_assumptions.clear();
-  for (const SatLiteral& lit : assumptions)
+  d_inSatMode = false;
+  for (const SatLiteral& lit : d_pendingPhases)
+  {
+    d_solver->phase(toCadicalLit(lit));
+  }
+  d_pendingPhases.clear();
+  for (const SatLiteral& lit : d_activationLits)
+  {
+    d_solver->assume(toCadicalLit(lit));
+  }
+  for (const SatLiteral& lit : d_assumptions)
   {
     d_solver->assume(toCadicalLit(lit));
-    d_assumptions.push_back(lit);
   }
+#ifdef CVC5_CADICAL_EXTERNAL_PROPAGATOR
+  if (d_propagator)
+  {
+    d_propagator->setInSearch(true);
+  }
+#endif
   SatValue res = toSatValue(d_solver->solve());
+#ifdef CVC5_CADICAL_EXTERNAL_PROPAGATOR
+  if (d_propagator)
+  {
+    d_propagator->setInSearch(false);
+  }
+#endif
   d_inSatMode = (res == SAT_VALUE_TRUE);
   ++d_statistics.d_numSatCalls;
   return res;
@@ -161,6 +688,12 @@ void CadicalSolver::interrupt() { d_solver->terminate(); }
 
 SatValue CadicalSolver::value(SatLiteral l)
 {
+#ifdef CVC5_CADICAL_EXTERNAL_PROPAGATOR
+  if (d_propagator && !d_inSatMode)
+  {
+    return d_propagator->value(l);
+  }
+#endif
   Assert(d_inSatMode);
   return toSatValueLit(d_solver->val(toCadicalLit(l)));
 }
@@ -173,16 +706,140 @@ SatValue CadicalSolver::modelValue(SatLiteral l)
 
 unsigned CadicalSolver::getAssertionLevel() const
 {
-  Unreachable() << "CaDiCaL does not support assertion levels.";
+  return d_activationLits.size();
 }
 
 bool CadicalSolver::ok() const { return d_inSatMode; }
 
+/* CDCL(T) interface -------------------------------------------------------- */
+
+void CadicalSolver::initialize(context::Context* context,
+                               prop::TheoryProxy* theoryProxy,
+                               context::UserContext* userContext,
+                               ProofNodeManager* pnm)
+{
+#ifdef CVC5_CADICAL_EXTERNAL_PROPAGATOR
+  d_context = context;
+  d_propagator.reset(
+      new CadicalPropagator(*d_solver,
+                            theoryProxy,
+                            context,
+                            d_statistics.d_numTheoryPropagations,
+                            d_statistics.d_numTheoryLemmas));
+  // The propagator requires that backtracking unassigns all assignments
+  // above the target level, and that the solver backtracks to level 0 before
+  // clauses are added between calls to solve().
+  d_solver->set("chrono", 0);
+  d_solver->set("ilb", 0);
+  d_solver->connect_external_propagator(d_propagator.get());
+  // Register the variables created in init()
+  d_propagator->addVar(d_true, false, false, 0);
+  d_propagator->addVar(d_false, false, false, 0);
+#else
+  Unreachable() << "CaDiCaL was built without external propagator support";
+#endif
+}
+
+void CadicalSolver::push()
+{
+  if (!d_propagator)
+  {
+    throw Exception("CaDiCaL supports push only as CDCL(T) SAT solver");
+  }
+  d_context->push();
+  SatLiteral act(newVar(false, false, false));
+  d_activationLits.push_back(act);
+#ifdef CVC5_CADICAL_EXTERNAL_PROPAGATOR
+  d_propagator->userPush();
+#endif
+  Trace("cadical") << "push: activation literal " << act << std::endl;
+}
+
+void CadicalSolver::pop()
+{
+  if (!d_propagator)
+  {
+    throw Exception("CaDiCaL supports pop only as CDCL(T) SAT solver");
+  }
+  if (d_activationLits.empty())
+  {
+    throw Exception("CaDiCaL: pop without matching push");
+  }
+  d_context->pop();
+  // Permanently disable the clauses of the popped user level
+  SatLiteral act = d_activationLits.back();
+  d_activationLits.pop_back();
+  d_solver->add(toCadicalLit(~act));
+  d_solver->add(0);
+  d_inSatMode = false;
+#ifdef CVC5_CADICAL_EXTERNAL_PROPAGATOR
+  d_propagator->userPop();
+#endif
+  Trace("cadical") << "pop: deactivated " << act << std::endl;
+}
+
+void CadicalSolver::resetTrail()
+{
+#ifdef CVC5_CADICAL_EXTERNAL_PROPAGATOR
+  if (d_propagator)
+  {
+    d_propagator->resetTrail();
+  }
+#endif
+}
+
+bool CadicalSolver::properExplanation(SatLiteral lit, SatLiteral expl) const
+{
+  return true;
+}
+
+void CadicalSolver::requirePhase(SatLiteral lit)
+{
+  // The phase cannot be set from within a callback of the propagator
+  d_pendingPhases.push_back(lit);
+}
+
+bool CadicalSolver::isDecision(SatVariable decn) const
+{
+  if (getDecisionLevel(decn) <= 0)
+  {
+    return false;
+  }
+  return d_solver->is_decision(toCadicalVar(decn));
+}
+
+int32_t CadicalSolver::getDecisionLevel(SatVariable v) const
+{
+#ifdef CVC5_CADICAL_EXTERNAL_PROPAGATOR
+  return d_propagator->getDecisionLevel(v);
+#else
+  return -1;
+#endif
+}
+
+int32_t CadicalSolver::getIntroLevel(SatVariable v) const
+{
+#ifdef CVC5_CADICAL_EXTERNAL_PROPAGATOR
+  return d_propagator->getIntroLevel(v);
+#else
+  return -1;
+#endif
+}
+
+std::shared_ptr<ProofNode> CadicalSolver::getProof()
+{
+  Unreachable() << "CaDiCaL does not support proofs as CDCL(T) SAT solver";
+}
+
 CadicalSolver::Statistics::Statistics(StatisticsRegistry& registry,
                                       const std::string& prefix)
     : d_numSatCalls(registry.registerInt(prefix + "cadical::calls_to_solve", 0)),
       d_numVariables(registry.registerInt(prefix + "cadical::variables", 0)),
       d_numClauses(registry.registerInt(prefix + "cadical::clauses", 0)),
+      d_numTheoryPropagations(
+          registry.registerInt(prefix + "cadical::theory_propagations", 0)),
+      d_numTheoryLemmas(
+          registry.registerInt(prefix + "cadical::theory_lemmas", 0)),
       d_solveTime(registry.registerTimer(prefix + "cadical::solve_time"))
   {
 }
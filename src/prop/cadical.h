@@ -12,7 +12,9 @@
  *
  * Wrapper for CaDiCaL SAT Solver.
  *
- * Implementation of the CaDiCaL SAT solver for cvc5 (bit-vectors).
+ * Implementation of the CaDiCaL SAT solver for cvc5 (bit-vectors), which can
+ * also be used as the CDCL(T) SAT solver of the PropEngine if CaDiCaL
+ * supports external propagators (IPASIR-UP).
  */
 
 #include "cvc5_private.h"
@@ -27,7 +29,9 @@
 namespace cvc5 {
 namespace prop {
 
-class CadicalSolver : public SatSolver
+class CadicalPropagator;
+
+class CadicalSolver : public CDCLTSatSolverInterface
 {
   friend class SatSolverFactory;
 
@@ -62,6 +66,31 @@ class CadicalSolver : public SatSolver
 
   bool ok() const override;
 
+  /* CDCL(T) interface, requires CaDiCaL with external propagator support */
+
+  void initialize(context::Context* context,
+                  prop::TheoryProxy* theoryProxy,
+                  context::UserContext* userContext,
+                  ProofNodeManager* pnm) override;
+
+  void push() override;
+
+  void pop() override;
+
+  void resetTrail() override;
+
+  bool properExplanation(SatLiteral lit, SatLiteral expl) const override;
+
+  void requirePhase(SatLiteral lit) override;
+
+  bool isDecision(SatVariable decn) const override;
+
+  int32_t getDecisionLevel(SatVariable v) const override;
+
+  int32_t getIntroLevel(SatVariable v) const override;
+
+  std::shared_ptr<ProofNode> getProof() override;
+
  private:
   /**
    * Private to disallow creation outside of SatSolverFactory.
@@ -73,8 +102,25 @@ class CadicalSolver : public SatSolver
    * Note: Split out to not call virtual functions in constructor.
    */
   void init();
+  /** Call solve() of CaDiCaL on the current assumptions. */
+  SatValue solveInternal();
 
   std::unique_ptr<CaDiCaL::Solver> d_solver;
+  /**
+   * The propagator connecting CaDiCaL to the theories, only set if this is
+   * used as the CDCL(T) SAT solver (see initialize()).
+   */
+  std::unique_ptr<CadicalPropagator> d_propagator;
+  /** The SAT context, pushed on user pushes, owned by the PropEngine. */
+  context::Context* d_context;
+  /**
+   * The activation literals of the user levels. Clauses added at user level
+   * n > 0 contain the negation of d_activationLits[n - 1], which is assumed
+   * in every call to solve() until the level is popped.
+   */
+  std::vector<SatLiteral> d_activationLits;
+  /** Phases required via requirePhase(), set before the next call to solve. */
+  std::vector<SatLiteral> d_pendingPhases;
   /**
    * Stores the current set of assumptions provided via solve() and is used to
    * query the solver if a given assumption is false.
@@ -91,6 +137,8 @@ class CadicalSolver : public SatSolver
     IntStat d_numSatCalls;
     IntStat d_numVariables;
     IntStat d_numClauses;
+    IntStat d_numTheoryPropagations;
+    IntStat d_numTheoryLemmas;
     TimerStat d_solveTime;
     Statistics(StatisticsRegistry& registry, const std::string& prefix);
   };
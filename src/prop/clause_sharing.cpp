@@ -0,0 +1,287 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Exchange of short learned clauses and lemmas between solver instances
+ * running on the same input.
+ */
+
+#include "prop/clause_sharing.h"
+
+#include <dirent.h>
+
+#include <algorithm>
+
+#include "expr/node_algorithm.h"
+#include "options/prop_options.h"
+#include "prop/cnf_stream.h"
+#include "smt/smt_statistics_registry.h"
+
+namespace cvc5 {
+namespace prop {
+
+namespace {
+
+/** The suffix of the files of exported clauses */
+const std::string s_suffix = ".clauses";
+
+}  // namespace
+
+ClauseSharing::ClauseSharing(CnfStream* cnfStream,
+                             const std::string& dir,
+                             uint64_t id,
+                             bool exportClauses)
+    : d_cnfStream(cnfStream),
+      d_dir(dir),
+      d_name(std::to_string(id) + s_suffix),
+      d_export(exportClauses),
+      d_maxSize(options::clauseSharingMaxSize()),
+      d_maxLbd(options::clauseSharingMaxLbd()),
+      d_numFormulas(0),
+      d_numExported(smtStatisticsRegistry().registerInt(
+          "prop::clause_sharing::exported")),
+      d_numImported(smtStatisticsRegistry().registerInt(
+          "prop::clause_sharing::imported"))
+{
+  if (d_export)
+  {
+    d_out.open(d_dir + "/" + d_name, std::ios::out | std::ios::app);
+    d_export = d_out.good();
+  }
+}
+
+ClauseSharing::~ClauseSharing() {}
+
+std::string ClauseSharing::toShared(const SatLiteral& lit)
+{
+  TNode n = d_cnfStream->getNode(lit);
+  bool negated = n.getKind() == kind::NOT;
+  TNode formula = negated ? n[0] : n;
+  auto it = d_printed.find(formula);
+  if (it == d_printed.end())
+  {
+    std::string printed;
+    // skolems of different instances are unrelated
+    if (!expr::hasSubtermKind(kind::SKOLEM, formula))
+    {
+      printed = formula.toString();
+      if (printed.find_first_of("\t\n") != std::string::npos)
+      {
+        printed.clear();
+      }
+    }
+    it = d_printed.emplace(formula, printed).first;
+  }
+  if (it->second.empty())
+  {
+    return it->second;
+  }
+  return (negated ? "-" : "+") + it->second;
+}
+
+SatLiteral ClauseSharing::fromShared(const std::string& lit)
+{
+  if (lit.size() < 2 || (lit[0] != '+' && lit[0] != '-'))
+  {
+    return undefSatLiteral;
+  }
+  auto it = d_formulas.find(lit.substr(1));
+  if (it == d_formulas.end())
+  {
+    return undefSatLiteral;
+  }
+  return lit[0] == '-' ? ~it->second : it->second;
+}
+
+void ClauseSharing::write(std::vector<std::string>& lits)
+{
+  // print the literals in a canonical order to detect duplicates
+  std::sort(lits.begin(), lits.end());
+  std::string line;
+  for (const std::string& lit : lits)
+  {
+    line += (line.empty() ? "" : "\t") + lit;
+  }
+  if (markSeen(line))
+  {
+    d_out << line << '\n';
+    ++d_numExported;
+  }
+}
+
+bool ClauseSharing::markSeen(const std::string& line)
+{
+  return d_seen.insert(std::hash<std::string>()(line)).second;
+}
+
+void ClauseSharing::exportClause(const SatClause& clause, uint32_t lbd)
+{
+  if (!d_export || clause.size() > d_maxSize || lbd > d_maxLbd)
+  {
+    return;
+  }
+  std::vector<std::string> lits;
+  for (const SatLiteral& lit : clause)
+  {
+    lits.push_back(toShared(lit));
+    if (lits.back().empty())
+    {
+      return;
+    }
+  }
+  write(lits);
+}
+
+void ClauseSharing::exportLemma(TNode lemma)
+{
+  if (!d_export)
+  {
+    return;
+  }
+  size_t size = lemma.getKind() == kind::OR ? lemma.getNumChildren() : 1;
+  if (size > d_maxSize)
+  {
+    return;
+  }
+  std::vector<std::string> lits;
+  for (size_t i = 0; i < size; ++i)
+  {
+    TNode lit = size == 1 && lemma.getKind() != kind::OR ? lemma : lemma[i];
+    if (!d_cnfStream->hasLiteral(lit))
+    {
+      return;
+    }
+    lits.push_back(toShared(d_cnfStream->getLiteral(lit)));
+    if (lits.back().empty())
+    {
+      return;
+    }
+  }
+  write(lits);
+}
+
+void ClauseSharing::updatePeers()
+{
+  DIR* dir = opendir(d_dir.c_str());
+  if (dir == nullptr)
+  {
+    return;
+  }
+  while (struct dirent* entry = readdir(dir))
+  {
+    std::string name = entry->d_name;
+    size_t len = name.size();
+    if (name == d_name || len <= s_suffix.size()
+        || name.compare(len - s_suffix.size(), s_suffix.size(), s_suffix) != 0
+        || d_peers.find(name) != d_peers.end())
+    {
+      continue;
+    }
+    std::unique_ptr<Peer> peer(new Peer());
+    peer->d_in.open(d_dir + "/" + name);
+    if (peer->d_in.good())
+    {
+      d_peers.emplace(name, std::move(peer));
+    }
+  }
+  closedir(dir);
+}
+
+bool ClauseSharing::importLine(const std::string& line,
+                               std::vector<SatClause>& clauses)
+{
+  size_t hash = std::hash<std::string>()(line);
+  if (d_seen.find(hash) != d_seen.end())
+  {
+    return true;
+  }
+  SatClause clause;
+  size_t start = 0;
+  while (start <= line.size())
+  {
+    size_t end = line.find('\t', start);
+    if (end == std::string::npos)
+    {
+      end = line.size();
+    }
+    SatLiteral lit = fromShared(line.substr(start, end - start));
+    if (lit == undefSatLiteral)
+    {
+      return false;
+    }
+    clause.push_back(lit);
+    start = end + 1;
+  }
+  d_seen.insert(hash);
+  clauses.push_back(clause);
+  ++d_numImported;
+  return true;
+}
+
+void ClauseSharing::importClauses(std::vector<SatClause>& clauses)
+{
+  // make the exported clauses visible to the other instances
+  if (d_export)
+  {
+    d_out.flush();
+  }
+  updatePeers();
+  // index the formulas that were converted since the last import
+  const CnfStream::NodeToLiteralMap& cache = d_cnfStream->getTranslationCache();
+  d_numFormulas = std::min(d_numFormulas, cache.size());
+  for (auto it = cache.begin() + d_numFormulas; it != cache.end(); ++it)
+  {
+    if (it->first.getKind() != kind::NOT)
+    {
+      std::string printed = toShared(it->second);
+      if (!printed.empty())
+      {
+        // toShared() prints the polarity of the literal, not of the formula
+        d_formulas.emplace(printed.substr(1), it->second);
+      }
+    }
+  }
+  d_numFormulas = cache.size();
+
+  char buf[4096];
+  for (auto& p : d_peers)
+  {
+    Peer& peer = *p.second;
+    do
+    {
+      peer.d_in.read(buf, sizeof(buf));
+      peer.d_pending.append(buf, peer.d_in.gcount());
+    } while (peer.d_in.gcount() > 0);
+    // the peer may append more clauses later
+    peer.d_in.clear();
+
+    // retry the lines whose formulas had no literal yet, then the new lines
+    std::vector<std::string> lines;
+    lines.swap(peer.d_deferred);
+    size_t start = 0;
+    for (size_t end = peer.d_pending.find('\n'); end != std::string::npos;
+         start = end + 1, end = peer.d_pending.find('\n', start))
+    {
+      lines.push_back(peer.d_pending.substr(start, end - start));
+    }
+    for (const std::string& line : lines)
+    {
+      if (!importLine(line, clauses))
+      {
+        peer.d_deferred.push_back(line);
+      }
+    }
+    peer.d_pending.erase(0, start);
+  }
+}
+
+}  // namespace prop
+}  // namespace cvc5
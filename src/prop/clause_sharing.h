@@ -0,0 +1,152 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Exchange of short learned clauses and lemmas between solver instances
+ * running on the same input.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__PROP__CLAUSE_SHARING_H
+#define CVC5__PROP__CLAUSE_SHARING_H
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "expr/node.h"
+#include "prop/sat_solver_types.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5 {
+namespace prop {
+
+class CnfStream;
+
+/**
+ * Exchanges short clauses with other instances that run on the same input,
+ * through a directory in which every instance appends the clauses it exports
+ * to its own file.
+ *
+ * Clauses are exchanged in terms of the formulas that the literals stand for,
+ * printed as strings, and are only imported if all of these formulas have a
+ * literal in the importing instance. Since the input symbols of all
+ * instances coincide, a clause over formulas without skolems is implied by
+ * the input if the exporting instance derived it from a preprocessed input
+ * that is equivalent to its input.
+ */
+class ClauseSharing
+{
+ public:
+  /**
+   * @param cnfStream The CNF stream mapping SAT literals to formulas
+   * @param dir The directory through which the clauses are exchanged
+   * @param id The identifier of this instance, distinct for the instances
+   * sharing dir
+   * @param exportClauses Whether this instance exports clauses, which is only
+   * sound if its preprocessing is equivalence preserving
+   */
+  ClauseSharing(CnfStream* cnfStream,
+                const std::string& dir,
+                uint64_t id,
+                bool exportClauses);
+  ~ClauseSharing();
+
+  /**
+   * Export a learned clause with the given LBD (the number of distinct
+   * decision levels of its literals), if it is short enough.
+   */
+  void exportClause(const SatClause& clause, uint32_t lbd);
+  /**
+   * Export a lemma, if it is a short clause over literals of the CNF stream.
+   */
+  void exportLemma(TNode lemma);
+  /**
+   * Adds the clauses exported by the other instances since the last call to
+   * clauses, whose formulas all have a literal in this instance.
+   */
+  void importClauses(std::vector<SatClause>& clauses);
+
+ private:
+  /** A file of clauses exported by another instance. */
+  struct Peer
+  {
+    std::ifstream d_in;
+    /** The incomplete last line read from d_in */
+    std::string d_pending;
+    /**
+     * The lines read from d_in that could not be imported yet, since some of
+     * their formulas have no literal in this instance so far.
+     */
+    std::vector<std::string> d_deferred;
+  };
+  /**
+   * Returns the printed formula of the literal, prefixed by its polarity, or
+   * the empty string if the literal cannot be shared.
+   */
+  std::string toShared(const SatLiteral& lit);
+  /** Returns the literal for a printed literal, or undefSatLiteral. */
+  SatLiteral fromShared(const std::string& lit);
+  /** Writes the printed literals to the exported file, if not seen before. */
+  void write(std::vector<std::string>& lits);
+  /** Returns true if the printed clause was not exported or imported yet. */
+  bool markSeen(const std::string& line);
+  /**
+   * Adds the clause of a printed line to clauses unless it was exported or
+   * imported before, and marks it as seen. Returns false if the clause cannot
+   * be imported yet, since one of its formulas has no literal.
+   */
+  bool importLine(const std::string& line, std::vector<SatClause>& clauses);
+  /** Opens the files of instances that started sharing since the last call. */
+  void updatePeers();
+
+  /** The CNF stream */
+  CnfStream* d_cnfStream;
+  /** The directory through which the clauses are exchanged */
+  std::string d_dir;
+  /** The name of the file of exported clauses in d_dir */
+  std::string d_name;
+  /** Whether clauses are exported */
+  bool d_export;
+  /** The maximal size of exported clauses */
+  size_t d_maxSize;
+  /** The maximal LBD of exported learned clauses */
+  uint32_t d_maxLbd;
+  /** The file of exported clauses */
+  std::ofstream d_out;
+  /** The files of the other instances, by name */
+  std::map<std::string, std::unique_ptr<Peer>> d_peers;
+  /** The printed formulas of the literals of the CNF stream */
+  std::unordered_map<std::string, SatLiteral> d_formulas;
+  /** The number of formulas of the CNF stream considered in d_formulas */
+  size_t d_numFormulas;
+  /** Cache of printed formulas, empty for formulas that are not shared */
+  std::unordered_map<Node, std::string> d_printed;
+  /**
+   * The hashes of the printed clauses exported or imported so far. A hash
+   * collision only causes a clause to be dropped, which is sound.
+   */
+  std::unordered_set<size_t> d_seen;
+  /** Number of exported clauses */
+  IntStat d_numExported;
+  /** Number of imported clauses */
+  IntStat d_numImported;
+};
+
+}  // namespace prop
+}  // namespace cvc5
+
+#endif /* CVC5__PROP__CLAUSE_SHARING_H */
@@ -21,6 +21,7 @@
 #include "base/output.h"
 #include "expr/node.h"
 #include "options/bv_options.h"
+#include "options/prop_options.h"
 #include "printer/printer.h"
 #include "proof/clause_id.h"
 #include "prop/minisat/minisat.h"
@@ -49,6 +50,8 @@ CnfStream::CnfStream(SatSolver* satSolver,
       d_notifyFormulas(context),
       d_nodeToLiteralMap(context),
       d_literalToNodeMap(context),
+      d_pgEncoding(options::cnfPolarity()),
+      d_partialPolarity(context),
       d_flitPolicy(flpol),
       d_registrar(registrar),
       d_name(name),
@@ -82,6 +85,7 @@ bool CnfStream::assertClause(TNode node, SatClause& c)
     }
   }
 
+  ++d_stats.d_numClauses;
   ClauseId clauseId = d_satSolver->addClause(c, d_removable);
 
   return clauseId != ClauseIdUndef;
@@ -142,7 +146,9 @@ void CnfStream::ensureLiteral(TNode n)
       n.getType().toString().c_str());
   Trace("cnf") << "ensureLiteral(" << n << ")\n";
   TimerStat::CodeTimer codeTimer(d_stats.d_cnfConversionTime, true);
-  if (hasLiteral(n))
+  // with the Plaisted-Greenbaum encoding, the literal of n may not be
+  // definitionally equal to n yet
+  if (hasLiteral(n) && getEncodedPolarity(n) == POLARITY_BOTH)
   {
     ensureMappingForLiteral(n);
     return;
@@ -157,7 +163,8 @@ void CnfStream::ensureLiteral(TNode n)
     // These are not removable and have no proof ID
     d_removable = false;
 
-    SatLiteral lit = toCNF(n, false);
+    encode(n, POLARITY_BOTH);
+    SatLiteral lit = getLiteral(n);
 
     // Store backward-mappings
     // These may already exist
@@ -258,6 +265,7 @@ bool CnfStream::isNotifyFormula(TNode node) const
 SatLiteral CnfStream::convertAtom(TNode node)
 {
   Trace("cnf") << "convertAtom(" << node << ")\n";
+  TimerStat::CodeTimer codeTimer(d_stats.d_atomTime, true);
 
   Assert(!hasLiteral(node)) << "atom already mapped!";
 
@@ -295,32 +303,62 @@ SatLiteral CnfStream::getLiteral(TNode node) {
   return literal;
 }
 
-void CnfStream::handleXor(TNode xorNode)
+uint8_t CnfStream::flipPolarity(uint8_t p)
+{
+  return ((p & POLARITY_POS) ? POLARITY_NEG : POLARITY_NONE)
+         | ((p & POLARITY_NEG) ? POLARITY_POS : POLARITY_NONE);
+}
+
+uint8_t CnfStream::getEncodedPolarity(TNode node) const
+{
+  if (!hasLiteral(node))
+  {
+    return POLARITY_NONE;
+  }
+  if (d_pgEncoding)
+  {
+    bool negated = node.getKind() == kind::NOT;
+    auto it = d_partialPolarity.find(negated ? node[0] : node);
+    if (it != d_partialPolarity.end())
+    {
+      return negated ? flipPolarity(it->second) : it->second;
+    }
+  }
+  return POLARITY_BOTH;
+}
+
+void CnfStream::handleXor(TNode xorNode, uint8_t polarity)
 {
-  Assert(!hasLiteral(xorNode)) << "Atom already mapped!";
   Assert(xorNode.getKind() == kind::XOR) << "Expecting an XOR expression!";
   Assert(xorNode.getNumChildren() == 2) << "Expecting exactly 2 children!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
   Trace("cnf") << "CnfStream::handleXor(" << xorNode << ")\n";
+  TimerStat::CodeTimer codeTimer(d_stats.d_xorTime);
 
   SatLiteral a = getLiteral(xorNode[0]);
   SatLiteral b = getLiteral(xorNode[1]);
 
   SatLiteral xorLit = newLiteral(xorNode);
 
-  assertClause(xorNode.negate(), a, b, ~xorLit);
-  assertClause(xorNode.negate(), ~a, ~b, ~xorLit);
-  assertClause(xorNode, a, ~b, xorLit);
-  assertClause(xorNode, ~a, b, xorLit);
+  if (polarity & POLARITY_POS)
+  {
+    assertClause(xorNode.negate(), a, b, ~xorLit);
+    assertClause(xorNode.negate(), ~a, ~b, ~xorLit);
+  }
+  if (polarity & POLARITY_NEG)
+  {
+    assertClause(xorNode, a, ~b, xorLit);
+    assertClause(xorNode, ~a, b, xorLit);
+  }
 }
 
-void CnfStream::handleOr(TNode orNode)
+void CnfStream::handleOr(TNode orNode, uint8_t polarity)
 {
-  Assert(!hasLiteral(orNode)) << "Atom already mapped!";
   Assert(orNode.getKind() == kind::OR) << "Expecting an OR expression!";
   Assert(orNode.getNumChildren() > 1) << "Expecting more then 1 child!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
   Trace("cnf") << "CnfStream::handleOr(" << orNode << ")\n";
+  TimerStat::CodeTimer codeTimer(d_stats.d_orTime);
 
   // Number of children
   size_t numChildren = orNode.getNumChildren();
@@ -337,23 +375,30 @@ void CnfStream::handleOr(TNode orNode)
     // lit <- (a_1 | a_2 | a_3 | ... | a_n)
     // lit | ~(a_1 | a_2 | a_3 | ... | a_n)
     // (lit | ~a_1) & (lit | ~a_2) & (lit & ~a_3) & ... & (lit & ~a_n)
-    assertClause(orNode, orLit, ~clause[i]);
+    if (polarity & POLARITY_NEG)
+    {
+      assertClause(orNode, orLit, ~clause[i]);
+    }
   }
 
   // lit -> (a_1 | a_2 | a_3 | ... | a_n)
   // ~lit | a_1 | a_2 | a_3 | ... | a_n
-  clause[numChildren] = ~orLit;
-  // This needs to go last, as the clause might get modified by the SAT solver
-  assertClause(orNode.negate(), clause);
+  if (polarity & POLARITY_POS)
+  {
+    clause[numChildren] = ~orLit;
+    // This needs to go last, as the clause might get modified by the SAT
+    // solver
+    assertClause(orNode.negate(), clause);
+  }
 }
 
-void CnfStream::handleAnd(TNode andNode)
+void CnfStream::handleAnd(TNode andNode, uint8_t polarity)
 {
-  Assert(!hasLiteral(andNode)) << "Atom already mapped!";
   Assert(andNode.getKind() == kind::AND) << "Expecting an AND expression!";
   Assert(andNode.getNumChildren() > 1) << "Expecting more than 1 child!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
   Trace("cnf") << "handleAnd(" << andNode << ")\n";
+  TimerStat::CodeTimer codeTimer(d_stats.d_andTime);
 
   // Number of children
   size_t numChildren = andNode.getNumChildren();
@@ -370,25 +415,32 @@ void CnfStream::handleAnd(TNode andNode)
     // lit -> (a_1 & a_2 & a_3 & ... & a_n)
     // ~lit | (a_1 & a_2 & a_3 & ... & a_n)
     // (~lit | a_1) & (~lit | a_2) & ... & (~lit | a_n)
-    assertClause(andNode.negate(), ~andLit, ~clause[i]);
+    if (polarity & POLARITY_POS)
+    {
+      assertClause(andNode.negate(), ~andLit, ~clause[i]);
+    }
   }
 
   // lit <- (a_1 & a_2 & a_3 & ... a_n)
   // lit | ~(a_1 & a_2 & a_3 & ... & a_n)
   // lit | ~a_1 | ~a_2 | ~a_3 | ... | ~a_n
-  clause[numChildren] = andLit;
-  // This needs to go last, as the clause might get modified by the SAT solver
-  assertClause(andNode, clause);
+  if (polarity & POLARITY_NEG)
+  {
+    clause[numChildren] = andLit;
+    // This needs to go last, as the clause might get modified by the SAT
+    // solver
+    assertClause(andNode, clause);
+  }
 }
 
-void CnfStream::handleImplies(TNode impliesNode)
+void CnfStream::handleImplies(TNode impliesNode, uint8_t polarity)
 {
-  Assert(!hasLiteral(impliesNode)) << "Atom already mapped!";
   Assert(impliesNode.getKind() == kind::IMPLIES)
       << "Expecting an IMPLIES expression!";
   Assert(impliesNode.getNumChildren() == 2) << "Expecting exactly 2 children!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
   Trace("cnf") << "handleImplies(" << impliesNode << ")\n";
+  TimerStat::CodeTimer codeTimer(d_stats.d_impliesTime);
 
   // Convert the children to cnf
   SatLiteral a = getLiteral(impliesNode[0]);
@@ -398,22 +450,28 @@ void CnfStream::handleImplies(TNode impliesNode)
 
   // lit -> (a->b)
   // ~lit | ~ a | b
-  assertClause(impliesNode.negate(), ~impliesLit, ~a, b);
+  if (polarity & POLARITY_POS)
+  {
+    assertClause(impliesNode.negate(), ~impliesLit, ~a, b);
+  }
 
   // (a->b) -> lit
   // ~(~a | b) | lit
   // (a | l) & (~b | l)
-  assertClause(impliesNode, a, impliesLit);
-  assertClause(impliesNode, ~b, impliesLit);
+  if (polarity & POLARITY_NEG)
+  {
+    assertClause(impliesNode, a, impliesLit);
+    assertClause(impliesNode, ~b, impliesLit);
+  }
 }
 
-void CnfStream::handleIff(TNode iffNode)
+void CnfStream::handleIff(TNode iffNode, uint8_t polarity)
 {
-  Assert(!hasLiteral(iffNode)) << "Atom already mapped!";
   Assert(iffNode.getKind() == kind::EQUAL) << "Expecting an EQUAL expression!";
   Assert(iffNode.getNumChildren() == 2) << "Expecting exactly 2 children!";
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
   Trace("cnf") << "handleIff(" << iffNode << ")\n";
+  TimerStat::CodeTimer codeTimer(d_stats.d_iffTime);
 
   // Convert the children to CNF
   SatLiteral a = getLiteral(iffNode[0]);
@@ -425,26 +483,32 @@ void CnfStream::handleIff(TNode iffNode)
   // lit -> ((a-> b) & (b->a))
   // ~lit | ((~a | b) & (~b | a))
   // (~a | b | ~lit) & (~b | a | ~lit)
-  assertClause(iffNode.negate(), ~a, b, ~iffLit);
-  assertClause(iffNode.negate(), a, ~b, ~iffLit);
+  if (polarity & POLARITY_POS)
+  {
+    assertClause(iffNode.negate(), ~a, b, ~iffLit);
+    assertClause(iffNode.negate(), a, ~b, ~iffLit);
+  }
 
   // (a<->b) -> lit
   // ~((a & b) | (~a & ~b)) | lit
   // (~(a & b)) & (~(~a & ~b)) | lit
   // ((~a | ~b) & (a | b)) | lit
   // (~a | ~b | lit) & (a | b | lit)
-  assertClause(iffNode, ~a, ~b, iffLit);
-  assertClause(iffNode, a, b, iffLit);
+  if (polarity & POLARITY_NEG)
+  {
+    assertClause(iffNode, ~a, ~b, iffLit);
+    assertClause(iffNode, a, b, iffLit);
+  }
 }
 
-void CnfStream::handleIte(TNode iteNode)
+void CnfStream::handleIte(TNode iteNode, uint8_t polarity)
 {
-  Assert(!hasLiteral(iteNode)) << "Atom already mapped!";
   Assert(iteNode.getKind() == kind::ITE);
   Assert(iteNode.getNumChildren() == 3);
   Assert(!d_removable) << "Removable clauses can not contain Boolean structure";
   Trace("cnf") << "handleIte(" << iteNode[0] << " " << iteNode[1] << " "
                << iteNode[2] << ")\n";
+  TimerStat::CodeTimer codeTimer(d_stats.d_iteTime);
 
   SatLiteral condLit = getLiteral(iteNode[0]);
   SatLiteral thenLit = getLiteral(iteNode[1]);
@@ -458,9 +522,12 @@ void CnfStream::handleIte(TNode iteNode)
   // lit -> (t | e) & (b -> t) & (!b -> e)
   // lit -> (t | e) & (!b | t) & (b | e)
   // (!lit | t | e) & (!lit | !b | t) & (!lit | b | e)
-  assertClause(iteNode.negate(), ~iteLit, thenLit, elseLit);
-  assertClause(iteNode.negate(), ~iteLit, ~condLit, thenLit);
-  assertClause(iteNode.negate(), ~iteLit, condLit, elseLit);
+  if (polarity & POLARITY_POS)
+  {
+    assertClause(iteNode.negate(), ~iteLit, thenLit, elseLit);
+    assertClause(iteNode.negate(), ~iteLit, ~condLit, thenLit);
+    assertClause(iteNode.negate(), ~iteLit, condLit, elseLit);
+  }
 
   // If ITE is false then one of the branches is false and the condition
   // implies which one
@@ -468,9 +535,12 @@ void CnfStream::handleIte(TNode iteNode)
   // !lit -> (!t | !e) & (b -> !t) & (!b -> !e)
   // !lit -> (!t | !e) & (!b | !t) & (b | !e)
   // (lit | !t | !e) & (lit | !b | !t) & (lit | b | !e)
-  assertClause(iteNode, iteLit, ~thenLit, ~elseLit);
-  assertClause(iteNode, iteLit, ~condLit, ~thenLit);
-  assertClause(iteNode, iteLit, condLit, ~elseLit);
+  if (polarity & POLARITY_NEG)
+  {
+    assertClause(iteNode, iteLit, ~thenLit, ~elseLit);
+    assertClause(iteNode, iteLit, ~condLit, ~thenLit);
+    assertClause(iteNode, iteLit, condLit, ~elseLit);
+  }
 }
 
 SatLiteral CnfStream::toCNF(TNode node, bool negated)
@@ -478,84 +548,124 @@ SatLiteral CnfStream::toCNF(TNode node, bool negated)
   Trace("cnf") << "toCNF(" << node
                << ", negated = " << (negated ? "true" : "false") << ")\n";
 
-  TNode cur;
-  SatLiteral nodeLit;
-  std::vector<TNode> visit;
-  std::unordered_map<TNode, bool> cache;
+  // the returned literal occurs positively in a clause, so it needs to imply
+  // the (negated) node
+  uint8_t polarity = POLARITY_BOTH;
+  if (d_pgEncoding)
+  {
+    polarity = negated ? POLARITY_NEG : POLARITY_POS;
+  }
+  encode(node, polarity);
+
+  SatLiteral nodeLit = getLiteral(node);
+  Trace("cnf") << "toCNF(): resulting literal: "
+               << (!negated ? nodeLit : ~nodeLit) << "\n";
+  return negated ? ~nodeLit : nodeLit;
+}
+
+SatLiteral CnfStream::toCNF(TNode node, Polarity polarity)
+{
+  Trace("cnf") << "toCNF(" << node << ", polarity = " << int(polarity)
+               << ")\n";
+  encode(node, d_pgEncoding ? polarity : POLARITY_BOTH);
+  return getLiteral(node);
+}
 
-  visit.push_back(node);
+void CnfStream::encode(TNode node, uint8_t polarity)
+{
+  // formulas paired with the polarity in which they need to be encoded
+  std::vector<std::pair<TNode, uint8_t>> visit;
+  // the polarities for which the children of a formula have been visited
+  std::unordered_map<TNode, uint8_t> visited;
+
+  visit.emplace_back(node, polarity);
   while (!visit.empty())
   {
-    cur = visit.back();
+    TNode cur = visit.back().first;
+    uint8_t pol = visit.back().second;
     Assert(cur.getType().isBoolean());
 
-    if (hasLiteral(cur))
+    Kind k = cur.getKind();
+    if (k == kind::NOT)
+    {
+      // the literal of a negation is the negated literal of its child
+      visit.back() = std::make_pair(cur[0], flipPolarity(pol));
+      continue;
+    }
+    uint8_t missing = pol & ~getEncodedPolarity(cur);
+    if (missing == POLARITY_NONE)
+    {
+      visit.pop_back();
+      continue;
+    }
+    // Only traverse Boolean nodes
+    if (k != kind::XOR && k != kind::ITE && k != kind::IMPLIES
+        && k != kind::OR && k != kind::AND
+        && (k != kind::EQUAL || !cur[0].getType().isBoolean()))
     {
+      convertAtom(cur);
       visit.pop_back();
       continue;
     }
 
-    const auto& it = cache.find(cur);
-    if (it == cache.end())
+    uint8_t& curVisited = visited[cur];
+    uint8_t toVisit = missing & ~curVisited;
+    if (toVisit != POLARITY_NONE)
     {
-      cache.emplace(cur, false);
-      Kind k = cur.getKind();
-      // Only traverse Boolean nodes
-      if (k == kind::NOT || k == kind::XOR || k == kind::ITE
-          || k == kind::IMPLIES || k == kind::OR || k == kind::AND
-          || (k == kind::EQUAL && cur[0].getType().isBoolean()))
+      curVisited |= toVisit;
+      // Preserve the order of the recursive version
+      for (size_t i = 0, size = cur.getNumChildren(); i < size; ++i)
       {
-        // Preserve the order of the recursive version
-        for (size_t i = 0, size = cur.getNumChildren(); i < size; ++i)
+        size_t j = size - 1 - i;
+        uint8_t childPol = toVisit;
+        if (k == kind::XOR || k == kind::EQUAL || (k == kind::ITE && j == 0))
         {
-          visit.push_back(cur[size - 1 - i]);
+          childPol = POLARITY_BOTH;
         }
+        else if (k == kind::IMPLIES && j == 0)
+        {
+          childPol = flipPolarity(toVisit);
+        }
+        visit.emplace_back(cur[j], childPol);
       }
       continue;
     }
-    else if (!it->second)
+    visit.pop_back();
+
+    uint8_t encoded = getEncodedPolarity(cur) | missing;
+    switch (k)
     {
-      it->second = true;
-      Kind k = cur.getKind();
-      switch (k)
-      {
-        case kind::NOT: Assert(hasLiteral(cur[0])); break;
-        case kind::XOR: handleXor(cur); break;
-        case kind::ITE: handleIte(cur); break;
-        case kind::IMPLIES: handleImplies(cur); break;
-        case kind::OR: handleOr(cur); break;
-        case kind::AND: handleAnd(cur); break;
-        default:
-          if (k == kind::EQUAL && cur[0].getType().isBoolean())
-          {
-            handleIff(cur);
-          }
-          else
-          {
-            convertAtom(cur);
-          }
-          break;
-      }
+      case kind::XOR: handleXor(cur, missing); break;
+      case kind::ITE: handleIte(cur, missing); break;
+      case kind::IMPLIES: handleImplies(cur, missing); break;
+      case kind::OR: handleOr(cur, missing); break;
+      case kind::AND: handleAnd(cur, missing); break;
+      default:
+        Assert(k == kind::EQUAL);
+        handleIff(cur, missing);
+        break;
+    }
+    if (d_pgEncoding
+        && (encoded != POLARITY_BOTH
+            || d_partialPolarity.find(cur) != d_partialPolarity.end()))
+    {
+      d_partialPolarity.insert(cur, encoded);
     }
-    visit.pop_back();
   }
-
-  nodeLit = getLiteral(node);
-  Trace("cnf") << "toCNF(): resulting literal: "
-               << (!negated ? nodeLit : ~nodeLit) << "\n";
-  return negated ? ~nodeLit : nodeLit;
 }
 
-void CnfStream::convertAndAssertAnd(TNode node, bool negated)
+void CnfStream::convertAndAssertAnd(
+    TNode node, bool negated, std::vector<std::pair<TNode, bool>>& pending)
 {
   Assert(node.getKind() == kind::AND);
   Trace("cnf") << "CnfStream::convertAndAssertAnd(" << node
                << ", negated = " << (negated ? "true" : "false") << ")\n";
   if (!negated) {
     // If the node is a conjunction, we handle each conjunct separately
-    for(TNode::const_iterator conjunct = node.begin(), node_end = node.end();
-        conjunct != node_end; ++conjunct ) {
-      convertAndAssert(*conjunct, false);
+    // (pending is a stack, so push them in reverse order)
+    for (size_t i = node.getNumChildren(); i > 0; --i)
+    {
+      pending.emplace_back(node[i - 1], false);
     }
   } else {
     // If the node is a disjunction, we construct a clause and assert it
@@ -571,7 +681,8 @@ void CnfStream::convertAndAssertAnd(TNode node, bool negated)
   }
 }
 
-void CnfStream::convertAndAssertOr(TNode node, bool negated)
+void CnfStream::convertAndAssertOr(
+    TNode node, bool negated, std::vector<std::pair<TNode, bool>>& pending)
 {
   Assert(node.getKind() == kind::OR);
   Trace("cnf") << "CnfStream::convertAndAssertOr(" << node
@@ -589,9 +700,9 @@ void CnfStream::convertAndAssertOr(TNode node, bool negated)
     assertClause(node, clause);
   } else {
     // If the node is a conjunction, we handle each conjunct separately
-    for(TNode::const_iterator conjunct = node.begin(), node_end = node.end();
-        conjunct != node_end; ++conjunct ) {
-      convertAndAssert(*conjunct, true);
+    for (size_t i = node.getNumChildren(); i > 0; --i)
+    {
+      pending.emplace_back(node[i - 1], true);
     }
   }
 }
@@ -603,8 +714,8 @@ void CnfStream::convertAndAssertXor(TNode node, bool negated)
                << ", negated = " << (negated ? "true" : "false") << ")\n";
   if (!negated) {
     // p XOR q
-    SatLiteral p = toCNF(node[0], false);
-    SatLiteral q = toCNF(node[1], false);
+    SatLiteral p = toCNF(node[0], POLARITY_BOTH);
+    SatLiteral q = toCNF(node[1], POLARITY_BOTH);
     // Construct the clauses (p => !q) and (!q => p)
     SatClause clause1(2);
     clause1[0] = ~p;
@@ -616,8 +727,8 @@ void CnfStream::convertAndAssertXor(TNode node, bool negated)
     assertClause(node, clause2);
   } else {
     // !(p XOR q) is the same as p <=> q
-    SatLiteral p = toCNF(node[0], false);
-    SatLiteral q = toCNF(node[1], false);
+    SatLiteral p = toCNF(node[0], POLARITY_BOTH);
+    SatLiteral q = toCNF(node[1], POLARITY_BOTH);
     // Construct the clauses (p => q) and (q => p)
     SatClause clause1(2);
     clause1[0] = ~p;
@@ -637,8 +748,8 @@ void CnfStream::convertAndAssertIff(TNode node, bool negated)
                << ", negated = " << (negated ? "true" : "false") << ")\n";
   if (!negated) {
     // p <=> q
-    SatLiteral p = toCNF(node[0], false);
-    SatLiteral q = toCNF(node[1], false);
+    SatLiteral p = toCNF(node[0], POLARITY_BOTH);
+    SatLiteral q = toCNF(node[1], POLARITY_BOTH);
     // Construct the clauses (p => q) and (q => p)
     SatClause clause1(2);
     clause1[0] = ~p;
@@ -650,8 +761,8 @@ void CnfStream::convertAndAssertIff(TNode node, bool negated)
     assertClause(node, clause2);
   } else {
     // !(p <=> q) is the same as p XOR q
-    SatLiteral p = toCNF(node[0], false);
-    SatLiteral q = toCNF(node[1], false);
+    SatLiteral p = toCNF(node[0], POLARITY_BOTH);
+    SatLiteral q = toCNF(node[1], POLARITY_BOTH);
     // Construct the clauses (p => !q) and (!q => p)
     SatClause clause1(2);
     clause1[0] = ~p;
@@ -664,14 +775,15 @@ void CnfStream::convertAndAssertIff(TNode node, bool negated)
   }
 }
 
-void CnfStream::convertAndAssertImplies(TNode node, bool negated)
+void CnfStream::convertAndAssertImplies(
+    TNode node, bool negated, std::vector<std::pair<TNode, bool>>& pending)
 {
   Assert(node.getKind() == kind::IMPLIES);
   Trace("cnf") << "CnfStream::convertAndAssertImplies(" << node
                << ", negated = " << (negated ? "true" : "false") << ")\n";
   if (!negated) {
-    // p => q
-    SatLiteral p = toCNF(node[0], false);
+    // p => q, p only occurs negated
+    SatLiteral p = toCNF(node[0], POLARITY_NEG);
     SatLiteral q = toCNF(node[1], false);
     // Construct the clause ~p || q
     SatClause clause(2);
@@ -680,8 +792,8 @@ void CnfStream::convertAndAssertImplies(TNode node, bool negated)
     assertClause(node, clause);
   } else {// Construct the
     // !(p => q) is the same as (p && ~q)
-    convertAndAssert(node[0], false);
-    convertAndAssert(node[1], true);
+    pending.emplace_back(node[1], true);
+    pending.emplace_back(node[0], false);
   }
 }
 
@@ -690,8 +802,8 @@ void CnfStream::convertAndAssertIte(TNode node, bool negated)
   Assert(node.getKind() == kind::ITE);
   Trace("cnf") << "CnfStream::convertAndAssertIte(" << node
                << ", negated = " << (negated ? "true" : "false") << ")\n";
-  // ITE(p, q, r)
-  SatLiteral p = toCNF(node[0], false);
+  // ITE(p, q, r), p occurs in both polarities
+  SatLiteral p = toCNF(node[0], POLARITY_BOTH);
   SatLiteral q = toCNF(node[1], negated);
   SatLiteral r = toCNF(node[2], negated);
   // Construct the clauses:
@@ -731,42 +843,71 @@ void CnfStream::convertAndAssert(TNode node,
 
 void CnfStream::convertAndAssert(TNode node, bool negated)
 {
-  Trace("cnf") << "convertAndAssert(" << node
-               << ", negated = " << (negated ? "true" : "false") << ")\n";
+  // the formulas that remain to be asserted, paired with whether they are
+  // negated
+  std::vector<std::pair<TNode, bool>> pending;
+  pending.emplace_back(node, negated);
+  while (!pending.empty())
+  {
+    node = pending.back().first;
+    negated = pending.back().second;
+    pending.pop_back();
+    Trace("cnf") << "convertAndAssert(" << node
+                 << ", negated = " << (negated ? "true" : "false") << ")\n";
 
-  d_resourceManager->spendResource(Resource::CnfStep);
-
-  switch(node.getKind()) {
-    case kind::AND: convertAndAssertAnd(node, negated); break;
-    case kind::OR: convertAndAssertOr(node, negated); break;
-    case kind::XOR: convertAndAssertXor(node, negated); break;
-    case kind::IMPLIES: convertAndAssertImplies(node, negated); break;
-    case kind::ITE: convertAndAssertIte(node, negated); break;
-    case kind::NOT: convertAndAssert(node[0], !negated); break;
-    case kind::EQUAL:
-      if (node[0].getType().isBoolean())
-      {
-        convertAndAssertIff(node, negated);
-        break;
-      }
-      CVC5_FALLTHROUGH;
-    default:
+    d_resourceManager->spendResource(Resource::CnfStep);
+
+    switch (node.getKind())
     {
-      Node nnode = node;
-      if (negated)
+      case kind::AND: convertAndAssertAnd(node, negated, pending); break;
+      case kind::OR: convertAndAssertOr(node, negated, pending); break;
+      case kind::XOR: convertAndAssertXor(node, negated); break;
+      case kind::IMPLIES:
+        convertAndAssertImplies(node, negated, pending);
+        break;
+      case kind::ITE: convertAndAssertIte(node, negated); break;
+      case kind::NOT: pending.emplace_back(node[0], !negated); break;
+      case kind::EQUAL:
+        if (node[0].getType().isBoolean())
+        {
+          convertAndAssertIff(node, negated);
+          break;
+        }
+        CVC5_FALLTHROUGH;
+      default:
       {
-        nnode = node.negate();
+        Node nnode = node;
+        if (negated)
+        {
+          nnode = node.negate();
+        }
+        // Atoms
+        assertClause(nnode, toCNF(node, negated));
       }
-      // Atoms
-      assertClause(nnode, toCNF(node, negated));
-  }
-    break;
+      break;
+    }
   }
 }
 
 CnfStream::Statistics::Statistics(const std::string& name)
     : d_cnfConversionTime(smtStatisticsRegistry().registerTimer(
-        name + "::CnfStream::cnfConversionTime"))
+        name + "::CnfStream::cnfConversionTime")),
+      d_andTime(smtStatisticsRegistry().registerTimer(
+          name + "::CnfStream::cnfConversionTime::and")),
+      d_orTime(smtStatisticsRegistry().registerTimer(
+          name + "::CnfStream::cnfConversionTime::or")),
+      d_xorTime(smtStatisticsRegistry().registerTimer(
+          name + "::CnfStream::cnfConversionTime::xor")),
+      d_impliesTime(smtStatisticsRegistry().registerTimer(
+          name + "::CnfStream::cnfConversionTime::implies")),
+      d_iffTime(smtStatisticsRegistry().registerTimer(
+          name + "::CnfStream::cnfConversionTime::iff")),
+      d_iteTime(smtStatisticsRegistry().registerTimer(
+          name + "::CnfStream::cnfConversionTime::ite")),
+      d_atomTime(smtStatisticsRegistry().registerTimer(
+          name + "::CnfStream::cnfConversionTime::atom")),
+      d_numClauses(smtStatisticsRegistry().registerInt(
+          name + "::CnfStream::numClauses"))
 {
 }
 
@@ -26,8 +26,9 @@
 #ifndef CVC5__PROP__CNF_STREAM_H
 #define CVC5__PROP__CNF_STREAM_H
 
+#include "context/cdflat_hashmap.h"
+#include "context/cdhashmap.h"
 #include "context/cdhashset.h"
-#include "context/cdinsert_hashmap.h"
 #include "context/cdlist.h"
 #include "expr/node.h"
 #include "prop/proof_cnf_stream.h"
@@ -63,18 +64,31 @@ enum class FormulaLitPolicy : uint32_t
  * The general idea is to introduce a new literal that will be equivalent to
  * each subexpression in the constructed equi-satisfiable formula, then
  * substitute the new literal for the formula, and so on, recursively.
+ *
+ * The traversals use explicit worklists instead of recursion, so that deeply
+ * nested formulas do not exhaust the stack.
+ *
+ * If the option cnfPolarity is enabled, only the direction of the definition
+ * of a Tseitin literal that is required by the polarity of its subformula is
+ * encoded (Plaisted-Greenbaum encoding). The missing direction is added once
+ * the subformula occurs with the other polarity, e.g. in a later lemma, or
+ * once a literal definitionally equal to it is requested by ensureLiteral().
  */
 class CnfStream {
   friend PropEngine;
   friend ProofCnfStream;
 
  public:
-  /** Cache of what nodes have been registered to a literal. */
-  typedef context::CDInsertHashMap<SatLiteral, TNode, SatLiteralHashFunction>
+  /**
+   * Cache of what nodes have been registered to a literal. Both caches are
+   * insert-only and grow with every atom and Tseitin variable, so they use
+   * the flat map rather than CDInsertHashMap to save memory.
+   */
+  typedef context::CDFlatHashMap<SatLiteral, TNode, SatLiteralHashFunction>
       LiteralToNodeMap;
 
   /** Cache of what literals have been registered to a node. */
-  typedef context::CDInsertHashMap<Node, SatLiteral> NodeToLiteralMap;
+  typedef context::CDFlatHashMap<Node, SatLiteral> NodeToLiteralMap;
 
   /**
    * Constructs a CnfStream that performs equisatisfiable CNF transformations
@@ -169,14 +183,42 @@ class CnfStream {
    * dedicated converter for the possible formula kinds.
    */
   void convertAndAssert(TNode node, bool negated);
-  /** Specific converters for each formula kind. */
-  void convertAndAssertAnd(TNode node, bool negated);
-  void convertAndAssertOr(TNode node, bool negated);
+  /**
+   * Specific converters for each formula kind. The converters for AND, OR and
+   * IMPLIES add the subformulas that must be asserted separately to pending
+   * rather than converting them recursively.
+   */
+  void convertAndAssertAnd(TNode node,
+                           bool negated,
+                           std::vector<std::pair<TNode, bool>>& pending);
+  void convertAndAssertOr(TNode node,
+                          bool negated,
+                          std::vector<std::pair<TNode, bool>>& pending);
   void convertAndAssertXor(TNode node, bool negated);
   void convertAndAssertIff(TNode node, bool negated);
-  void convertAndAssertImplies(TNode node, bool negated);
+  void convertAndAssertImplies(TNode node,
+                               bool negated,
+                               std::vector<std::pair<TNode, bool>>& pending);
   void convertAndAssertIte(TNode node, bool negated);
 
+  /**
+   * The directions of the definition of the Tseitin literal lit of a formula
+   * f that are encoded in clauses, as a bit mask.
+   */
+  enum Polarity : uint8_t
+  {
+    POLARITY_NONE = 0,
+    /** lit -> f, needed if f occurs positively */
+    POLARITY_POS = 1,
+    /** f -> lit, needed if f occurs negatively */
+    POLARITY_NEG = 2,
+    POLARITY_BOTH = 3
+  };
+  /** Returns the polarity of the negation of a formula of polarity p. */
+  static uint8_t flipPolarity(uint8_t p);
+  /** Returns the directions of the definition of node that are encoded. */
+  uint8_t getEncodedPolarity(TNode node) const;
+
   /**
    * Transforms the node into CNF recursively and yields a literal
    * definitionally equal to it.
@@ -185,22 +227,43 @@ class CnfStream {
    * and literals to avoid redundant work and to retrieve formulas from literals
    * and vice-versa.
    *
+   * If cnfPolarity is enabled, the returned literal may only be used
+   * positively in clauses, i.e., it implies the (negated) formula but is not
+   * necessarily implied by it. Literals that are used negated or in both
+   * polarities must be obtained by the overload below.
+   *
    * @param node the formula to transform
    * @param negated whether the literal is negated
    * @return the literal representing the root of the formula
    */
   SatLiteral toCNF(TNode node, bool negated = false);
+  /**
+   * Same as above, but the literal of node is returned and may be used in
+   * clauses in the given polarity: POLARITY_POS if it is used positively,
+   * POLARITY_NEG if it is used negated, POLARITY_BOTH if it is used both
+   * ways. The definition of the literal is encoded in the directions this
+   * requires.
+   */
+  SatLiteral toCNF(TNode node, Polarity polarity);
+
+  /**
+   * Introduces a literal for node and the subformulas of node, and encodes
+   * the directions of their definitions given by polarity and the polarities
+   * of the subformulas in node, unless they are already encoded.
+   */
+  void encode(TNode node, uint8_t polarity);
 
   /**
    * Specific clausifiers that clausify a formula based on the given formula
-   * kind and introduce a literal definitionally equal to it.
+   * kind and introduce a literal for it (unless it already has one), whose
+   * definition is encoded in the directions given by polarity.
    */
-  void handleXor(TNode node);
-  void handleImplies(TNode node);
-  void handleIff(TNode node);
-  void handleIte(TNode node);
-  void handleAnd(TNode node);
-  void handleOr(TNode node);
+  void handleXor(TNode node, uint8_t polarity);
+  void handleImplies(TNode node, uint8_t polarity);
+  void handleIff(TNode node, uint8_t polarity);
+  void handleIte(TNode node, uint8_t polarity);
+  void handleAnd(TNode node, uint8_t polarity);
+  void handleOr(TNode node, uint8_t polarity);
 
   /** Stores the literal of the given node in d_literalToNodeMap.
    *
@@ -227,6 +290,16 @@ class CnfStream {
   /** Map from literals to nodes */
   LiteralToNodeMap d_literalToNodeMap;
 
+  /** Whether the Plaisted-Greenbaum encoding is used (option cnfPolarity) */
+  const bool d_pgEncoding;
+
+  /**
+   * The encoded directions of the formulas whose definition is only encoded
+   * in one direction, or that were in that state at some point. Formulas that
+   * have a literal and are not in this map are encoded in both directions.
+   */
+  context::CDHashMap<Node, uint8_t> d_partialPolarity;
+
   /**
    * True if the lit-to-Node map should be kept for all lits, not just
    * theory lits.  This is true if e.g. replay logging is on, which
@@ -315,6 +388,17 @@ class CnfStream {
   {
     Statistics(const std::string& name);
     TimerStat d_cnfConversionTime;
+    /** Time spent in the clausifiers of each connective */
+    TimerStat d_andTime;
+    TimerStat d_orTime;
+    TimerStat d_xorTime;
+    TimerStat d_impliesTime;
+    TimerStat d_iffTime;
+    TimerStat d_iteTime;
+    /** Time spent converting (and preregistering) atoms */
+    TimerStat d_atomTime;
+    /** Number of clauses asserted to the SAT solver */
+    IntStat d_numClauses;
   } d_stats;
 
 }; /* class CnfStream */
@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Streaming output of DRAT proofs of the propositional reasoning of a SAT
+ * solver.
+ */
+
+#include "prop/drat_writer.h"
+
+#include <algorithm>
+
+#include "base/check.h"
+#include "base/exception.h"
+
+namespace cvc5 {
+namespace prop {
+
+namespace {
+
+/**
+ * Width of the numbers in the DIMACS header, which is written as a
+ * placeholder first and overwritten at the end.
+ */
+const int s_headerWidth = 20;
+
+}  // namespace
+
+DratWriter::DratWriter(const std::string& file, bool binary)
+    : d_binary(binary), d_step(Step::INPUT), d_maxVar(0), d_numInputs(0)
+{
+  d_proof.open(file, std::ios::out | std::ios::trunc | std::ios::binary);
+  d_formula.open(file + ".cnf", std::ios::out | std::ios::trunc);
+  if (!d_proof.good() || !d_formula.good())
+  {
+    throw Exception("cannot open DRAT proof file " + file);
+  }
+  d_formula << "p cnf " << std::string(s_headerWidth, ' ') << ' '
+            << std::string(s_headerWidth, ' ') << '\n';
+}
+
+DratWriter::~DratWriter()
+{
+  d_proof.flush();
+  std::string vars = std::to_string(d_maxVar);
+  std::string clauses = std::to_string(d_numInputs);
+  d_formula.seekp(0);
+  d_formula << "p cnf " << vars << std::string(s_headerWidth - vars.size(), ' ')
+            << ' ' << clauses
+            << std::string(s_headerWidth - clauses.size(), ' ');
+  d_formula.flush();
+}
+
+void DratWriter::begin(Step step)
+{
+  d_step = step;
+  switch (step)
+  {
+    case Step::INPUT: ++d_numInputs; break;
+    case Step::ADD:
+      if (d_binary)
+      {
+        d_proof.put('a');
+      }
+      break;
+    case Step::DELETE: d_proof << (d_binary ? "d" : "d "); break;
+  }
+}
+
+void DratWriter::literal(SatLiteral lit)
+{
+  uint64_t var = lit.getSatVariable() + 1;
+  d_maxVar = std::max(d_maxVar, var);
+  if (d_step == Step::INPUT)
+  {
+    d_formula << (lit.isNegated() ? "-" : "") << var << ' ';
+  }
+  else if (d_binary)
+  {
+    writeBinary(2 * var + (lit.isNegated() ? 1 : 0));
+  }
+  else
+  {
+    d_proof << (lit.isNegated() ? "-" : "") << var << ' ';
+  }
+}
+
+void DratWriter::end()
+{
+  if (d_step == Step::INPUT)
+  {
+    d_formula << "0\n";
+  }
+  else if (d_binary)
+  {
+    d_proof.put(0);
+  }
+  else
+  {
+    d_proof << "0\n";
+  }
+}
+
+void DratWriter::writeBinary(uint64_t n)
+{
+  while (n > 127)
+  {
+    d_proof.put(static_cast<char>((n & 127) | 128));
+    n >>= 7;
+  }
+  d_proof.put(static_cast<char>(n));
+}
+
+}  // namespace prop
+}  // namespace cvc5
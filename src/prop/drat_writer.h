@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Streaming output of DRAT proofs of the propositional reasoning of a SAT
+ * solver.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__PROP__DRAT_WRITER_H
+#define CVC5__PROP__DRAT_WRITER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "prop/sat_solver_types.h"
+
+namespace cvc5 {
+namespace prop {
+
+/**
+ * Writes a DRAT proof of the clauses derived by a SAT solver while they are
+ * derived, without keeping any of them in memory.
+ *
+ * The proof is checked against the clauses that the SAT solver takes for
+ * granted, i.e., the clauses of the input, theory lemmas and explanations of
+ * theory propagations. These are written in DIMACS format to a second file,
+ * named like the proof file with the suffix ".cnf", whose header is completed
+ * when the writer is destroyed. Both files can then be checked offline, e.g.,
+ * by drat-trim, which can also turn the proof into an LRAT proof.
+ *
+ * Clauses are written literal by literal, between calls to begin() and end().
+ * SAT variable v is written as DIMACS variable v + 1.
+ */
+class DratWriter
+{
+ public:
+  /** The kinds of clauses that are written. */
+  enum class Step
+  {
+    /** A clause that is taken for granted */
+    INPUT,
+    /** A clause that is implied by the clauses written before */
+    ADD,
+    /** A clause that is no longer used */
+    DELETE
+  };
+
+  /**
+   * @param file The file of the proof
+   * @param binary Whether the proof is written in the binary DRAT format
+   */
+  DratWriter(const std::string& file, bool binary);
+  ~DratWriter();
+
+  /** Starts a clause of the given kind. */
+  void begin(Step step);
+  /** Adds a literal to the current clause. */
+  void literal(SatLiteral lit);
+  /** Ends the current clause. */
+  void end();
+
+ private:
+  /** Writes an unsigned integer in the variable-length binary encoding. */
+  void writeBinary(uint64_t n);
+
+  /** The proof */
+  std::ofstream d_proof;
+  /** The clauses the proof is checked against */
+  std::ofstream d_formula;
+  /** Whether the proof is in binary format */
+  bool d_binary;
+  /** The kind of the current clause */
+  Step d_step;
+  /** The largest DIMACS variable written so far */
+  uint64_t d_maxVar;
+  /** The number of clauses in d_formula */
+  uint64_t d_numInputs;
+};
+
+}  // namespace prop
+}  // namespace cvc5
+
+#endif /* CVC5__PROP__DRAT_WRITER_H */
@@ -165,6 +165,13 @@ Solver::Solver(cvc5::prop::TheoryProxy* proxy,
       random_var_freq(opt_random_var_freq),
       random_seed(opt_random_seed),
       luby_restart(opt_luby_restart),
+      glucose_restart(false),
+      lbd_tiers(false),
+      tier1_lbd(2),
+      tier2_lbd(6),
+      target_phase(false),
+      inprocessing(false),
+      inprocess_interval(10000),
       ccmin_mode(opt_ccmin_mode),
       phase_saving(opt_phase_saving),
       rnd_pol(false),
@@ -199,19 +206,35 @@ Solver::Solver(cvc5::prop::TheoryProxy* proxy,
       clauses_literals(0),
       learnts_literals(0),
       max_literals(0),
-      tot_literals(0)
+      tot_literals(0),
+      blocked_restarts(0),
+      reduce_dbs(0),
+      inprocessings(0),
+      subsumed_clauses(0),
+      strengthened_clauses(0),
+      vivified_clauses(0)
 
       ,
       ok(true),
       cla_inc(1),
       var_inc(1),
       watches(WatcherDeleted(ca)),
+      target_size(0),
+      best_size(0),
       qhead(0),
       simpDB_assigns(-1),
       simpDB_props(0),
       order_heap(VarOrderLt(activity)),
       progress_estimate(0),
-      remove_satisfied(!enableIncremental)
+      remove_satisfied(!enableIncremental),
+      lbd_counter(0),
+      lbd_fast(1.0 / 32),
+      lbd_slow(1.0 / 4096),
+      trail_avg(1.0 / 4096),
+      next_reduce(2000),
+      next_inprocess(0),
+      inprocess_props(0),
+      probing(false)
 
       // Resource constraints:
       //
@@ -240,6 +263,29 @@ Solver::~Solver()
 {
 }
 
+void Solver::enableDrat(const std::string& file, bool binary)
+{
+  Assert(clauses_persistent.size() == 0 && clauses_removable.size() == 0);
+  d_drat.reset(new DratWriter(file, binary));
+  // the constants are asserted without clauses
+  vec<Lit> unit(1);
+  unit[0] = mkLit(varTrue, false);
+  dratClause(DratWriter::Step::INPUT, unit);
+  unit[0] = mkLit(varFalse, true);
+  dratClause(DratWriter::Step::INPUT, unit);
+}
+
+template <class Lits>
+void Solver::dratClause(DratWriter::Step step, const Lits& ps)
+{
+  d_drat->begin(step);
+  for (int i = 0; i < ps.size(); i++)
+  {
+    d_drat->literal(MinisatSatSolver::toSatLiteral(ps[i]));
+  }
+  d_drat->end();
+}
+
 
 //=================================================================================================
 // Minor methods:
@@ -259,10 +305,13 @@ Var Solver::newVar(bool sign, bool dvar, bool isTheoryAtom, bool preRegister, bo
     activity .push(rnd_init_act ? drand(random_seed) * 0.00001 : 0);
     seen     .push(0);
     polarity .push(sign);
+    target_polarity.push(2);
+    best_polarity.push(2);
     decision .push();
     trail    .capacity(v+1);
     // push whether it corresponds to a theory atom
     theory.push(isTheoryAtom);
+    can_erase.push(canErase);
 
     setDecisionVar(v, dvar);
 
@@ -295,8 +344,11 @@ void Solver::resizeVars(int newSize) {
     activity.shrink(shrinkSize);
     seen.shrink(shrinkSize);
     polarity.shrink(shrinkSize);
+    target_polarity.shrink(shrinkSize);
+    best_polarity.shrink(shrinkSize);
     decision.shrink(shrinkSize);
     theory.shrink(shrinkSize);
+    can_erase.shrink(shrinkSize);
   }
 
   if (Debug.isOn("minisat::pop")) {
@@ -341,6 +393,10 @@ CRef Solver::reason(Var x) {
                               explanation_cl);
   vec<Lit> explanation;
   MinisatSatSolver::toMinisatClause(explanation_cl, explanation);
+  if (d_drat)
+  {
+    dratClause(DratWriter::Step::INPUT, explanation);
+  }
 
   Trace("pf::sat") << "Solver::reason: explanation_cl = " << explanation_cl
                    << std::endl;
@@ -421,6 +477,10 @@ bool Solver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
 {
     if (!ok) return false;
 
+    // Clauses added from outside are taken for granted by the proof
+    if (d_drat)
+      dratClause(DratWriter::Step::INPUT, ps);
+
     // Check if clause is satisfied and remove false/duplicate literals:
     sort(ps);
     Lit p; int i, j;
@@ -470,6 +530,8 @@ bool Solver::addClause_(vec<Lit>& ps, bool removable, ClauseId& id)
 
     // Fit to size
     ps.shrink(i - j);
+    if (d_drat && i > j)
+      dratClause(DratWriter::Step::ADD, ps);
 
     // If we are in solve_ or propagate
     if (minisat_busy)
@@ -626,6 +688,8 @@ void Solver::detachClause(CRef cr, bool strict) {
 
 void Solver::removeClause(CRef cr) {
     Clause& c = ca[cr];
+    if (d_drat)
+      dratClause(DratWriter::Step::DELETE, c);
     if (Debug.isOn("minisat"))
     {
       Debug("minisat") << "Solver::removeClause(" << c << "), CRef " << cr
@@ -678,15 +742,13 @@ void Solver::cancelUntil(int level) {
     Debug("minisat") << "minisat::cancelUntil(" << level << ")" << std::endl;
 
     if (decisionLevel() > level){
-        // Pop the SMT context
-        for (int l = trail_lim.size() - level; l > 0; --l) {
-          d_context->pop();
-        }
+        // Pop the SMT context, all levels at once
+        d_context->popto(d_context->getLevel() - (trail_lim.size() - level));
         for (int c = trail.size()-1; c >= trail_lim[level]; c--){
             Var      x  = var(trail[c]);
             assigns [x] = l_Undef;
             vardata[x].d_trail_index = -1;
-            if ((phase_saving > 1 ||
+            if (!probing && (phase_saving > 1 ||
                  ((phase_saving == 1) && c > trail_lim.last())
                  ) && ((polarity[x] & 0x2) == 0)) {
               polarity[x] = sign(trail[c]);
@@ -832,8 +894,14 @@ Lit Solver::pickBranchLit()
       else
       {
         // If it can't use internal heuristic to do that
-        decisionLit = mkLit(
-            next, rnd_pol ? drand(random_seed) < 0.5 : (polarity[next] & 0x1));
+        bool pol = polarity[next] & 0x1;
+        if (target_phase && (polarity[next] & 0x2) == 0
+            && target_polarity[next] != 2)
+        {
+          pol = target_polarity[next];
+        }
+        decisionLit =
+            mkLit(next, rnd_pol ? drand(random_seed) < 0.5 : pol);
       }
 
       // org-mode tracing -- decision engine decision
@@ -903,7 +971,20 @@ int Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel)
         Clause& c = ca[confl];
         max_resolution_level = std::max(max_resolution_level, c.level());
 
-        if (c.removable()) claBumpActivity(c);
+        if (c.removable())
+        {
+          claBumpActivity(c);
+          if (lbd_tiers && c.size() > 2)
+          {
+            // clauses taking part in conflicts survive the next reduction
+            unsigned lbd = computeLbd(c);
+            if (lbd < c.lbd())
+            {
+              c.setLbd(lbd);
+            }
+            c.setUsed(c.lbd() <= (unsigned)tier2_lbd ? 2 : 1);
+          }
+        }
       }
 
         if (Trace.isOn("pf::sat"))
@@ -1167,7 +1248,7 @@ void Solver::uncheckedEnqueue(Lit p, CRef from)
   vardata[var(p)] = VarData(
       from, decisionLevel(), assertionLevel, intro_level(var(p)), trail.size());
   trail.push_(p);
-  if (theory[var(p)])
+  if (theory[var(p)] && !probing)
   {
     // Enqueue to the theory
     d_proxy->enqueueTheoryLiteral(MinisatSatSolver::toSatLiteral(p));
@@ -1260,22 +1341,27 @@ CRef Solver::propagate(TheoryCheckType type)
 }
 
 void Solver::propagateTheory() {
-  SatClause propagatedLiteralsClause;
   // Doesn't actually call propagate(); that's done in theoryCheck() now that combination
   // is online.  This just incorporates those propagations previously discovered.
-  d_proxy->theoryPropagate(propagatedLiteralsClause);
-
-  vec<Lit> propagatedLiterals;
-  MinisatSatSolver::toMinisatClause(propagatedLiteralsClause, propagatedLiterals);
+  // The literals are enqueued with a lazy reason, their explanation is only
+  // computed if needed by conflict analysis.
+  theory_propagated.clear();
+  d_proxy->theoryPropagate(theory_propagated);
 
   int oldTrailSize = trail.size();
-  Debug("minisat") << "old trail size is " << oldTrailSize << ", propagating " << propagatedLiterals.size() << " lits..." << std::endl;
-  for (unsigned i = 0, i_end = propagatedLiterals.size(); i < i_end; ++ i) {
-    Debug("minisat") << "Theory propagated: " << propagatedLiterals[i] << std::endl;
+  Debug("minisat") << "old trail size is " << oldTrailSize << ", propagating " << theory_propagated.size() << " lits..." << std::endl;
+  for (const SatLiteral& lit : theory_propagated) {
+    Lit p = MinisatSatSolver::toMinisatLit(lit);
+    Debug("minisat") << "Theory propagated: " << p << std::endl;
     // multiple theories can propagate the same literal
-    Lit p = propagatedLiterals[i];
     if (value(p) == l_Undef) {
       uncheckedEnqueue(p, CRef_Lazy);
+      if (d_drat && decisionLevel() == 0)
+      {
+        // conflict analysis does not explain literals at level 0, but the
+        // proof checker needs their explanations
+        reason(var(p));
+      }
     } else {
       if (value(p) == l_False) {
         Debug("minisat") << "Conflict in theory propagation" << std::endl;
@@ -1386,6 +1472,231 @@ CRef Solver::propagateBool()
 }
 
 
+/*_________________________________________________________________________________________________
+|
+|  inprocess : ()  ->  [void]
+|
+|  Description:
+|    Simplify the clause database at decision level 0 by subsumption, self-subsuming resolution
+|    and vivification. Only clauses without assigned literals are considered, literals of theory
+|    atoms and of non-erasable variables are never removed, and a clause is only simplified with
+|    clauses that live at least as long in terms of user levels. The assignment is not changed.
+|________________________________________________________________________________________________@*/
+void Solver::inprocess()
+{
+    Assert(decisionLevel() == 0);
+    // the clauses would no longer match their proofs
+    if (needProof() || options::unsatCores())
+        return;
+    inprocessings++;
+    // the preprocessor of SimpSolver already does subsumption while it runs
+    if (!isSimplifying())
+        subsumeClauses();
+    vivifyClauses();
+    inprocess_props = propagations;
+}
+
+bool Solver::canDropLit(Lit p) const
+{
+    return !theory[var(p)] && can_erase[var(p)];
+}
+
+struct subsume_lt {
+    ClauseAllocator& ca;
+    subsume_lt(ClauseAllocator& ca_) : ca(ca_) {}
+    bool operator () (CRef x, CRef y) { return ca[x].size() < ca[y].size(); }
+};
+void Solver::subsumeClauses()
+{
+    // Occurrence lists of the candidate clauses
+    vec<vec<CRef> > occs;
+    occs.growTo(2 * nVars());
+    vec<CRef> cands;
+    for (int i = 0; i < clauses_persistent.size(); i++){
+        CRef cr = clauses_persistent[i];
+        const Clause& c = ca[cr];
+        if (locked(c)) continue;
+        bool assigned = false;
+        for (int k = 0; k < c.size() && !assigned; k++)
+            assigned = value(c[k]) != l_Undef;
+        if (assigned) continue;
+        for (int k = 0; k < c.size(); k++)
+            occs[toInt(c[k])].push(cr);
+        cands.push(cr);
+    }
+    sort(cands, subsume_lt(ca));
+
+    // Shorter clauses first, as they subsume more
+    int64_t steps = 10000000;
+    for (int i = 0; i < cands.size() && steps > 0; i++){
+        CRef cr = cands[i];
+        const Clause& c = ca[cr];
+        if (c.mark() == 1 || c.size() > 32) continue;
+
+        Lit best = c[0];
+        for (int k = 0; k < c.size(); k++){
+            seen[var(c[k])] = sign(c[k]) ? 2 : 1;
+            if (occs[toInt(c[k])].size() + occs[toInt(~c[k])].size()
+                < occs[toInt(best)].size() + occs[toInt(~best)].size())
+                best = c[k];
+        }
+
+        // Every clause subsumed by c, also with one literal of c flipped,
+        // contains best or ~best
+        for (int pol = 0; pol < 2; pol++){
+            const vec<CRef>& os = occs[toInt(pol ? ~best : best)];
+            for (int j = 0; j < os.size(); j++){
+                CRef dr = os[j];
+                Clause& d = ca[dr];
+                if (dr == cr || d.mark() == 1 || d.size() < c.size() || c.level() > d.level())
+                    continue;
+                steps -= d.size();
+                int found = 0, flips = 0;
+                Lit flip = lit_Undef;
+                for (int k = 0; k < d.size(); k++){
+                    char s = seen[var(d[k])];
+                    if (s == 0) continue;
+                    if (s == (sign(d[k]) ? 2 : 1)) found++;
+                    else { flips++; flip = d[k]; }
+                }
+                if (found == c.size()){
+                    removeClause(dr);
+                    subsumed_clauses++;
+                }else if (found == c.size() - 1 && flips == 1 && d.size() > 2 && canDropLit(flip)){
+                    // Self-subsuming resolution: remove ~flip from d
+                    if (d_drat){
+                        vec<Lit> strengthened;
+                        for (int k = 0; k < d.size(); k++)
+                            if (d[k] != flip)
+                                strengthened.push(d[k]);
+                        dratClause(DratWriter::Step::ADD, strengthened);
+                        dratClause(DratWriter::Step::DELETE, d);
+                    }
+                    detachClause(dr, true);
+                    for (int k = 0; k < d.size(); k++)
+                        if (d[k] == flip){
+                            d[k] = d.last();
+                            break; }
+                    d.pop();
+                    attachClause(dr);
+                    strengthened_clauses++;
+                }
+            }
+        }
+
+        for (int k = 0; k < c.size(); k++)
+            seen[var(c[k])] = 0;
+    }
+
+    int i, j;
+    for (i = j = 0; i < clauses_persistent.size(); i++)
+        if (ca[clauses_persistent[i]].mark() != 1)
+            clauses_persistent[j++] = clauses_persistent[i];
+    clauses_persistent.shrink(i - j);
+    checkGarbage();
+}
+
+struct vivify_lt {
+    ClauseAllocator& ca;
+    vivify_lt(ClauseAllocator& ca_) : ca(ca_) {}
+    bool operator () (CRef x, CRef y) { return ca[x].lbd() < ca[y].lbd(); }
+};
+void Solver::vivifyClauses()
+{
+    // Only clauses of the current user level may be derived from all
+    // clauses, and in particular from the ones used by the propagation
+    vec<CRef> cands;
+    for (int i = 0; i < clauses_removable.size(); i++){
+        CRef cr = clauses_removable[i];
+        const Clause& c = ca[cr];
+        if (c.size() <= 2 || c.level() != assertionLevel || locked(c)) continue;
+        bool assigned = false;
+        for (int k = 0; k < c.size() && !assigned; k++)
+            assigned = value(c[k]) != l_Undef;
+        if (!assigned)
+            cands.push(cr);
+    }
+    sort(cands, vivify_lt(ca));
+
+    ScopedBool scoped_probing(probing, true);
+    int64_t budget = propagations + std::max<int64_t>(100000, (propagations - inprocess_props) / 10);
+    vec<Lit> lits, keep;
+    for (int i = 0; i < cands.size() && propagations < budget; i++){
+        CRef cr = cands[i];
+        // The clause must not propagate its own literals
+        detachClause(cr, true);
+        lits.clear();
+        for (int k = 0; k < ca[cr].size(); k++)
+            lits.push(ca[cr][k]);
+        keep.clear();
+        for (int k = 0; k < lits.size(); k++){
+            Lit l = lits[k];
+            if (value(l) == l_True){
+                // implied by the negation of keep
+                keep.push(l);
+                break;
+            }
+            if (value(l) == l_False)
+                // resolved away with the clause that implied ~l
+                continue;
+            keep.push(l);
+            newDecisionLevel();
+            uncheckedEnqueue(~l);
+            if (propagateBool() != CRef_Undef)
+                break;
+        }
+        cancelUntil(0);
+
+        if (keep.size() < lits.size()){
+            for (int k = 0; k < lits.size(); k++)
+                if (!canDropLit(lits[k])){
+                    bool kept = false;
+                    for (int m = 0; m < keep.size() && !kept; m++)
+                        kept = keep[m] == lits[k];
+                    if (!kept)
+                        keep.push(lits[k]);
+                }
+        }
+        Clause& c = ca[cr];
+        if (keep.size() >= 2 && keep.size() < lits.size()){
+            if (d_drat){
+                dratClause(DratWriter::Step::ADD, keep);
+                dratClause(DratWriter::Step::DELETE, lits);
+            }
+            for (int k = 0; k < keep.size(); k++)
+                c[k] = keep[k];
+            c.shrink(lits.size() - keep.size());
+            if (c.lbd() > (unsigned)c.size())
+                c.setLbd(c.size());
+            vivified_clauses++;
+        }
+        attachClause(cr);
+    }
+}
+
+/*_________________________________________________________________________________________________
+|
+|  computeLbd : (lits : const Lits&)  ->  [unsigned]
+|
+|  Description:
+|    Compute the literal block distance of a clause or a vector of literals, i.e., the number of
+|    distinct decision levels of its literals. Literals at level 0 are not counted.
+|________________________________________________________________________________________________@*/
+template <class Lits>
+unsigned Solver::computeLbd(const Lits& lits)
+{
+    lbd_stamp.growTo(decisionLevel() + 1, 0);
+    ++lbd_counter;
+    unsigned lbd = 0;
+    for (int i = 0; i < lits.size(); i++){
+        int l = level(var(lits[i]));
+        if (l > 0 && lbd_stamp[l] != lbd_counter){
+            lbd_stamp[l] = lbd_counter;
+            lbd++; }
+    }
+    return lbd;
+}
+
 /*_________________________________________________________________________________________________
 |
 |  reduceDB : ()  ->  [void]
@@ -1419,6 +1730,51 @@ void Solver::reduceDB()
     checkGarbage();
 }
 
+/*_________________________________________________________________________________________________
+|
+|  reduceDBTiers : ()  ->  [void]
+|
+|  Description:
+|    Reduce the learnt clauses by their LBD. Clauses of LBD up to 'tier1_lbd' (core) are kept
+|    forever, clauses of LBD up to 'tier2_lbd' are kept as long as they take part in conflicts
+|    between reductions, and half of the remaining (local) clauses are removed, preferring
+|    clauses of high LBD and low activity. Binary and locked clauses are never removed.
+|________________________________________________________________________________________________@*/
+struct reduceDBTiers_lt {
+    ClauseAllocator& ca;
+    reduceDBTiers_lt(ClauseAllocator& ca_) : ca(ca_) {}
+    bool operator () (CRef x, CRef y) {
+        return ca[x].lbd() > ca[y].lbd()
+               || (ca[x].lbd() == ca[y].lbd() && ca[x].activity() < ca[y].activity()); }
+};
+void Solver::reduceDBTiers()
+{
+    reduce_dbs++;
+    vec<CRef> local;
+    for (int i = 0; i < clauses_removable.size(); i++){
+        Clause& c = ca[clauses_removable[i]];
+        unsigned used = c.used();
+        if (used > 0)
+            c.setUsed(used - 1);
+        if (c.size() <= 2 || c.lbd() <= (unsigned)tier1_lbd || locked(c))
+            continue;
+        if (c.lbd() <= (unsigned)tier2_lbd && used > 0)
+            continue;
+        if (used == 0)
+            local.push(clauses_removable[i]);
+    }
+    sort(local, reduceDBTiers_lt(ca));
+    for (int i = 0; i < local.size() / 2; i++)
+        removeClause(local[i]);
+
+    int i, j;
+    for (i = j = 0; i < clauses_removable.size(); i++)
+        if (ca[clauses_removable[i]].mark() != 1)
+            clauses_removable[j++] = clauses_removable[i];
+    clauses_removable.shrink(i - j);
+    checkGarbage();
+}
+
 
 void Solver::removeSatisfied(vec<CRef>& cs)
 {
@@ -1493,6 +1849,60 @@ bool Solver::simplify()
 }
 
 
+void Solver::exportLearntClause(const vec<Lit>& learnt, unsigned lbd)
+{
+  cvc5::prop::SatClause clause;
+  for (int i = 0; i < learnt.size(); ++i)
+  {
+    clause.push_back(MinisatSatSolver::toSatLiteral(learnt[i]));
+  }
+  d_proxy->exportClause(clause, lbd);
+}
+
+void Solver::saveTargetPhases()
+{
+  // the assignment below the conflict level is conflict-free
+  int size = trail_lim[decisionLevel() - 1];
+  if (size > target_size)
+  {
+    for (int i = 0; i < size; i++)
+    {
+      target_polarity[var(trail[i])] = sign(trail[i]);
+    }
+    target_size = size;
+  }
+  if (size > best_size)
+  {
+    for (int i = 0; i < size; i++)
+    {
+      best_polarity[var(trail[i])] = sign(trail[i]);
+    }
+    best_size = size;
+  }
+}
+
+void Solver::importSharedClauses()
+{
+  std::vector<cvc5::prop::SatClause> clauses;
+  d_proxy->importClauses(clauses);
+  vec<Lit> ps;
+  for (const cvc5::prop::SatClause& clause : clauses)
+  {
+    ps.clear();
+    bool eliminated = false;
+    for (const cvc5::prop::SatLiteral& lit : clause)
+    {
+      ps.push(MinisatSatSolver::toMinisatLit(lit));
+      eliminated = eliminated || isEliminated(var(ps.last()));
+    }
+    if (!eliminated)
+    {
+      ClauseId id = ClauseIdUndef;
+      addClause(ps, true, id);
+    }
+  }
+}
+
 /*_________________________________________________________________________________________________
 |
 |  search : (nof_conflicts : int) (params : const SearchParams&)  ->  [lbool]
@@ -1513,6 +1923,13 @@ lbool Solver::search(int nof_conflicts)
   int conflictC = 0;
   vec<Lit> learnt_clause;
   starts++;
+  target_size = 0;
+
+  if (d_proxy->isSharingClauses())
+  {
+    // added as lemmas by the first propagation
+    importSharedClauses();
+  }
 
   TheoryCheckType check_type = CHECK_WITH_THEORY;
   for (;;)
@@ -1542,9 +1959,48 @@ lbool Solver::search(int nof_conflicts)
         return l_False;
       }
 
+      if (target_phase)
+      {
+        saveTargetPhases();
+      }
+      if (glucose_restart)
+      {
+        trail_avg.update(trail.size());
+        // block the restart if the assignment is much larger than usual,
+        // the solver may be close to a model
+        if (conflicts > 10000 && lbd_fast.count >= 50
+            && trail.size() > 1.4 * trail_avg.value)
+        {
+          if (conflictC >= restart_first)
+          {
+            blocked_restarts++;
+          }
+          conflictC = 0;
+        }
+      }
+
       // Analyze the conflict
       learnt_clause.clear();
       int max_level = analyze(confl, learnt_clause, backtrack_level);
+      // before backtracking, while the levels of the literals are known
+      unsigned lbd = learnt_clause.size();
+      if (lbd_tiers || glucose_restart || d_proxy->isSharingClauses())
+      {
+        lbd = computeLbd(learnt_clause);
+      }
+      if (glucose_restart)
+      {
+        lbd_fast.update(lbd);
+        lbd_slow.update(lbd);
+      }
+      if (d_proxy->isSharingClauses())
+      {
+        exportLearntClause(learnt_clause, lbd);
+      }
+      if (d_drat)
+      {
+        dratClause(DratWriter::Step::ADD, learnt_clause);
+      }
       cancelUntil(backtrack_level);
 
       // Assert the conflict clause and the asserting literal
@@ -1561,6 +2017,7 @@ lbool Solver::search(int nof_conflicts)
         CRef cr = ca.alloc(assertionLevelOnly() ? assertionLevel : max_level,
                            learnt_clause,
                            true);
+        ca[cr].setLbd(lbd);
         clauses_removable.push(cr);
         attachClause(cr);
         claBumpActivity(ca[cr]);
@@ -1635,8 +2092,11 @@ lbool Solver::search(int nof_conflicts)
         check_type = CHECK_WITH_THEORY;
       }
 
-      if ((nof_conflicts >= 0 && conflictC >= nof_conflicts)
-          || !withinBudget(Resource::SatConflictStep))
+      bool restart = glucose_restart
+                         ? conflictC >= restart_first
+                               && lbd_fast.value > 1.25 * lbd_slow.value
+                         : nof_conflicts >= 0 && conflictC >= nof_conflicts;
+      if (restart || !withinBudget(Resource::SatConflictStep))
       {
         // Reached bound on number of conflicts:
         progress_estimate = progressEstimate();
@@ -1653,7 +2113,22 @@ lbool Solver::search(int nof_conflicts)
         return l_False;
       }
 
-      if (clauses_removable.size() - nAssigns() >= max_learnts)
+      if (decisionLevel() == 0 && inprocessing && conflicts >= next_inprocess)
+      {
+        next_inprocess = conflicts + inprocess_interval;
+        inprocess();
+      }
+
+      if (lbd_tiers)
+      {
+        if (conflicts >= next_reduce)
+        {
+          // Reduce the set of learnt clauses, at increasing intervals:
+          next_reduce = conflicts + 2000 + 300 * reduce_dbs;
+          reduceDBTiers();
+        }
+      }
+      else if (clauses_removable.size() - nAssigns() >= max_learnts)
       {
         // Reduce the set of learnt clauses:
         reduceDB();
@@ -1758,6 +2233,8 @@ lbool Solver::solve_()
     model.clear();
     d_conflict.clear();
     if (!ok){
+      if (d_drat)
+        dratClause(DratWriter::Step::ADD, vec<Lit>());
       minisat_busy = false;
       return l_False;
     }
@@ -1779,8 +2256,15 @@ lbool Solver::solve_()
     // Search:
     int curr_restarts = 0;
     while (status == l_Undef){
+        if (target_phase && curr_restarts > 0 && curr_restarts % 16 == 0){
+            // Rephase: continue from the longest conflict-free assignment
+            for (Var v = 0; v < nVars(); v++)
+                if ((polarity[v] & 0x2) == 0 && best_polarity[v] != 2)
+                    polarity[v] = best_polarity[v];
+            best_size = 0;
+        }
         double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
-        status = search(rest_base * restart_first);
+        status = search(glucose_restart ? -1 : rest_base * restart_first);
         if (!withinBudget(Resource::SatConflictStep))
           break;  // FIXME add restart option?
         curr_restarts++;
@@ -1802,7 +2286,11 @@ lbool Solver::solve_()
         }
     }
     else if (status == l_False && d_conflict.size() == 0)
+    {
       ok = false;
+      if (d_drat)
+        dratClause(DratWriter::Step::ADD, vec<Lit>());
+    }
 
     return status;
 }
@@ -2002,6 +2490,8 @@ void Solver::pop()
                    << ", trail.size is " << trail.size() << "\n";
   // Pop the created variables
   resizeVars(assigns_lim.last());
+  target_size = 0;
+  best_size = 0;
   assigns_lim.pop();
   variables_to_register.clear();
 
@@ -2156,6 +2646,8 @@ void ClauseAllocator::reloc(CRef& cr, ClauseAllocator& to)
   // Copy extra data-fields:
   // (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
   to[cr].mark(c.mark());
+  to[cr].setLbd(c.lbd());
+  to[cr].setUsed(c.used());
   if (to[cr].removable())         to[cr].activity() = c.activity();
   else if (to[cr].has_extra()) to[cr].calcAbstraction();
 }
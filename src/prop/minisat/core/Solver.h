@@ -29,6 +29,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "cvc5_private.h"
 #include "proof/clause_id.h"
 #include "proof/proof_node_manager.h"
+#include "prop/drat_writer.h"
 #include "prop/minisat/core/SolverTypes.h"
 #include "prop/minisat/mtl/Alg.h"
 #include "prop/minisat/mtl/Heap.h"
@@ -146,6 +147,12 @@ public:
  Var trueVar() const { return varTrue; }
  Var falseVar() const { return varFalse; }
 
+ /**
+  * Write a DRAT proof of the derived clauses to file, see DratWriter. Must be
+  * called before any clause is added.
+  */
+ void enableDrat(const std::string& file, bool binary);
+
  /** Retrive the SAT proof manager */
  cvc5::prop::SatProofManager* getProofManager();
 
@@ -274,6 +281,14 @@ public:
  void setDecisionVar(Var v,
                      bool b);  // Declare if a variable should be eligible for
                                // selection in the decision heuristic.
+ virtual bool isEliminated(Var v) const
+ {
+   return false;
+ }  // Whether the variable was eliminated by preprocessing.
+ virtual bool isSimplifying() const
+ {
+   return false;
+ }  // Whether preprocessing maintains occurrences of the problem clauses.
 
  // Read state:
  //
@@ -329,6 +344,16 @@ public:
  double random_var_freq;
  double random_seed;
  bool luby_restart;
+ bool glucose_restart;  // Restart when the recent LBDs exceed their long-term
+                        // average (overrides luby_restart).
+ bool lbd_tiers;    // Reduce the learnt clauses in tiers by LBD rather than
+                    // by activity.
+ int tier1_lbd;     // Learnt clauses up to this LBD are kept forever.
+ int tier2_lbd;     // Learnt clauses up to this LBD are kept while used.
+ bool target_phase;  // Branch on the phases of the longest conflict-free
+                     // assignment since the last restart.
+ bool inprocessing;  // Periodically simplify the clauses at restarts.
+ int64_t inprocess_interval;  // Conflicts between two rounds of inprocessing.
  int ccmin_mode;    // Controls conflict clause minimization (0=none, 1=basic,
                     // 2=deep).
  int phase_saving;  // Controls the level of phase saving (0=none, 1=limited,
@@ -357,6 +382,9 @@ public:
      resources_consumed;
  int64_t dec_vars, clauses_literals, learnts_literals, max_literals,
      tot_literals;
+ int64_t blocked_restarts, reduce_dbs;
+ int64_t inprocessings, subsumed_clauses, strengthened_clauses,
+     vivified_clauses;
 
 protected:
 
@@ -402,6 +430,22 @@ protected:
         bool operator()(const Watcher& w) const { return ca[w.cref].mark() == 1; }
     };
 
+    // Exponential moving average, biased towards the first values.
+    struct Ema
+    {
+      double value;
+      double alpha;
+      int64_t count;
+      Ema(double a) : value(0), alpha(a), count(0) {}
+      void update(double x)
+      {
+        ++count;
+        double a = 1.0 / count > alpha ? 1.0 / count : alpha;
+        value += a * (x - value);
+      }
+      void reset() { value = 0; count = 0; }
+    };
+
     struct VarOrderLt {
         const vec<double>&  activity;
         bool operator () (Var x, Var y) const { return activity[x] > activity[y]; }
@@ -421,6 +465,10 @@ protected:
     vec<lbool>          assigns;            // The current assignments.
     vec<int>            assigns_lim;        // The size by levels of the current assignment
     vec<char>           polarity;           // The preferred polarity of each variable (bit 0) and whether it's locked (bit 1).
+    vec<char>           target_polarity;    // The phase of each variable in the longest conflict-free assignment since the last restart (2 if unset).
+    vec<char>           best_polarity;      // The phase of each variable in the longest conflict-free assignment so far (2 if unset).
+    int                 target_size;        // Size of the assignment stored in 'target_polarity'.
+    int                 best_size;          // Size of the assignment stored in 'best_polarity'.
     vec<char>           decision;           // Declares if a variable is eligible for selection in the decision heuristic.
     vec<int>            flipped;            // Which trail_lim decisions have been flipped in this context.
     vec<Lit>            trail;              // Assignment stack; stores all assigments made in the order they were made.
@@ -445,6 +493,19 @@ protected:
      */
     vec<bool> theory;
 
+    /**
+     * Whether inprocessing may drop the literals of each variable from
+     * clauses. Literals of theory atoms and of variables that the CNF stream
+     * must keep are never dropped.
+     */
+    vec<bool> can_erase;
+
+    /** The writer of the DRAT proof, if any */
+    std::unique_ptr<cvc5::prop::DratWriter> d_drat;
+    /** Write a clause to the DRAT proof */
+    template <class Lits>
+    void dratClause(cvc5::prop::DratWriter::Step step, const Lits& ps);
+
     enum TheoryCheckType {
       // Quick check, but don't perform theory reasoning
       CHECK_WITHOUT_THEORY,
@@ -463,6 +524,18 @@ protected:
     vec<Lit>            analyze_stack;
     vec<Lit>            analyze_toclear;
     vec<Lit>            add_tmp;
+    cvc5::prop::SatClause theory_propagated;
+
+    vec<uint64_t>       lbd_stamp;          // Per decision level, the last LBD computation that saw it.
+    uint64_t            lbd_counter;
+
+    Ema                 lbd_fast;           // Recent LBDs of learnt clauses (glucose restarts).
+    Ema                 lbd_slow;           // Long-term LBDs of learnt clauses (glucose restarts).
+    Ema                 trail_avg;          // Trail sizes at conflicts (restart blocking).
+    int64_t             next_reduce;        // Conflicts before the next tiered reduction.
+    int64_t             next_inprocess;     // Conflicts before the next inprocessing.
+    int64_t             inprocess_props;    // Propagations at the last inprocessing.
+    bool                probing;            // Literals are enqueued by vivification, and not sent to the theories.
 
     double              max_learnts;
     double              learntsize_adjust_confl;
@@ -491,12 +564,22 @@ protected:
     CRef     updateLemmas     ();                                                      // Add the lemmas, backtraking if necessary and return a conflict if there is one
     void     cancelUntil      (int level);                                             // Backtrack until a certain level.
     int      analyze          (CRef confl, vec<Lit>& out_learnt, int& out_btlevel);    // (bt = backtrack)
+    template <class Lits>
+    unsigned computeLbd       (const Lits& lits);                                      // Number of distinct decision levels of a clause or a vec<Lit>.
+    void     exportLearntClause(const vec<Lit>& learnt, unsigned lbd);                // Share a learnt clause with other instances.
+    void     importSharedClauses();                                                    // Add the clauses shared by other instances as lemmas.
     void     analyzeFinal     (Lit p, vec<Lit>& out_conflict);                         // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
     bool     litRedundant     (Lit p, uint32_t abstract_levels);                       // (helper method for 'analyze()') - true if p is redundant
     lbool    search           (int nof_conflicts);                                     // Search for a given number of conflicts.
     lbool    solve_           ();                                                      // Main solve method (assumptions given in 'assumptions').
     void     reduceDB         ();                                                      // Reduce the set of learnt clauses.
+    void     reduceDBTiers    ();                                                      // Reduce the learnt clauses outside of the kept LBD tiers.
+    void     saveTargetPhases ();                                                      // Remember the conflict-free part of the trail at a conflict.
     void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
+    void     inprocess        ();                                                      // Simplify the clauses at level 0, without changing the assignment.
+    void     subsumeClauses   ();                                                      // Subsumption and self-subsuming resolution on the problem clauses.
+    void     vivifyClauses    ();                                                      // Shorten learnt clauses by propagating the negation of their literals.
+    bool     canDropLit       (Lit p) const;                                           // May inprocessing remove 'p' from a clause?
     void     rebuildOrderHeap ();
 
     // Maintaining Variable/Clause activity:
@@ -192,7 +192,9 @@ class Clause {
         unsigned has_extra : 1;
         unsigned reloced   : 1;
         unsigned size      : 27;
-        unsigned level     : 32; }                            header;
+        unsigned level     : 24;
+        unsigned lbd       : 6;
+        unsigned used      : 2; }                             header;
     union { Lit lit; float act; uint32_t abs; CRef rel; } data[0];
 
     friend class ClauseAllocator;
@@ -200,12 +202,17 @@ class Clause {
     // NOTE: This constructor cannot be used directly (doesn't allocate enough memory).
     template<class V>
     Clause(const V& ps, bool use_extra, bool removable, int level) {
+        // the level is stored in 24 bits to make room for the LBD
+        AlwaysAssert(level >= 0 && level < (1 << 24))
+            << "too many user context levels for the SAT solver";
         header.mark      = 0;
         header.removable = removable;
         header.has_extra = use_extra;
         header.reloced   = 0;
         header.size      = ps.size();
         header.level     = level;
+        header.used      = 0;
+        setLbd(ps.size());
 
         for (int i = 0; i < ps.size(); i++) data[i].lit = ps[i];
 
@@ -218,6 +225,9 @@ class Clause {
     }
 
 public:
+    /** The maximal LBD that is stored, larger LBDs are capped */
+    static constexpr unsigned LBD_MAX = 63;
+
     void calcAbstraction() {
       Assert(header.has_extra);
       uint32_t abstraction = 0;
@@ -241,6 +251,16 @@ public:
     void         mark        (uint32_t m)    { header.mark = m; }
     const Lit&   last        ()      const   { return data[header.size-1].lit; }
 
+    // The literal block distance (the number of distinct decision levels of
+    // the literals when the clause was learnt, or when it was last used in
+    // conflict analysis), initially the size of the clause
+    unsigned     lbd         ()      const   { return header.lbd; }
+    void         setLbd      (unsigned l)    { header.lbd = l < LBD_MAX ? l : LBD_MAX; }
+    // Whether the clause was used in conflict analysis recently, counts down
+    // with every reduction of the learnt clauses
+    unsigned     used        ()      const   { return header.used; }
+    void         setUsed     (unsigned u)    { header.used = u; }
+
     bool         reloced     ()      const   { return header.reloced; }
     CRef         relocation  ()      const   { return data[0].rel; }
     void         relocate    (CRef c)        { header.reloced = 1; data[0].rel = c; }
@@ -123,6 +123,19 @@ void MinisatSatSolver::initialize(context::Context* context,
       options::incrementalSolving()
           || options::decisionMode() != options::DecisionMode::INTERNAL);
 
+  if (!options::satDratFile().empty())
+  {
+    if (options::incrementalSolving())
+    {
+      WarningOnce() << "--drat-file is not supported in incremental mode"
+                    << std::endl;
+    }
+    else
+    {
+      d_minisat->enableDrat(options::satDratFile(), options::satDratBinary());
+    }
+  }
+
   d_statistics.init(d_minisat);
 }
 
@@ -146,6 +159,18 @@ void MinisatSatSolver::setupOptions() {
   d_minisat->clause_decay = options::satClauseDecay();
   d_minisat->restart_first = options::satRestartFirst();
   d_minisat->restart_inc = options::satRestartInc();
+  d_minisat->luby_restart =
+      options::satRestartMode() == options::SatRestartMode::LUBY;
+  d_minisat->glucose_restart =
+      options::satRestartMode() == options::SatRestartMode::GLUCOSE;
+  d_minisat->lbd_tiers =
+      options::satClauseDb() == options::SatClauseDbMode::TIERS;
+  d_minisat->tier1_lbd = options::satTier1Lbd();
+  d_minisat->tier2_lbd = options::satTier2Lbd();
+  d_minisat->target_phase =
+      options::satPhase() == options::SatPhaseMode::TARGET;
+  d_minisat->inprocessing = options::satInprocess();
+  d_minisat->inprocess_interval = options::satInprocessInt();
 }
 
 ClauseId MinisatSatSolver::addClause(SatClause& clause, bool removable) {
@@ -311,7 +336,16 @@ MinisatSatSolver::Statistics::Statistics(StatisticsRegistry& registry)
       d_statMaxLiterals(
           registry.registerReference<int64_t>("sat::max_literals")),
       d_statTotLiterals(
-          registry.registerReference<int64_t>("sat::tot_literals"))
+          registry.registerReference<int64_t>("sat::tot_literals")),
+      d_statBlockedRestarts(
+          registry.registerReference<int64_t>("sat::blocked_restarts")),
+      d_statReduceDbs(registry.registerReference<int64_t>("sat::reduce_dbs")),
+      d_statInprocessings(
+          registry.registerReference<int64_t>("sat::inprocessings")),
+      d_statSubsumed(registry.registerReference<int64_t>("sat::subsumed")),
+      d_statStrengthened(
+          registry.registerReference<int64_t>("sat::strengthened")),
+      d_statVivified(registry.registerReference<int64_t>("sat::vivified"))
 {
 }
 
@@ -325,6 +359,12 @@ void MinisatSatSolver::Statistics::init(Minisat::SimpSolver* minisat){
   d_statLearntsLiterals.set(minisat->learnts_literals);
   d_statMaxLiterals.set(minisat->max_literals);
   d_statTotLiterals.set(minisat->tot_literals);
+  d_statBlockedRestarts.set(minisat->blocked_restarts);
+  d_statReduceDbs.set(minisat->reduce_dbs);
+  d_statInprocessings.set(minisat->inprocessings);
+  d_statSubsumed.set(minisat->subsumed_clauses);
+  d_statStrengthened.set(minisat->strengthened_clauses);
+  d_statVivified.set(minisat->vivified_clauses);
 }
 void MinisatSatSolver::Statistics::deinit()
 {
@@ -337,6 +377,12 @@ void MinisatSatSolver::Statistics::deinit()
   d_statLearntsLiterals.reset();
   d_statMaxLiterals.reset();
   d_statTotLiterals.reset();
+  d_statBlockedRestarts.reset();
+  d_statReduceDbs.reset();
+  d_statInprocessings.reset();
+  d_statSubsumed.reset();
+  d_statStrengthened.reset();
+  d_statVivified.reset();
 }
 
 }  // namespace prop
@@ -140,6 +140,9 @@ class MinisatSatSolver : public CDCLTSatSolverInterface
    ReferenceStat<int64_t> d_statConflicts, d_statClausesLiterals;
    ReferenceStat<int64_t> d_statLearntsLiterals, d_statMaxLiterals;
    ReferenceStat<int64_t> d_statTotLiterals;
+   ReferenceStat<int64_t> d_statBlockedRestarts, d_statReduceDbs;
+   ReferenceStat<int64_t> d_statInprocessings, d_statSubsumed;
+   ReferenceStat<int64_t> d_statStrengthened, d_statVivified;
 
   public:
    Statistics(StatisticsRegistry& registry);
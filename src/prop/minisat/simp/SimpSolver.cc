@@ -66,9 +66,11 @@ SimpSolver::SimpSolver(cvc5::prop::TheoryProxy* proxy,
       asymm_lits(0),
       eliminated_vars(0),
       elimorder(1),
-      use_simplification(!enableIncremental && !options::unsatCores()
-                         && !pnm)  // TODO: turn off simplifications if
-                                   // proofs are on initially
+      use_simplification(!enableIncremental && !options::unsatCores() && !pnm
+                         && options::satDratFile().empty())  // TODO: turn off
+                                                             // simplifications
+                                                             // if proofs are on
+                                                             // initially
       ,
       occurs(ClauseDeleted(ca)),
       elim_heap(ElimLt(n_occ)),
@@ -78,7 +78,8 @@ class SimpSolver : public Solver {
   //
   void setFrozen(Var v,
                  bool b);  // If a variable is frozen it will not be eliminated.
-  bool isEliminated(Var v) const;
+  bool isEliminated(Var v) const override;
+  bool isSimplifying() const override { return use_simplification; }
 
   // Solving:
   //
@@ -28,6 +28,7 @@
 #include "options/main_options.h"
 #include "options/options.h"
 #include "options/proof_options.h"
+#include "options/prop_options.h"
 #include "options/smt_options.h"
 #include "prop/cnf_stream.h"
 #include "prop/minisat/minisat.h"
@@ -99,7 +100,16 @@ PropEngine::PropEngine(TheoryEngine* te, Env& env)
     d_decisionEngine.reset(new decision::DecisionEngineEmpty(env));
   }
 
-  d_satSolver = SatSolverFactory::createCDCLTMinisat(smtStatisticsRegistry());
+  if (options::satSolver() == options::CDCLTSatSolverMode::CADICAL)
+  {
+    d_satSolver =
+        SatSolverFactory::createCDCLTCadical(smtStatisticsRegistry());
+  }
+  else
+  {
+    d_satSolver =
+        SatSolverFactory::createCDCLTMinisat(smtStatisticsRegistry());
+  }
 
   // CNF stream and theory proxy required pointers to each other, make the
   // theory proxy first
@@ -128,7 +138,7 @@ PropEngine::PropEngine(TheoryEngine* te, Env& env)
     d_pfCnfStream.reset(new ProofCnfStream(
         userContext,
         *d_cnfStream,
-        static_cast<MinisatSatSolver*>(d_satSolver)->getProofManager(),
+        getSatProofManager(),
         pnm));
     d_ppm.reset(
         new PropPfManager(userContext, pnm, d_satSolver, d_pfCnfStream.get()));
@@ -145,9 +155,7 @@ void PropEngine::finishInit()
   // issue we track it directly here
   if (isProofEnabled())
   {
-    static_cast<MinisatSatSolver*>(d_satSolver)
-        ->getProofManager()
-        ->registerSatAssumptions({nm->mkConst(true)});
+    getSatProofManager()->registerSatAssumptions({nm->mkConst(true)});
   }
   d_cnfStream->convertAndAssert(nm->mkConst(false).notNode(), false, false);
 }
@@ -237,6 +245,12 @@ void PropEngine::assertLemma(TrustNode tlemma, theory::LemmaProperty p)
 
   // now, assert the lemmas
   assertLemmasInternal(tplemma, ppLemmas, removable);
+
+  // lemmas are valid, share them with other instances if they are short
+  if (!tplemma.isNull() && tplemma.getKind() == TrustNodeKind::LEMMA)
+  {
+    d_theoryProxy->exportLemma(tplemma.getProven());
+  }
 }
 
 void PropEngine::assertTrustedLemmaInternal(TrustNode trn, bool removable)
@@ -670,6 +684,14 @@ std::shared_ptr<ProofNode> PropEngine::getProof()
 
 bool PropEngine::isProofEnabled() const { return d_pfCnfStream != nullptr; }
 
+SatProofManager* PropEngine::getSatProofManager()
+{
+  MinisatSatSolver* minisat = dynamic_cast<MinisatSatSolver*>(d_satSolver);
+  AlwaysAssert(minisat != nullptr)
+      << "SAT proofs are only supported with --sat-solver=minisat";
+  return minisat->getProofManager();
+}
+
 void PropEngine::getUnsatCore(std::vector<Node>& core)
 {
   Assert(options::unsatCoresMode() == options::UnsatCoresMode::ASSUMPTIONS);
@@ -43,6 +43,7 @@ namespace prop {
 
 class CnfStream;
 class CDCLTSatSolverInterface;
+class SatProofManager;
 class ProofCnfStream;
 class PropPfManager;
 class TheoryProxy;
@@ -302,6 +303,12 @@ class PropEngine
   std::shared_ptr<ProofNode> getRefutation();
 
  private:
+  /**
+   * Returns the proof manager of the SAT solver. Only the MiniSat CDCL(T) SAT
+   * solver produces proofs, this fails for other SAT solvers.
+   */
+  SatProofManager* getSatProofManager();
+
   /** Dump out the satisfying assignment (after SAT result) */
   void printSatisfyingAssignment();
 
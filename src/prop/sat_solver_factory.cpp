@@ -58,6 +58,19 @@ SatSolver* SatSolverFactory::createCadical(StatisticsRegistry& registry,
   return res;
 }
 
+CDCLTSatSolverInterface* SatSolverFactory::createCDCLTCadical(
+    StatisticsRegistry& registry)
+{
+#ifdef CVC5_CADICAL_EXTERNAL_PROPAGATOR
+  CadicalSolver* res = new CadicalSolver(registry, "");
+  res->init();
+  return res;
+#else
+  Unreachable() << "cvc5 was not compiled with a CaDiCaL version that "
+                   "supports external propagators.";
+#endif
+}
+
 SatSolver* SatSolverFactory::createKissat(StatisticsRegistry& registry,
                                           const std::string& name)
 {
@@ -38,6 +38,9 @@ class SatSolverFactory
 
   static MinisatSatSolver* createCDCLTMinisat(StatisticsRegistry& registry);
 
+  static CDCLTSatSolverInterface* createCDCLTCadical(
+      StatisticsRegistry& registry);
+
   static SatSolver* createCryptoMinisat(StatisticsRegistry& registry,
                                         const std::string& name = "");
 
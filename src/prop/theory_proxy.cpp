@@ -19,8 +19,13 @@
 
 #include "context/context.h"
 #include "decision/decision_engine.h"
+#include "options/base_options.h"
 #include "options/decision_options.h"
+#include "options/prop_options.h"
+#include "options/quantifiers_options.h"
 #include "options/smt_options.h"
+#include "options/uf_options.h"
+#include "prop/clause_sharing.h"
 #include "prop/cnf_stream.h"
 #include "prop/prop_engine.h"
 #include "prop/skolem_def_manager.h"
@@ -46,7 +51,8 @@ TheoryProxy::TheoryProxy(PropEngine* propEngine,
       d_queue(env.getContext()),
       d_tpp(env, *theoryEngine),
       d_skdm(skdm),
-      d_env(env)
+      d_env(env),
+      d_stats(env.getStatisticsRegistry())
 {
 }
 
@@ -54,7 +60,19 @@ TheoryProxy::~TheoryProxy() {
   /* nothing to do for now */
 }
 
-void TheoryProxy::finishInit(CnfStream* cnfStream) { d_cnfStream = cnfStream; }
+void TheoryProxy::finishInit(CnfStream* cnfStream)
+{
+  d_cnfStream = cnfStream;
+  // clause sharing is turned off if it is not sound for both the imported and
+  // the exported clauses (see SetDefaults::incompatibleWithClauseSharing())
+  if (!options::clauseSharingDir().empty())
+  {
+    d_clauseSharing.reset(new ClauseSharing(cnfStream,
+                                            options::clauseSharingDir(),
+                                            options::clauseSharingId(),
+                                            true));
+  }
+}
 
 void TheoryProxy::presolve()
 {
@@ -104,17 +122,26 @@ void TheoryProxy::theoryCheck(theory::Theory::Effort effort) {
 
 void TheoryProxy::theoryPropagate(std::vector<SatLiteral>& output) {
   // Get the propagated literals
-  std::vector<TNode> outputNodes;
-  d_theoryEngine->getPropagatedLiterals(outputNodes);
-  for (unsigned i = 0, i_end = outputNodes.size(); i < i_end; ++ i) {
-    Debug("prop-explain") << "theoryPropagate() => " << outputNodes[i] << std::endl;
-    output.push_back(d_cnfStream->getLiteral(outputNodes[i]));
+  d_propagated.clear();
+  d_theoryEngine->getPropagatedLiterals(d_propagated);
+  if (d_propagated.empty())
+  {
+    return;
+  }
+  ++d_stats.d_numBatches;
+  d_stats.d_numPropagations += d_propagated.size();
+  output.reserve(output.size() + d_propagated.size());
+  for (TNode lit : d_propagated)
+  {
+    Debug("prop-explain") << "theoryPropagate() => " << lit << std::endl;
+    output.push_back(d_cnfStream->getLiteral(lit));
   }
 }
 
 void TheoryProxy::explainPropagation(SatLiteral l, SatClause& explanation) {
   TNode lNode = d_cnfStream->getNode(l);
   Debug("prop-explain") << "explainPropagation(" << lNode << ")" << std::endl;
+  ++d_stats.d_numExplained;
 
   TrustNode tte = d_theoryEngine->getExplanation(lNode);
   Node theoryExplanation = tte.getNode();
@@ -203,6 +230,35 @@ SatValue TheoryProxy::getDecisionPolarity(SatVariable var) {
 
 CnfStream* TheoryProxy::getCnfStream() { return d_cnfStream; }
 
+bool TheoryProxy::isSharingClauses() const
+{
+  return d_clauseSharing != nullptr;
+}
+
+void TheoryProxy::exportClause(const SatClause& clause, uint32_t lbd)
+{
+  if (d_clauseSharing != nullptr)
+  {
+    d_clauseSharing->exportClause(clause, lbd);
+  }
+}
+
+void TheoryProxy::exportLemma(TNode lemma)
+{
+  if (d_clauseSharing != nullptr)
+  {
+    d_clauseSharing->exportLemma(lemma);
+  }
+}
+
+void TheoryProxy::importClauses(std::vector<SatClause>& clauses)
+{
+  if (d_clauseSharing != nullptr)
+  {
+    d_clauseSharing->importClauses(clauses);
+  }
+}
+
 TrustNode TheoryProxy::preprocessLemma(
     TrustNode trn, std::vector<theory::SkolemLemma>& newLemmas)
 {
@@ -237,5 +293,12 @@ void TheoryProxy::getSkolems(TNode node,
 
 void TheoryProxy::preRegister(Node n) { d_theoryEngine->preRegister(n); }
 
+TheoryProxy::Statistics::Statistics(StatisticsRegistry& sr)
+    : d_numBatches(sr.registerInt("prop::TheoryProxy::propagationBatches")),
+      d_numPropagations(sr.registerInt("prop::TheoryProxy::propagations")),
+      d_numExplained(sr.registerInt("prop::TheoryProxy::explainedPropagations"))
+{
+}
+
 }  // namespace prop
 }  // namespace cvc5
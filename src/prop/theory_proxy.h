@@ -22,6 +22,7 @@
 // Optional blocks below will be unconditionally included
 #define CVC5_USE_MINISAT
 
+#include <memory>
 #include <unordered_set>
 
 #include "context/cdqueue.h"
@@ -32,6 +33,7 @@
 #include "theory/theory.h"
 #include "theory/theory_preprocessor.h"
 #include "util/resource_manager.h"
+#include "util/statistics_stats.h"
 
 namespace cvc5 {
 
@@ -46,6 +48,7 @@ namespace prop {
 
 class PropEngine;
 class CnfStream;
+class ClauseSharing;
 class SkolemDefManager;
 
 /**
@@ -78,8 +81,17 @@ class TheoryProxy : public Registrar
 
   void theoryCheck(theory::Theory::Effort effort);
 
+  /**
+   * Get the explanation of the theory propagation of l as a clause whose first
+   * literal is l. Explanations are only computed on demand by the SAT solver,
+   * i.e., during conflict analysis or if a propagation is conflicting.
+   */
   void explainPropagation(SatLiteral l, SatClause& explanation);
 
+  /**
+   * Append the literals propagated by the theories since the last call to
+   * output, without explanations.
+   */
   void theoryPropagate(SatClause& output);
 
   void enqueueTheoryLiteral(const SatLiteral& l);
@@ -138,6 +150,15 @@ class TheoryProxy : public Registrar
   /** Preregister term */
   void preRegister(Node n) override;
 
+  /** Whether clauses are exchanged with other instances */
+  bool isSharingClauses() const;
+  /** Export a learned clause with the given LBD, if sharing clauses */
+  void exportClause(const SatClause& clause, uint32_t lbd);
+  /** Export a lemma, if sharing clauses */
+  void exportLemma(TNode lemma);
+  /** Get the clauses exported by other instances since the last call */
+  void importClauses(std::vector<SatClause>& clauses);
+
  private:
   /** The prop engine we are using. */
   PropEngine* d_propEngine;
@@ -166,6 +187,9 @@ class TheoryProxy : public Registrar
    */
   std::unordered_set<Node> d_shared;
 
+  /** The exchange of clauses with other instances, if any */
+  std::unique_ptr<ClauseSharing> d_clauseSharing;
+
   /** The theory preprocessor */
   theory::TheoryPreprocessor d_tpp;
 
@@ -174,6 +198,22 @@ class TheoryProxy : public Registrar
 
   /** Reference to the environment */
   Env& d_env;
+
+  /** The propagated literals of the current batch, reused across calls */
+  std::vector<TNode> d_propagated;
+
+  /** Statistics on theory propagations */
+  struct Statistics
+  {
+    Statistics(StatisticsRegistry& sr);
+    /** Number of non-empty batches of propagations passed to the SAT solver */
+    IntStat d_numBatches;
+    /** Number of literals propagated by the theories */
+    IntStat d_numPropagations;
+    /** Number of propagations whose explanation was requested */
+    IntStat d_numExplained;
+  };
+  Statistics d_stats;
 }; /* class TheoryProxy */
 
 }  // namespace prop
@@ -181,6 +181,18 @@ void SetDefaults::setDefaultsPre(Options& opts)
     // used by the user to rephrase the input.
     opts.quantifiers.sygusInference = false;
     opts.quantifiers.sygusRewSynthInput = false;
+    // the clauses shared by the other instances are about the input of the
+    // main solver, not the input of the subsolver
+    opts.prop.clauseSharingDir.clear();
+    // only the main solver writes its proof
+    opts.prop.satDratFile.clear();
+  }
+  if (!opts.prop.satDratFile.empty() && !opts.prop.clauseSharingDir.empty())
+  {
+    // imported clauses cannot be checked
+    Notice() << "SolverEngine: turning off clause sharing due to drat-file."
+             << std::endl;
+    opts.prop.clauseSharingDir.clear();
   }
 }
 
@@ -671,6 +683,18 @@ void SetDefaults::setDefaultsPost(const LogicInfo& logic, Options& opts) const
   // set the default decision mode
   setDefaultDecisionMode(logic, opts);
 
+  // The proof CNF stream and the justification heuristic assume that the
+  // definitions of Tseitin literals are encoded in both directions.
+  if (opts.prop.cnfPolarity
+      && (opts.smt.produceProofs || opts.smt.unsatCores
+          || opts.decision.decisionMode != options::DecisionMode::INTERNAL))
+  {
+    Notice() << "SolverEngine: turning off cnf-polarity due to proofs, "
+                "unsat cores or the decision mode."
+             << std::endl;
+    opts.prop.cnfPolarity = false;
+  }
+
   // set up of central equality engine
   if (opts.theory.eeMode == options::EqEngineMode::CENTRAL)
   {
@@ -851,6 +875,18 @@ void SetDefaults::setDefaultsPost(const LogicInfo& logic, Options& opts) const
     }
   }
 #endif
+
+  // Disable clause sharing if it is incompatible with the other options
+  if (!opts.prop.clauseSharingDir.empty())
+  {
+    std::stringstream reasonNoSharing;
+    if (incompatibleWithClauseSharing(opts, reasonNoSharing))
+    {
+      Notice() << "SolverEngine: turning off clause sharing due to "
+               << reasonNoSharing.str() << std::endl;
+      opts.prop.clauseSharingDir.clear();
+    }
+  }
 }
 
 bool SetDefaults::isSygus(const Options& opts) const
@@ -890,6 +926,18 @@ bool SetDefaults::usesSygus(const Options& opts) const
 bool SetDefaults::incompatibleWithProofs(Options& opts,
                                          std::ostream& reason) const
 {
+  if (opts.prop.satSolver == options::CDCLTSatSolverMode::CADICAL)
+  {
+    // SAT proofs are only supported by MiniSat
+    reason << "sat-solver=cadical";
+    return true;
+  }
+  if (!opts.prop.clauseSharingDir.empty())
+  {
+    // imported clauses have no proofs
+    reason << "clause-sharing-dir";
+    return true;
+  }
   if (opts.quantifiers.globalNegate)
   {
     // When global negate answers "unsat", it is not due to showing a set of
@@ -1158,6 +1206,69 @@ bool SetDefaults::incompatibleWithUnsatCores(Options& opts,
   return false;
 }
 
+bool SetDefaults::incompatibleWithClauseSharing(Options& opts,
+                                                std::ostream& reason) const
+{
+  if (opts.base.incrementalSolving)
+  {
+    // the learned clauses may depend on assertions that are popped later
+    reason << "incremental solving";
+    return true;
+  }
+  if (opts.smt.unconstrainedSimp)
+  {
+    if (opts.smt.unconstrainedSimpWasSetByUser)
+    {
+      reason << "unconstrained simplification";
+      return true;
+    }
+    Notice() << "SolverEngine: turning off unconstrained simplification to "
+                "support clause sharing"
+             << std::endl;
+    opts.smt.unconstrainedSimp = false;
+  }
+  if (opts.uf.ufSymmetryBreaker)
+  {
+    if (opts.uf.ufSymmetryBreakerWasSetByUser)
+    {
+      reason << "uf symmetry breaking";
+      return true;
+    }
+    Notice() << "SolverEngine: turning off uf symmetry breaking to support "
+                "clause sharing"
+             << std::endl;
+    opts.uf.ufSymmetryBreaker = false;
+  }
+  if (opts.smt.sortInference)
+  {
+    if (opts.smt.sortInferenceWasSetByUser)
+    {
+      reason << "sort inference";
+      return true;
+    }
+    Notice() << "SolverEngine: turning off sort inference to support clause "
+                "sharing"
+             << std::endl;
+    opts.smt.sortInference = false;
+  }
+  if (opts.quantifiers.globalNegate)
+  {
+    reason << "global-negate";
+    return true;
+  }
+  if (opts.smt.solveIntAsBV > 0)
+  {
+    reason << "solve-int-as-bv";
+    return true;
+  }
+  if (opts.smt.solveRealAsInt)
+  {
+    reason << "solve-real-as-int";
+    return true;
+  }
+  return false;
+}
+
 bool SetDefaults::safeUnsatCores(const Options& opts) const
 {
   // whether we want to force safe unsat cores, i.e., if we are in the default
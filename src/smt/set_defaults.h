@@ -87,6 +87,18 @@ class SetDefaults
    * The output stream reason is similar to above.
    */
   bool incompatibleWithUnsatCores(Options& opts, std::ostream& reason) const;
+  /**
+   * Check if incompatible with clause sharing (see --clause-sharing-dir).
+   * Clauses are exported and imported in terms of the input, which is only
+   * sound if every instance derives its clauses from a preprocessed input
+   * that is equivalent to the input, and keeps them for the rest of the run.
+   * This is the case if no satisfiability preserving preprocessing pass is
+   * enabled and solving is not incremental. Notice this method may modify
+   * the options to ensure that we are compatible with clause sharing. The
+   * output stream reason is similar to above.
+   */
+  bool incompatibleWithClauseSharing(Options& opts,
+                                     std::ostream& reason) const;
   /**
    * Return true if we are using "safe" unsat cores, which disables all
    * techniques that may interfere with producing correct unsat cores.
@@ -91,6 +91,8 @@ void SmtSolver::resetAssertions()
   d_propEngine.reset(nullptr);
   d_propEngine.reset(new prop::PropEngine(d_theoryEngine.get(), d_env));
   d_theoryEngine->setPropEngine(getPropEngine());
+  // the model builder must not keep values for the old assertions
+  d_theoryEngine->notifyResetAssertions();
   // Notice that we do not reset TheoryEngine, nor does it require calling
   // finishInit again. In particular, TheoryEngine::finishInit does not
   // depend on knowing the associated PropEngine.
@@ -116,12 +116,36 @@ SolverEngine::SolverEngine(NodeManager* nm, const Options* optr)
   // hand, this hack breaks use cases where multiple SolverEngine objects are
   // created by the user.
   d_scope.reset(new SolverEngineScope(this));
-  // listen to node manager events
-  getNodeManager()->subscribeEvents(d_snmListener.get());
+  // listen to node manager events, unless the node manager is shared with
+  // other threads, which would notify the listener concurrently to this
+  // solver's own use of its dump manager
+  if (!getNodeManager()->isThreadSafe())
+  {
+    getNodeManager()->subscribeEvents(d_snmListener.get());
+  }
   // listen to resource out
   getResourceManager()->registerListener(d_routListener.get());
   // make statistics
   d_stats.reset(new SolverEngineStatistics());
+  // the allocator of a thread-safe node manager is updated by other threads
+  // under its lock, while statistics are read without it
+  if (!getNodeManager()->isThreadSafe())
+  {
+    const expr::NodeValueAllocator& nva =
+        getNodeManager()->getNodeValueAllocator();
+    d_stats->d_nvSlabsAllocated.set(nva.numSlabsAllocated());
+    d_stats->d_nvSlabsReleased.set(nva.numSlabsReleased());
+    d_stats->d_nvSlabs.set(nva.numSlabs());
+    d_stats->d_nvSlabObjects.set(nva.numSlabObjects());
+    d_stats->d_nvSlabBytesUsed.set(nva.numSlabBytesUsed());
+  }
+  // the SAT context is the one that is pushed and popped most frequently
+  const context::ContextMemoryManager* cmm = getContext()->getCMM();
+  d_stats->d_cmmChunksAllocated.set(cmm->numChunksAllocated());
+  d_stats->d_cmmChunksReleased.set(cmm->numChunksReleased());
+  d_stats->d_cmmChunksReused.set(cmm->numChunksReused());
+  d_stats->d_cmmPeakBytes.set(cmm->peakBytesHeld());
+  d_stats->d_cmmPops.set(cmm->numPops());
   // make the SMT solver
   d_smtSolver.reset(new SmtSolver(*d_env, *d_state, *d_absValues, *d_stats));
   // make the SyGuS solver
@@ -184,11 +208,52 @@ void SolverEngine::finishInit()
   // set the random seed
   Random::getRandom().setSeed(d_env->getOptions().driver.seed);
 
+  if (!d_isInternalSubsolver)
+  {
+    // configure garbage collection of the node manager, which is shared by
+    // all solvers in this thread; the first solver to do so owns the settings
+    NodeManager* nm = getNodeManager();
+    const Options& opts = d_env->getOptions();
+    if (!nm->setZombieReclamation(
+            this, opts.expr.zombieThreshold, opts.expr.zombieReclaimBatch)
+        && (opts.expr.zombieThresholdWasSetByUser
+            || opts.expr.zombieReclaimBatchWasSetByUser))
+    {
+      Warning() << "--zombie-threshold and --zombie-reclaim-batch are ignored "
+                   "since the node manager is configured by another solver"
+                << std::endl;
+    }
+    // a thread-safe node manager may outlive the solvers of other threads
+    if (!nm->isThreadSafe() && nm->getReclaimTimer() == nullptr)
+    {
+      nm->setReclaimTimer(&d_stats->d_reclaimZombiesTime);
+    }
+  }
+
   // Call finish init on the set defaults module. This inializes the logic
   // and the best default options based on our heuristics.
   SetDefaults sdefaults(d_isInternalSubsolver);
   sdefaults.setDefaults(d_env->d_logic, getOptions());
 
+  if (d_env->getOptions().theory.rewriteCacheBudget > 0)
+  {
+    // use rewrite caches private to this solver, bounded in size
+    d_env->getRewriter()->setCacheBudget(
+        d_env->getStatisticsRegistry(),
+        d_env->getOptions().theory.rewriteCacheBudget * 1024 * 1024);
+  }
+  // configure the context memory of the SAT and user contexts
+  for (context::ContextMemoryManager* cmm :
+       {getContext()->getCMM(), getUserContext()->getCMM()})
+  {
+    cmm->setFreeChunkReserve(d_env->getOptions().smt.contextFreeChunks);
+    cmm->setHugePages(d_env->getOptions().smt.contextHugePages);
+  }
+  if (d_env->getOptions().theory.rewriteStats)
+  {
+    d_env->getRewriter()->enableStatistics(d_env->getStatisticsRegistry());
+  }
+
   if (d_env->getOptions().smt.produceProofs)
   {
     // ensure bound variable uses canonical bound variables
@@ -301,8 +366,16 @@ SolverEngine::~SolverEngine()
     d_sygusSolver.reset(nullptr);
     d_smtSolver.reset(nullptr);
 
+    getNodeManager()->releaseZombieReclamation(this);
+    if (getNodeManager()->getReclaimTimer() == &d_stats->d_reclaimZombiesTime)
+    {
+      getNodeManager()->setReclaimTimer(nullptr);
+    }
     d_stats.reset(nullptr);
-    getNodeManager()->unsubscribeEvents(d_snmListener.get());
+    if (!getNodeManager()->isThreadSafe())
+    {
+      getNodeManager()->unsubscribeEvents(d_snmListener.get());
+    }
     d_snmListener.reset(nullptr);
     d_routListener.reset(nullptr);
     // destroy the state
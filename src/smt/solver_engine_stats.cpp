@@ -39,7 +39,29 @@ SolverEngineStatistics::SolverEngineStatistics(const std::string& name)
       d_processAssertionsTime(smtStatisticsRegistry().registerTimer(
           name + "processAssertionsTime")),
       d_simplifiedToFalse(
-          smtStatisticsRegistry().registerInt(name + "simplifiedToFalse"))
+          smtStatisticsRegistry().registerInt(name + "simplifiedToFalse")),
+      d_nvSlabsAllocated(smtStatisticsRegistry().registerReference<uint64_t>(
+          "expr::NodeManager::slabsAllocated")),
+      d_nvSlabsReleased(smtStatisticsRegistry().registerReference<uint64_t>(
+          "expr::NodeManager::slabsReleased")),
+      d_nvSlabs(smtStatisticsRegistry().registerReference<uint64_t>(
+          "expr::NodeManager::slabs")),
+      d_nvSlabObjects(smtStatisticsRegistry().registerReference<uint64_t>(
+          "expr::NodeManager::slabObjects")),
+      d_nvSlabBytesUsed(smtStatisticsRegistry().registerReference<uint64_t>(
+          "expr::NodeManager::slabBytesUsed")),
+      d_reclaimZombiesTime(smtStatisticsRegistry().registerTimer(
+          "expr::NodeManager::reclaimZombiesTime")),
+      d_cmmChunksAllocated(smtStatisticsRegistry().registerReference<uint64_t>(
+          "context::ContextMemoryManager::chunksAllocated")),
+      d_cmmChunksReleased(smtStatisticsRegistry().registerReference<uint64_t>(
+          "context::ContextMemoryManager::chunksReleased")),
+      d_cmmChunksReused(smtStatisticsRegistry().registerReference<uint64_t>(
+          "context::ContextMemoryManager::chunksReused")),
+      d_cmmPeakBytes(smtStatisticsRegistry().registerReference<uint64_t>(
+          "context::ContextMemoryManager::peakBytes")),
+      d_cmmPops(smtStatisticsRegistry().registerReference<uint64_t>(
+          "context::ContextMemoryManager::pops"))
 {
 }
 
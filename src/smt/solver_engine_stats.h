@@ -47,6 +47,30 @@ struct SolverEngineStatistics
 
   /** Has something simplified to false? */
   IntStat d_simplifiedToFalse;
+
+  /** Number of slabs allocated by the node manager */
+  ReferenceStat<uint64_t> d_nvSlabsAllocated;
+  /** Number of slabs released by the node manager */
+  ReferenceStat<uint64_t> d_nvSlabsReleased;
+  /** Number of slabs currently held by the node manager */
+  ReferenceStat<uint64_t> d_nvSlabs;
+  /** Number of node values currently living in slabs */
+  ReferenceStat<uint64_t> d_nvSlabObjects;
+  /** Number of bytes used by node values currently living in slabs */
+  ReferenceStat<uint64_t> d_nvSlabBytesUsed;
+  /** time spent reclaiming unreferenced nodes */
+  TimerStat d_reclaimZombiesTime;
+
+  /** Number of chunks of context memory obtained from the system */
+  ReferenceStat<uint64_t> d_cmmChunksAllocated;
+  /** Number of chunks of context memory returned to the system */
+  ReferenceStat<uint64_t> d_cmmChunksReleased;
+  /** Number of chunks of context memory reused after a pop */
+  ReferenceStat<uint64_t> d_cmmChunksReused;
+  /** Peak number of bytes of context memory */
+  ReferenceStat<uint64_t> d_cmmPeakBytes;
+  /** Number of pops of the context memory */
+  ReferenceStat<uint64_t> d_cmmPops;
 }; /* struct SolverEngineStatistics */
 
 }  // namespace smt
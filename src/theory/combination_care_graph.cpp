@@ -27,7 +27,9 @@ namespace theory {
 
 CombinationCareGraph::CombinationCareGraph(
     Env& env, TheoryEngine& te, const std::vector<Theory*>& paraTheories)
-    : CombinationEngine(env, te, paraTheories)
+    : CombinationEngine(env, te, paraTheories),
+      d_numSplits(
+          statisticsRegistry().registerInt("theory::combination::splits"))
 {
 }
 
@@ -78,6 +80,7 @@ void CombinationCareGraph::combineTheories()
     }
     d_sharedSolver->sendLemma(
         tsplit, carePair.d_theory, InferenceId::COMBINATION_SPLIT);
+    ++d_numSplits;
 
     // Could check the equality status here:
     //   EqualityStatus es = getEqualityStatus(carePair.d_a, carePair.d_b);
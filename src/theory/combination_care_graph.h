@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "theory/combination_engine.h"
+#include "util/statistics_stats.h"
 
 namespace cvc5 {
 
@@ -45,6 +46,10 @@ class CombinationCareGraph : public CombinationEngine
    * Combine theories using a care graph.
    */
   void combineTheories() override;
+
+ private:
+  /** Number of splits on care pairs */
+  IntStat d_numSplits;
 };
 
 }  // namespace theory
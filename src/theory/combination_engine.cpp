@@ -109,6 +109,11 @@ theory::TheoryModel* CombinationEngine::getModel()
   return d_mmanager->getModel();
 }
 
+void CombinationEngine::notifyResetAssertions()
+{
+  d_mmanager->notifyResetAssertions();
+}
+
 SharedSolver* CombinationEngine::getSharedSolver()
 {
   return d_sharedSolver.get();
@@ -80,6 +80,8 @@ class CombinationEngine : protected EnvObj
    * Get the model object maintained by this class.
    */
   TheoryModel* getModel();
+  /** Called on reset-assertions, notifies the model manager */
+  void notifyResetAssertions();
   //-------------------------- end model
   /**
    * Get the shared solver, which is the active component of theory combination
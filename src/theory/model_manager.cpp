@@ -143,6 +143,11 @@ void ModelManager::postProcessModel(bool incomplete)
 
 theory::TheoryModel* ModelManager::getModel() { return d_model.get(); }
 
+void ModelManager::notifyResetAssertions()
+{
+  d_modelBuilder->notifyResetAssertions();
+}
+
 bool ModelManager::collectModelBooleanVariables()
 {
   Trace("model-builder") << "  CollectModelInfo boolean variables" << std::endl;
@@ -76,6 +76,8 @@ class ModelManager : protected EnvObj
   void postProcessModel(bool incomplete);
   /** Get a pointer to model object maintained by this class. */
   TheoryModel* getModel();
+  /** Called on reset-assertions, notifies the model builder */
+  void notifyResetAssertions();
   //------------------------ finer grained control over model building
   /**
    * Prepare model, which is the manager-specific method for setting up the
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A bounded rewrite cache with clock eviction.
+ */
+
+#include "theory/rewrite_cache.h"
+
+#include "base/check.h"
+#include "base/output.h"
+#include "util/statistics_registry.h"
+
+namespace cvc5 {
+namespace theory {
+
+// an entry of the ring, plus a node of the index with its key, its position
+// and the bucket pointer pointing to it
+const size_t RewriteCache::s_entryBytes =
+    sizeof(Entry) + sizeof(Key) + 3 * sizeof(size_t) + 2 * sizeof(void*);
+
+RewriteCache::RewriteCache(StatisticsRegistry& sr, size_t capacity)
+    : d_capacity(capacity),
+      d_hand(0),
+      d_hits(sr.registerInt("theory::Rewriter::cacheHits")),
+      d_misses(sr.registerInt("theory::Rewriter::cacheMisses")),
+      d_evictions(sr.registerInt("theory::Rewriter::cacheEvictions"))
+{
+  Assert(d_capacity > 0);
+}
+
+Node RewriteCache::get(bool pre, TheoryId tid, TNode node)
+{
+  auto it = d_index.find(Key{node, mkTag(pre, tid)});
+  if (it == d_index.end())
+  {
+    ++d_misses;
+    return Node::null();
+  }
+  ++d_hits;
+  Entry& e = d_entries[it->second];
+  e.d_referenced = true;
+  return e.d_value;
+}
+
+void RewriteCache::set(bool pre, TheoryId tid, TNode node, TNode value)
+{
+  Assert(!value.isNull());
+  uint32_t tag = mkTag(pre, tid);
+  auto it = d_index.find(Key{node, tag});
+  if (it != d_index.end())
+  {
+    d_entries[it->second].d_value = value;
+    return;
+  }
+  size_t pos;
+  if (d_entries.size() < d_capacity)
+  {
+    pos = d_entries.size();
+    d_entries.push_back(Entry{node, value, tag, false});
+  }
+  else
+  {
+    pos = evict();
+    Entry& e = d_entries[pos];
+    e.d_node = node;
+    e.d_value = value;
+    e.d_tag = tag;
+    e.d_referenced = false;
+  }
+  // the key refers to the node held by the entry
+  d_index.emplace(Key{d_entries[pos].d_node, tag}, pos);
+}
+
+size_t RewriteCache::evict()
+{
+  Assert(!d_entries.empty());
+  // give every referenced entry a second chance, this terminates after at
+  // most one full turn of the hand
+  while (d_entries[d_hand].d_referenced)
+  {
+    d_entries[d_hand].d_referenced = false;
+    d_hand = (d_hand + 1) % d_entries.size();
+  }
+  size_t pos = d_hand;
+  d_hand = (d_hand + 1) % d_entries.size();
+  Entry& e = d_entries[pos];
+  Trace("rewrite-cache") << "evict " << e.d_node << std::endl;
+  // erase from the index before the entry releases its node
+  d_index.erase(Key{e.d_node, e.d_tag});
+  ++d_evictions;
+  return pos;
+}
+
+void RewriteCache::clear()
+{
+  d_index.clear();
+  d_entries.clear();
+  d_hand = 0;
+}
+
+}  // namespace theory
+}  // namespace cvc5
@@ -0,0 +1,144 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A bounded rewrite cache with clock eviction.
+ */
+
+#include "cvc5_private.h"
+
+#ifndef CVC5__THEORY__REWRITE_CACHE_H
+#define CVC5__THEORY__REWRITE_CACHE_H
+
+#include <unordered_map>
+#include <vector>
+
+#include "expr/node.h"
+#include "theory/theory_id.h"
+#include "util/statistics_stats.h"
+
+namespace cvc5 {
+
+class StatisticsRegistry;
+
+namespace theory {
+
+/**
+ * The pre- and post-rewrite caches of a Rewriter when their size is bounded
+ * (see option --rewrite-cache-budget).
+ *
+ * By default, the rewrite caches are stored as node attributes, which are
+ * shared by all rewriters of a node manager and live as long as the nodes
+ * themselves (or until Rewriter::clearCaches()). This class instead owns its
+ * entries and holds at most a fixed number of them. When it is full, an
+ * entry is evicted using the clock algorithm: entries are kept in a ring,
+ * each with a reference bit that is set on every hit, and a hand sweeps over
+ * the ring clearing reference bits until it finds an entry whose bit is
+ * clear. This approximates LRU without reordering entries on hits.
+ *
+ * Evicting an entry releases the references the cache holds to its key and
+ * value, so that rewritten terms that are no longer used elsewhere can be
+ * garbage collected.
+ */
+class RewriteCache
+{
+ public:
+  /**
+   * Approximate number of bytes used per entry, including the index. This is
+   * used to convert a memory budget into a number of entries. It does not
+   * account for the nodes kept alive by the cache.
+   */
+  static const size_t s_entryBytes;
+
+  /**
+   * @param sr The registry for the statistics of this cache
+   * @param capacity The maximum number of entries, must be positive
+   */
+  RewriteCache(StatisticsRegistry& sr, size_t capacity);
+
+  /**
+   * Get the cached pre-rewrite (if pre is true) or post-rewrite (otherwise)
+   * of node for theory tid, or the null node if there is none.
+   */
+  Node get(bool pre, TheoryId tid, TNode node);
+  /**
+   * Set the cached pre-rewrite (if pre is true) or post-rewrite (otherwise)
+   * of node for theory tid to value. This may evict another entry.
+   */
+  void set(bool pre, TheoryId tid, TNode node, TNode value);
+  /** Remove all entries. */
+  void clear();
+
+  /** The number of entries */
+  size_t size() const { return d_entries.size(); }
+  /** The maximum number of entries */
+  size_t capacity() const { return d_capacity; }
+
+ private:
+  /** The key of an entry: a node, a theory and whether it is a pre-rewrite */
+  struct Key
+  {
+    TNode d_node;
+    uint32_t d_tag;
+    bool operator==(const Key& other) const
+    {
+      return d_node == other.d_node && d_tag == other.d_tag;
+    }
+  };
+  struct KeyHashFunction
+  {
+    size_t operator()(const Key& k) const
+    {
+      return std::hash<TNode>()(k.d_node) * 0x9e3779b97f4a7c15ULL + k.d_tag;
+    }
+  };
+  /** An entry of the ring. */
+  struct Entry
+  {
+    /** The node, holds the reference for the key in the index */
+    Node d_node;
+    /** The rewritten node */
+    Node d_value;
+    /** The tag of the key */
+    uint32_t d_tag;
+    /** Whether the entry was used since the hand last passed it */
+    bool d_referenced;
+  };
+
+  /** Compute the tag for the given kind of cache and theory */
+  static uint32_t mkTag(bool pre, TheoryId tid)
+  {
+    return (static_cast<uint32_t>(tid) << 1) | (pre ? 1 : 0);
+  }
+  /** Get the index of the entry to overwrite, evicting it from the index */
+  size_t evict();
+
+  /** The maximum number of entries */
+  size_t d_capacity;
+  /** The ring of entries */
+  std::vector<Entry> d_entries;
+  /** Maps keys to their position in d_entries */
+  std::unordered_map<Key, size_t, KeyHashFunction> d_index;
+  /** The position of the clock hand in d_entries */
+  size_t d_hand;
+
+  /** Number of lookups that found an entry */
+  IntStat d_hits;
+  /** Number of lookups that did not find an entry */
+  IntStat d_misses;
+  /** Number of entries evicted */
+  IntStat d_evictions;
+}; /* class RewriteCache */
+
+}  // namespace theory
+}  // namespace cvc5
+
+#endif /* CVC5__THEORY__REWRITE_CACHE_H */
@@ -15,6 +15,10 @@
 
 #include "theory/rewriter.h"
 
+#include <algorithm>
+#include <optional>
+#include <sstream>
+
 #include "options/theory_options.h"
 #include "proof/conv_proof_generator.h"
 #include "smt/smt_statistics_registry.h"
@@ -23,9 +27,11 @@
 #include "theory/builtin/proof_checker.h"
 #include "theory/evaluator.h"
 #include "theory/quantifiers/extended_rewrite.h"
+#include "theory/rewrite_cache.h"
 #include "theory/rewriter_tables.h"
 #include "theory/theory.h"
 #include "util/resource_manager.h"
+#include "util/statistics_registry.h"
 
 using namespace std;
 
@@ -61,12 +67,13 @@ struct RewriteStackElement {
   /**
    * Construct a fresh stack element.
    */
-  RewriteStackElement(TNode node, TheoryId theoryId)
+  RewriteStackElement(TNode node, TheoryId theoryId, size_t childStart)
       : d_node(node),
         d_original(node),
         d_theoryId(theoryId),
         d_originalTheoryId(theoryId),
-        d_nextChild(0)
+        d_nextChild(0),
+        d_childStart(childStart)
   {
   }
 
@@ -88,10 +95,82 @@ struct RewriteStackElement {
   unsigned d_originalTheoryId : 8;
   /** Index of the child this node is done rewriting */
   unsigned d_nextChild : 32;
-  /** Builder for this node */
-  NodeBuilder d_builder;
+  /**
+   * The position in RewriteArena::d_children of the rewritten form of the
+   * first child of this node.
+   */
+  size_t d_childStart;
+};
+
+/**
+ * The storage of one rewrite stack of Rewriter::rewriteTo(). The rewritten
+ * children of all nodes on the stack are kept in a single vector, those of
+ * the top element at its end.
+ */
+struct RewriteArena
+{
+  /** The rewrite stack */
+  std::vector<RewriteStackElement> d_stack;
+  /** The rewritten children of the nodes on the stack */
+  std::vector<Node> d_children;
 };
 
+namespace {
+
+/**
+ * Acquires the arena for the current nesting depth of Rewriter::rewriteTo()
+ * and clears it on exit, keeping its capacity.
+ */
+class RewriteArenaScope
+{
+ public:
+  RewriteArenaScope(std::vector<std::unique_ptr<RewriteArena>>& arenas,
+                    size_t& depth)
+      : d_depth(depth)
+  {
+    if (arenas.size() <= d_depth)
+    {
+      arenas.emplace_back(new RewriteArena());
+    }
+    d_arena = arenas[d_depth].get();
+    ++d_depth;
+  }
+  ~RewriteArenaScope()
+  {
+    d_arena->d_stack.clear();
+    d_arena->d_children.clear();
+    --d_depth;
+  }
+  RewriteArena& get() { return *d_arena; }
+
+ private:
+  size_t& d_depth;
+  RewriteArena* d_arena;
+};
+
+}  // namespace
+
+Rewriter::Rewriter()
+    : d_resourceManager(nullptr), d_tpg(nullptr), d_cache(nullptr), d_depth(0)
+{
+}
+
+Rewriter::~Rewriter() {}
+
+Rewriter::Statistics::Statistics(StatisticsRegistry& sr)
+    : d_preRewrites(
+        sr.registerHistogram<TheoryId>("theory::Rewriter::preRewrites")),
+      d_postRewrites(
+          sr.registerHistogram<TheoryId>("theory::Rewriter::postRewrites"))
+{
+  for (size_t i = 0; i < THEORY_LAST; ++i)
+  {
+    std::stringstream ss;
+    ss << "theory::Rewriter::time::" << static_cast<TheoryId>(i);
+    d_time.push_back(sr.registerTimer(ss.str()));
+  }
+}
+
 
 Node Rewriter::rewrite(TNode node) {
   if (node.getNumChildren() == 0)
@@ -192,9 +271,13 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId,
     return cached;
   }
 
-  // Put the node on the stack in order to start the "recursive" rewrite
-  vector<RewriteStackElement> rewriteStack;
-  rewriteStack.push_back(RewriteStackElement(node, theoryId));
+  // Put the node on the stack in order to start the "recursive" rewrite. The
+  // stack and the rewritten children are kept in the arena of this nesting
+  // depth, which is reused across calls.
+  RewriteArenaScope arena(d_arenas, d_depth);
+  std::vector<RewriteStackElement>& rewriteStack = arena.get().d_stack;
+  std::vector<Node>& children = arena.get().d_children;
+  rewriteStack.emplace_back(node, theoryId, 0);
 
   // Rewrite until the stack is empty
   for (;;){
@@ -260,36 +343,40 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId,
     {
       // The child we need to rewrite
       unsigned child = rewriteStackTop.d_nextChild++;
-
-      // To build the rewritten expression we set up the builder
-      if(child == 0) {
-        if (rewriteStackTop.d_node.getNumChildren() > 0)
-        {
-          // The children will add themselves to the builder once they're done
-          rewriteStackTop.d_builder << rewriteStackTop.d_node.getKind();
-          kind::MetaKind metaKind = rewriteStackTop.d_node.getMetaKind();
-          if (metaKind == kind::metakind::PARAMETERIZED) {
-            rewriteStackTop.d_builder << rewriteStackTop.d_node.getOperator();
-          }
-        }
-      }
+      size_t nchildren = rewriteStackTop.d_node.getNumChildren();
 
       // Process the next child
-      if (child < rewriteStackTop.d_node.getNumChildren())
+      if (child < nchildren)
       {
-        // The child node
+        // The child node, which will add its rewritten form to the children
+        // of the arena once it is done
         Node childNode = rewriteStackTop.d_node[child];
         // Push the rewrite request to the stack (NOTE: rewriteStackTop might be a bad reference now)
-        rewriteStack.push_back(RewriteStackElement(childNode, theoryOf(childNode)));
+        rewriteStack.emplace_back(
+            childNode, theoryOf(childNode), children.size());
         // Go on with the rewriting
         continue;
       }
 
       // Incorporate the children if necessary
-      if (rewriteStackTop.d_node.getNumChildren() > 0)
+      if (nchildren > 0)
       {
-        Node rewritten = rewriteStackTop.d_builder;
-        rewriteStackTop.d_node = rewritten;
+        Assert(children.size() == rewriteStackTop.d_childStart + nchildren);
+        std::vector<Node>::iterator cbegin =
+            children.begin() + rewriteStackTop.d_childStart;
+        // Only build a new node if one of the children changed
+        if (!std::equal(cbegin, children.end(), rewriteStackTop.d_node.begin()))
+        {
+          NodeBuilder nb(rewriteStackTop.d_node.getKind());
+          if (rewriteStackTop.d_node.getMetaKind()
+              == kind::metakind::PARAMETERIZED)
+          {
+            nb << rewriteStackTop.d_node.getOperator();
+          }
+          nb.append(cbegin, children.end());
+          rewriteStackTop.d_node = nb;
+        }
+        children.erase(cbegin, children.end());
         rewriteStackTop.d_theoryId = theoryOf(rewriteStackTop.d_node);
       }
 
@@ -392,8 +479,8 @@ Node Rewriter::rewriteTo(theory::TheoryId theoryId,
       return rewriteStackTop.d_node;
     }
 
-    // We're done with this node, append it to the parent
-    rewriteStack[rewriteStack.size() - 2].d_builder << rewriteStackTop.d_node;
+    // We're done with this node, append it to the children of the parent
+    children.push_back(rewriteStackTop.d_node);
     rewriteStack.pop_back();
   }
 
@@ -404,6 +491,12 @@ RewriteResponse Rewriter::preRewrite(theory::TheoryId theoryId,
                                      TNode n,
                                      TConvProofGenerator* tcpg)
 {
+  std::optional<CodeTimer> timer;
+  if (d_stats != nullptr)
+  {
+    d_stats->d_preRewrites << theoryId;
+    timer.emplace(d_stats->d_time[theoryId], true);
+  }
   if (tcpg != nullptr)
   {
     // call the trust rewrite response interface
@@ -420,6 +513,12 @@ RewriteResponse Rewriter::postRewrite(theory::TheoryId theoryId,
                                       TNode n,
                                       TConvProofGenerator* tcpg)
 {
+  std::optional<CodeTimer> timer;
+  if (d_stats != nullptr)
+  {
+    d_stats->d_postRewrites << theoryId;
+    timer.emplace(d_stats->d_time[theoryId], true);
+  }
   if (tcpg != nullptr)
   {
     // same as above, for post-rewrite
@@ -471,8 +570,29 @@ void Rewriter::clearCaches()
   d_rewriteStack.reset(nullptr);
 #endif
 
+  if (d_cache != nullptr)
+  {
+    d_cache->clear();
+  }
   clearCachesInternal();
 }
 
+void Rewriter::enableStatistics(StatisticsRegistry& sr)
+{
+  if (d_stats == nullptr)
+  {
+    d_stats.reset(new Statistics(sr));
+  }
+}
+
+void Rewriter::setCacheBudget(StatisticsRegistry& sr, size_t bytes)
+{
+  Assert(bytes > 0);
+  size_t capacity = std::max<size_t>(1, bytes / RewriteCache::s_entryBytes);
+  Trace("rewriter") << "Rewriter::setCacheBudget: " << capacity << " entries"
+                    << std::endl;
+  d_cache.reset(new RewriteCache(sr, capacity));
+}
+
 }  // namespace theory
 }  // namespace cvc5
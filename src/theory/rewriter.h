@@ -17,12 +17,17 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "expr/node.h"
 #include "theory/theory_rewriter.h"
+#include "util/statistics_stats.h"
 
 namespace cvc5 {
 
 class Env;
+class StatisticsRegistry;
 class TConvProofGenerator;
 class ProofNodeManager;
 class TrustNode;
@@ -30,6 +35,8 @@ class TrustNode;
 namespace theory {
 
 class Evaluator;
+class RewriteCache;
+struct RewriteArena;
 
 /**
  * The main rewriter class.
@@ -38,6 +45,7 @@ class Rewriter {
   friend class cvc5::Env;  // to set the resource manager
  public:
   Rewriter();
+  ~Rewriter();
 
   /**
    * !!! Temporary until static access to rewriter is eliminated.
@@ -96,6 +104,25 @@ class Rewriter {
   /** Garbage collects the rewrite caches. */
   void clearCaches();
 
+  /**
+   * Bound the rewrite caches of this rewriter to approximately the given
+   * number of bytes. After this call, this rewriter no longer uses the rewrite
+   * caches stored as node attributes (which are shared by all rewriters of the
+   * node manager), but caches of its own that evict entries once full.
+   *
+   * @param sr The registry for the statistics of the caches
+   * @param bytes The memory budget of the caches, must be positive
+   */
+  void setCacheBudget(StatisticsRegistry& sr, size_t bytes);
+
+  /**
+   * Enable collecting statistics about the rewrites of each theory (see
+   * option --rewrite-stats).
+   *
+   * @param sr The registry for the statistics
+   */
+  void enableStatistics(StatisticsRegistry& sr);
+
   /**
    * Registers a theory rewriter with this rewriter. The rewriter does not own
    * the theory rewriters.
@@ -167,6 +194,35 @@ class Rewriter {
 
   /** The proof generator */
   std::unique_ptr<TConvProofGenerator> d_tpg;
+
+  /** The bounded rewrite caches, if any (see setCacheBudget) */
+  std::unique_ptr<RewriteCache> d_cache;
+
+  /**
+   * The storage for the rewrite stacks of rewriteTo(), one per nesting depth
+   * of calls to rewriteTo(). Their capacity is kept across calls, so that
+   * rewriting does not allocate once the arenas have grown large enough.
+   */
+  std::vector<std::unique_ptr<RewriteArena>> d_arenas;
+  /** The current nesting depth of calls to rewriteTo() */
+  size_t d_depth;
+
+  /** Statistics collected if --rewrite-stats is enabled */
+  struct Statistics
+  {
+    Statistics(StatisticsRegistry& sr);
+    /** Number of pre-rewrite steps per theory */
+    HistogramStat<TheoryId> d_preRewrites;
+    /** Number of post-rewrite steps per theory */
+    HistogramStat<TheoryId> d_postRewrites;
+    /**
+     * Time spent in the rewriter of each theory. This includes the time of
+     * the nested rewrites it triggers.
+     */
+    std::vector<TimerStat> d_time;
+  };
+  /** The statistics, null if --rewrite-stats is disabled */
+  std::unique_ptr<Statistics> d_stats;
 #ifdef CVC5_ASSERTIONS
   std::unique_ptr<std::unordered_set<Node>> d_rewriteStack = nullptr;
 #endif /* CVC5_ASSERTIONS */
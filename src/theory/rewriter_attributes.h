@@ -28,8 +28,8 @@ struct RewriteCacheTag {};
 template <theory::TheoryId theoryId>
 struct RewriteAttibute {
 
-  typedef expr::Attribute< RewriteCacheTag<true, theoryId>, Node> pre_rewrite;
-  typedef expr::Attribute< RewriteCacheTag<false, theoryId>, Node> post_rewrite;
+  typedef expr::Attribute<RewriteCacheTag<true, theoryId>, Node> pre_rewrite;
+  typedef expr::Attribute<RewriteCacheTag<false, theoryId>, Node> post_rewrite;
 
   /**
    * Get the value of the pre-rewrite cache.
@@ -37,9 +37,8 @@ struct RewriteAttibute {
   static Node getPreRewriteCache(TNode node)
   {
     Node cache;
-    if (node.hasAttribute(pre_rewrite())) {
-      node.getAttribute(pre_rewrite(), cache);
-    } else {
+    if (!node.getAttribute(pre_rewrite(), cache))
+    {
       return Node::null();
     }
     if (cache.isNull()) {
@@ -70,9 +69,8 @@ struct RewriteAttibute {
   static Node getPostRewriteCache(TNode node)
   {
     Node cache;
-    if (node.hasAttribute(post_rewrite())) {
-      node.getAttribute(post_rewrite(), cache);
-    } else {
+    if (!node.getAttribute(post_rewrite(), cache))
+    {
       return Node::null();
     }
     if (cache.isNull()) {
@@ -22,6 +22,7 @@
 
 #include "expr/attribute.h"
 #include "expr/attribute_unique_id.h"
+#include "theory/rewrite_cache.h"
 #include "theory/rewriter.h"
 #include "theory/rewriter_attributes.h"
 
@@ -34,6 +35,10 @@ namespace theory {
 
 Node Rewriter::getPreRewriteCache(theory::TheoryId theoryId, TNode node)
 {
+  if (d_cache != nullptr)
+  {
+    return d_cache->get(true, theoryId, node);
+  }
   switch (theoryId)
   {
     // clang-format off
@@ -45,6 +50,10 @@ ${pre_rewrite_get_cache}
 
 Node Rewriter::getPostRewriteCache(theory::TheoryId theoryId, TNode node)
 {
+  if (d_cache != nullptr)
+  {
+    return d_cache->get(false, theoryId, node);
+  }
   switch (theoryId)
   {
     // clang-format off
@@ -58,6 +67,11 @@ void Rewriter::setPreRewriteCache(theory::TheoryId theoryId,
                                   TNode node,
                                   TNode cache)
 {
+  if (d_cache != nullptr)
+  {
+    d_cache->set(true, theoryId, node, cache);
+    return;
+  }
   switch (theoryId)
   {
     // clang-format off
@@ -71,6 +85,11 @@ void Rewriter::setPostRewriteCache(theory::TheoryId theoryId,
                                    TNode node,
                                    TNode cache)
 {
+  if (d_cache != nullptr)
+  {
+    d_cache->set(false, theoryId, node, cache);
+    return;
+  }
   switch (theoryId)
   {
     // clang-format off
@@ -80,8 +99,6 @@ ${post_rewrite_set_cache}
   }
 }
 
-Rewriter::Rewriter() : d_resourceManager(nullptr), d_tpg(nullptr) {}
-
 void Rewriter::clearCachesInternal()
 {
   typedef cvc5::expr::attr::AttributeUniqueId AttributeUniqueId;
@@ -24,13 +24,45 @@ namespace theory {
 
 SubstitutionMap::SubstitutionMap(context::Context* context)
     : d_context(),
-      d_substitutions(context ? context : &d_context),
-      d_substitutionCache(),
-      d_cacheInvalidated(false),
-      d_cacheInvalidator(context ? context : &d_context, d_cacheInvalidated)
+      d_ctx(context ? context : &d_context),
+      d_substitutions(d_ctx),
+      d_lastVersion(0),
+      d_version(d_ctx, 0),
+      d_versionLevel(d_ctx, 0)
 {
 }
 
+void SubstitutionMap::newVersion()
+{
+  d_version = ++d_lastVersion;
+  d_versionLevel = d_ctx->getLevel();
+}
+
+SubstitutionMap::NodeCache& SubstitutionMap::getCache()
+{
+  uint64_t version = d_version.get();
+  // versions newer than the current one were popped and cannot come back
+  while (!d_caches.empty() && d_caches.back().d_version > version)
+  {
+    d_caches.pop_back();
+  }
+  if (d_caches.empty() || d_caches.back().d_version != version)
+  {
+    // The older versions created at the level of the current version or above
+    // were overwritten by the current version, and popping the context does
+    // not restore them.
+    uint32_t level = d_versionLevel.get();
+    while (!d_caches.empty() && d_caches.back().d_level >= level)
+    {
+      d_caches.pop_back();
+    }
+    d_caches.push_back(Cache{version, level, NodeCache()});
+    Debug("substitution") << "-- new cache for version " << version
+                          << " at level " << level << endl;
+  }
+  return d_caches.back().d_cache;
+}
+
 struct substitution_stack_element {
   TNode d_node;
   bool d_children_added;
@@ -158,12 +190,16 @@ void SubstitutionMap::addSubstitution(TNode x, TNode t, bool invalidateCache)
 
   d_substitutions[x] = t;
 
-  // Also invalidate the cache if necessary
-  if (invalidateCache) {
-    d_cacheInvalidated = true;
+  // Also invalidate the cache if necessary. The cache of the current version
+  // can only be updated in place if the version was created at the current
+  // level, since otherwise the cache outlives the substitution on pop.
+  if (invalidateCache || d_versionLevel.get() != (uint32_t)d_ctx->getLevel())
+  {
+    newVersion();
   }
-  else {
-    d_substitutionCache[x] = d_substitutions[x];
+  else
+  {
+    getCache()[x] = d_substitutions[x];
   }
 }
 
@@ -175,12 +211,16 @@ void SubstitutionMap::addSubstitutions(SubstitutionMap& subMap, bool invalidateC
   for (; it != it_end; ++ it) {
     Assert(d_substitutions.find((*it).first) == d_substitutions.end());
     d_substitutions[(*it).first] = (*it).second;
-    if (!invalidateCache) {
-      d_substitutionCache[(*it).first] = d_substitutions[(*it).first];
-    }
   }
-  if (invalidateCache) {
-    d_cacheInvalidated = true;
+  if (invalidateCache || d_versionLevel.get() != (uint32_t)d_ctx->getLevel())
+  {
+    newVersion();
+    return;
+  }
+  NodeCache& cache = getCache();
+  for (it = subMap.begin(); it != it_end; ++it)
+  {
+    cache[(*it).first] = (*it).second;
   }
 }
 
@@ -188,15 +228,8 @@ Node SubstitutionMap::apply(TNode t, bool doRewrite) {
 
   Debug("substitution") << "SubstitutionMap::apply(" << t << ")" << endl;
 
-  // Setup the cache
-  if (d_cacheInvalidated) {
-    d_substitutionCache.clear();
-    d_cacheInvalidated = false;
-    Debug("substitution") << "-- reset the cache" << endl;
-  }
-
   // Perform the substitution
-  Node result = internalSubstitute(t, d_substitutionCache);
+  Node result = internalSubstitute(t, getCache());
   Debug("substitution") << "SubstitutionMap::apply(" << t << ") => " << result << endl;
 
   if (doRewrite)
@@ -53,40 +53,56 @@ class SubstitutionMap
   /** A dummy context used by this class if none is provided */
   context::Context d_context;
 
+  /** The context of the substitutions */
+  context::Context* d_ctx;
+
   /** The variables, in order of addition */
   NodeMap d_substitutions;
 
-  /** Cache of the already performed substitutions */
-  NodeCache d_substitutionCache;
+  /**
+   * A cache of the already performed substitutions, which is valid for one
+   * version of the set of substitutions.
+   */
+  struct Cache
+  {
+    /** The version of the set of substitutions this cache is valid for */
+    uint64_t d_version;
+    /** The context level at which this version was created */
+    uint32_t d_level;
+    /** The cached results */
+    NodeCache d_cache;
+  };
 
-  /** Has the cache been invalidated? */
-  bool d_cacheInvalidated;
+  /**
+   * The caches of the versions that can still be restored by popping the
+   * context, ordered by version, at most one per context level. This allows
+   * reusing the results of applying the substitutions of lower context levels
+   * after a pop, instead of starting from scratch.
+   */
+  std::vector<Cache> d_caches;
 
-  /** Internal method that performs substitution */
-  Node internalSubstitute(TNode t, NodeCache& cache);
+  /** The last version that was created */
+  uint64_t d_lastVersion;
 
-  /** Helper class to invalidate cache on user pop */
-  class CacheInvalidator : public context::ContextNotifyObj
-  {
-    bool& d_cacheInvalidated;
+  /**
+   * The version of the current set of substitutions. A new version is
+   * created whenever substitutions are added that invalidate the cache.
+   * Versions are unique, hence restoring the version on pop identifies the
+   * set of substitutions of the restored context.
+   */
+  context::CDO<uint64_t> d_version;
 
-   protected:
-    void contextNotifyPop() override { d_cacheInvalidated = true; }
+  /** The context level at which d_version was created */
+  context::CDO<uint32_t> d_versionLevel;
 
-   public:
-    CacheInvalidator(context::Context* context, bool& cacheInvalidated)
-        : context::ContextNotifyObj(context),
-          d_cacheInvalidated(cacheInvalidated)
-    {
-    }
+  /** Internal method that performs substitution */
+  Node internalSubstitute(TNode t, NodeCache& cache);
 
-  }; /* class SubstitutionMap::CacheInvalidator */
+  /** Create a new version of the set of substitutions */
+  void newVersion();
 
-  /**
-   * This object is notified on user pop and marks the SubstitutionMap's
-   * cache as invalidated.
-   */
-  CacheInvalidator d_cacheInvalidator;
+  /** Get the cache of the current version */
+  NodeCache& getCache();
 
  public:
   SubstitutionMap(context::Context* context = nullptr);
@@ -69,12 +69,17 @@ Theory::Theory(TheoryId id,
       d_facts(d_env.getContext()),
       d_factsHead(d_env.getContext(), 0),
       d_sharedTermsIndex(d_env.getContext(), 0),
+      d_carePairs(d_env.getContext()),
+      d_carePairsHead(d_env.getContext(), 0),
+      d_carePairsLevel(d_env.getContext(), 0),
       d_careGraph(nullptr),
       d_instanceName(name),
       d_checkTime(statisticsRegistry().registerTimer(getStatsPrefix(id) + name
                                                      + "checkTime")),
       d_computeCareGraphTime(statisticsRegistry().registerTimer(
           getStatsPrefix(id) + name + "computeCareGraphTime")),
+      d_carePairsExamined(statisticsRegistry().registerInt(
+          getStatsPrefix(id) + name + "carePairsExamined")),
       d_sharedTerms(d_env.getContext()),
       d_out(&out),
       d_valuation(valuation),
@@ -286,27 +291,66 @@ void Theory::notifyInConflict()
 
 void Theory::computeCareGraph() {
   Debug("sharing") << "Theory::computeCareGraph<" << getId() << ">()" << endl;
-  for (unsigned i = 0; i < d_sharedTerms.size(); ++ i) {
-    TNode a = d_sharedTerms[i];
-    TypeNode aType = a.getType();
-    for (unsigned j = i + 1; j < d_sharedTerms.size(); ++ j) {
-      TNode b = d_sharedTerms[j];
-      if (b.getType() != aType) {
+  // If the last call was at the current context level, the pairs it
+  // returned are already recorded at this level and are not added again.
+  int level = d_env.getContext()->getLevel();
+  bool sameLevel = d_carePairsLevel == level;
+  std::vector<std::pair<Node, Node>> pending;
+  // the pairs returned at the context level of the last call
+  for (size_t i = d_carePairsHead, size = d_carePairs.size(); i < size; ++i)
+  {
+    const std::pair<Node, Node>& p = d_carePairs[i];
+    if (checkCarePair(p.first, p.second) && !sameLevel)
+    {
+      pending.push_back(p);
+    }
+  }
+  // the pairs with a new shared term
+  for (unsigned j = d_sharedTermsIndex, size = d_sharedTerms.size(); j < size;
+       ++j)
+  {
+    TNode b = d_sharedTerms[j];
+    TypeNode bType = b.getType();
+    for (unsigned i = 0; i < j; ++i)
+    {
+      TNode a = d_sharedTerms[i];
+      if (a.getType() != bType)
+      {
         // We don't care about the terms of different types
         continue;
       }
-      switch (d_valuation.getEqualityStatus(a, b)) {
-      case EQUALITY_TRUE_AND_PROPAGATED:
-      case EQUALITY_FALSE_AND_PROPAGATED:
-        // If we know about it, we should have propagated it, so we can skip
-        break;
-      default:
-        // Let's split on it
-        addCarePair(a, b);
-        break;
+      if (checkCarePair(a, b))
+      {
+        pending.push_back(std::make_pair(a, b));
       }
     }
   }
+  d_sharedTermsIndex = d_sharedTerms.size();
+  if (!sameLevel)
+  {
+    d_carePairsHead = d_carePairs.size();
+    d_carePairsLevel = level;
+  }
+  for (const std::pair<Node, Node>& p : pending)
+  {
+    d_carePairs.push_back(p);
+  }
+}
+
+bool Theory::checkCarePair(TNode a, TNode b)
+{
+  ++d_carePairsExamined;
+  switch (d_valuation.getEqualityStatus(a, b))
+  {
+    case EQUALITY_TRUE_AND_PROPAGATED:
+    case EQUALITY_FALSE_AND_PROPAGATED:
+      // If we know about it, we should have propagated it, so we can skip
+      return false;
+    default:
+      // Let's split on it
+      addCarePair(a, b);
+      return true;
+  }
 }
 
 void Theory::printFacts(std::ostream& os) const {
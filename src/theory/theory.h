@@ -119,9 +119,23 @@ class Theory : protected EnvObj
   /** Index into the head of the facts list */
   context::CDO<unsigned> d_factsHead;
 
-  /** Indices for splitting on the shared terms. */
+  /**
+   * The number of shared terms such that all pairs among them were examined
+   * by the default computeCareGraph in the current context.
+   */
   context::CDO<unsigned> d_sharedTermsIndex;
 
+  /**
+   * The pairs of shared terms whose equality status was not known to be
+   * propagated when examined by the default computeCareGraph, starting at
+   * d_carePairsHead for the calls at the context level of the last call.
+   */
+  context::CDList<std::pair<Node, Node>> d_carePairs;
+  /** Index of the pairs of the last call in d_carePairs */
+  context::CDO<size_t> d_carePairsHead;
+  /** The context level at which d_carePairsHead was set */
+  context::CDO<int> d_carePairsLevel;
+
   /** The care graph the theory will use during combination. */
   CareGraph* d_careGraph;
 
@@ -140,6 +154,8 @@ class Theory : protected EnvObj
   TimerStat d_checkTime;
   /** time spent in theory combination */
   TimerStat d_computeCareGraphTime;
+  /** number of pairs of shared terms examined by the default care graph */
+  IntStat d_carePairsExamined;
 
   /**
    * The only method to add suff to the care graph.
@@ -148,9 +164,18 @@ class Theory : protected EnvObj
 
   /**
    * The function should compute the care graph over the shared terms.
-   * The default function returns all the pairs among the shared variables.
+   * The default function returns all the pairs among the shared variables
+   * whose equality status is not known to be propagated. Since a propagated
+   * status remains so until backtracking, it only examines the pairs with a
+   * shared term added since the last call in the current context, and the
+   * pairs it returned at the context level of that call.
    */
   virtual void computeCareGraph();
+  /**
+   * Adds the pair of shared terms to the care graph, unless their equality
+   * status is known to be propagated. Returns true if the pair was added.
+   */
+  bool checkCarePair(TNode a, TNode b);
 
   /**
    * A list of shared terms that the theory has.
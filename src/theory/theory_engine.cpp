@@ -628,6 +628,12 @@ TheoryModel* TheoryEngine::getModel()
   return m;
 }
 
+void TheoryEngine::notifyResetAssertions()
+{
+  Assert(d_tc != nullptr);
+  d_tc->notifyResetAssertions();
+}
+
 TheoryModel* TheoryEngine::getBuiltModel()
 {
   Assert(d_tc != nullptr);
@@ -259,16 +259,26 @@ class TheoryEngine : protected EnvObj
    */
   void notifyRestart();
 
+  /**
+   * Appends the literals propagated since the last call to literals. The
+   * context-dependent index into the propagated literals is only updated once
+   * per call.
+   */
   void getPropagatedLiterals(std::vector<TNode>& literals)
   {
-    for (; d_propagatedLiteralsIndex < d_propagatedLiterals.size();
-         d_propagatedLiteralsIndex = d_propagatedLiteralsIndex + 1)
+    size_t size = d_propagatedLiterals.size();
+    if (d_propagatedLiteralsIndex >= size)
+    {
+      return;
+    }
+    for (size_t i = d_propagatedLiteralsIndex; i < size; ++i)
     {
       Debug("getPropagatedLiterals")
           << "TheoryEngine::getPropagatedLiterals: propagating: "
-          << d_propagatedLiterals[d_propagatedLiteralsIndex] << std::endl;
-      literals.push_back(d_propagatedLiterals[d_propagatedLiteralsIndex]);
+          << d_propagatedLiterals[i] << std::endl;
+      literals.push_back(d_propagatedLiterals[i]);
     }
+    d_propagatedLiteralsIndex = size;
   }
 
   /**
@@ -290,6 +300,11 @@ class TheoryEngine : protected EnvObj
    * Get the pointer to the model object used by this theory engine.
    */
   theory::TheoryModel* getModel();
+  /**
+   * Called on reset-assertions. Clears the information kept by model
+   * building across calls.
+   */
+  void notifyResetAssertions();
   /**
    * Get the current model for the current set of assertions. This method
    * should only be called immediately after a satisfiable or unknown
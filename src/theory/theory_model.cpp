@@ -21,6 +21,7 @@
 #include "options/uf_options.h"
 #include "smt/env.h"
 #include "smt/solver_engine.h"
+#include "theory/theory_model_builder.h"
 #include "theory/trust_substitutions.h"
 #include "util/rational.h"
 
@@ -36,7 +37,8 @@ TheoryModel::TheoryModel(Env& env, std::string name, bool enableFuncModels)
       d_name(name),
       d_equalityEngine(nullptr),
       d_using_model_core(false),
-      d_enableFuncModels(enableFuncModels)
+      d_enableFuncModels(enableFuncModels),
+      d_lazyFuncBuilder(nullptr)
 {
   // must use function models when ufHo is enabled
   Assert(d_enableFuncModels || !logicInfo().isHigherOrder());
@@ -86,6 +88,7 @@ void TheoryModel::reset(){
   d_uf_terms.clear();
   d_ho_uf_terms.clear();
   d_uf_models.clear();
+  d_lazyFuncBuilder = nullptr;
   d_using_model_core = false;
   d_model_core.clear();
 }
@@ -331,6 +334,11 @@ Node TheoryModel::getModelValue(TNode n) const
       if (d_enableFuncModels)
       {
         std::map<Node, Node>::const_iterator entry = d_uf_models.find(n);
+        if (entry == d_uf_models.end() && d_lazyFuncBuilder != nullptr
+            && d_lazyFuncBuilder->assignLazyFunction(n))
+        {
+          entry = d_uf_models.find(n);
+        }
         if (entry != d_uf_models.end())
         {
           // Existing function
@@ -35,6 +35,8 @@ class Env;
 
 namespace theory {
 
+class TheoryEngineModelBuilder;
+
 /** Theory Model class.
  *
  * This class represents a model produced by the TheoryEngine.
@@ -400,6 +402,11 @@ class TheoryModel : protected EnvObj
   /** Get model value function.
    *
    * This function is a helper function for getValue.
+   *
+   * If function values are assigned lazily (see d_lazyFuncBuilder), this
+   * assigns the definition of a function in d_uf_models when its value is
+   * first needed. This does not change the model as observed through its
+   * interface, hence this method is const.
    */
   Node getModelValue(TNode n) const;
   /** add term internal
@@ -432,8 +439,16 @@ class TheoryModel : protected EnvObj
   /** map from function terms to the (lambda) definitions
   * After the model is built, the domain of this map is all terms of function
   * type that appear as terms in d_equalityEngine.
+  *
+  * This is mutable since, if function values are assigned lazily, the
+  * definitions are added by the const method getModelValue.
   */
-  std::map<Node, Node> d_uf_models;
+  mutable std::map<Node, Node> d_uf_models;
+  /**
+   * The model builder that assigns the definitions of the functions that are
+   * not in d_uf_models yet when their values are needed, if any.
+   */
+  TheoryEngineModelBuilder* d_lazyFuncBuilder;
   //---------------------------- end function values
 };/* class TheoryModel */
 
@@ -33,7 +33,21 @@ using namespace cvc5::context;
 namespace cvc5 {
 namespace theory {
 
-TheoryEngineModelBuilder::TheoryEngineModelBuilder(Env& env) : EnvObj(env) {}
+TheoryEngineModelBuilder::Statistics::Statistics(StatisticsRegistry& sr)
+    : d_collectTime(sr.registerTimer("theory::model::collectTime")),
+      d_assignTime(sr.registerTimer("theory::model::assignTime")),
+      d_functionsTime(sr.registerTimer("theory::model::functionsTime")),
+      d_reusedValues(sr.registerInt("theory::model::reusedValues")),
+      d_reusedFunctions(sr.registerInt("theory::model::reusedFunctions")),
+      d_assignedFunctions(
+          sr.registerInt("theory::model::assignedFunctions"))
+{
+}
+
+TheoryEngineModelBuilder::TheoryEngineModelBuilder(Env& env)
+    : EnvObj(env), d_lazyModel(nullptr), d_stats(statisticsRegistry())
+{
+}
 
 void TheoryEngineModelBuilder::Assigner::initialize(
     TypeNode tn, TypeEnumeratorProperties* tep, const std::vector<Node>& aes)
@@ -379,6 +393,8 @@ void TheoryEngineModelBuilder::addToTypeList(
 bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
 {
   Trace("model-builder") << "TheoryEngineModelBuilder: buildModel" << std::endl;
+  d_lazyModel = nullptr;
+  d_lazyFunctions.clear();
 
   Trace("model-builder")
       << "TheoryEngineModelBuilder: Preprocess build model..." << std::endl;
@@ -439,7 +455,16 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
   // assigner object with (all elements in the range of this map are in the
   // domain of eqcToAssigner).
   std::map<Node, Node> eqcToAssignerMaster;
-
+  // Whether we reuse the values of the last model (see d_enumeratedValues).
+  // This is not done for finite model finding, where the values of
+  // uninterpreted sorts are restricted by the number of equivalence classes.
+  bool reuseValues =
+      options().theory.modelReuseValues && !options::finiteModelFind();
+  // The values in the last model of the equivalence classes that have no
+  // representative.
+  std::map<Node, Node> prevValues;
+
+  d_stats.d_collectTime.start();
   // Loop through equivalence classes of the equality engine of the model.
   eq::EqualityEngine* ee = tm->d_equalityEngine;
   NodeSet assignableCache;
@@ -478,6 +503,9 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
     // were assigned (see the argument group of
     // TheoryModel::getAssignmentExclusionSet).
     std::vector<Node> esetGroup;
+    // The value of a term of this equivalence class in the last model, if it
+    // was assigned by type enumeration.
+    Node prevValue;
 
     // Loop through terms in this EC
     eq::EqClassIterator eqc_i = eq::EqClassIterator(eqc, ee);
@@ -524,6 +552,14 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
         Trace("model-builder")
             << "  Rep( " << eqc << " ) = " << rep << std::endl;
       }
+      if (reuseValues && prevValue.isNull())
+      {
+        NodeMap::const_iterator itp = d_enumeratedValues.find(n);
+        if (itp != d_enumeratedValues.end())
+        {
+          prevValue = itp->second;
+        }
+      }
 
       // (3) Finally, process assignable information
       if (!isAssignable(n))
@@ -598,6 +634,10 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
       typeNoRepSet.add(eqct, eqc);
       std::unordered_set<TypeNode> visiting;
       addToTypeList(eqct, type_list, visiting);
+      if (!prevValue.isNull())
+      {
+        prevValues[eqc] = prevValue;
+      }
     }
 
     if (assignable)
@@ -652,6 +692,9 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
   }
 
   // Now finished initialization
+  d_stats.d_collectTime.stop();
+  d_stats.d_assignTime.start();
+  NodeMap enumeratedValues;
 
   // Compute type enumerator properties. This code ensures we do not
   // enumerate terms that have uninterpreted constants that violate the
@@ -871,6 +914,7 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
       bool assignable, evaluable CVC5_UNUSED;
       std::map<Node, Assigner>::iterator itAssigner;
       std::map<Node, Node>::iterator itAssignerM;
+      std::map<Node, Node>::iterator itPrev;
       set<Node>* repSet = typeRepSet.getSet(t);
       for (i = noRepSet.begin(); i != noRepSet.end();)
       {
@@ -931,8 +975,25 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
             // assign uninterpreted constants to equivalence classes in its
             // collectModelValues method. Doing so would have the same effect
             // as running the code in this case.
-            bool success;
-            do
+            // If the equivalence class had a value in the last model that is
+            // still unused, we take it again. We only do this for values
+            // without subterms, which could otherwise be used by other
+            // equivalence classes.
+            itPrev = prevValues.find(*i2);
+            if (itPrev != prevValues.end() && !isCorecursive
+                && itPrev->second.getNumChildren() == 0
+                && itPrev->second.getType().isSubtypeOf(t))
+            {
+              std::set<Node>* used = typeConstSet.getSet(tb);
+              if (used == nullptr || used->find(itPrev->second) == used->end())
+              {
+                n = itPrev->second;
+                typeConstSet.add(tb, n);
+                ++d_stats.d_reusedValues;
+              }
+            }
+            bool success = !n.isNull();
+            while (!success)
             {
               Trace("model-builder-debug") << "Enumerate term of type " << t
                                            << std::endl;
@@ -979,8 +1040,9 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
                 }
               }
               //---
-            } while (!success);
+            }
             Assert(!n.isNull());
+            enumeratedValues[*i2] = n;
           }
           else
           {
@@ -1033,6 +1095,9 @@ bool TheoryEngineModelBuilder::buildModel(TheoryModel* tm)
   }
 #endif /* CVC5_ASSERTIONS */
 
+  d_stats.d_assignTime.stop();
+  d_enumeratedValues.swap(enumeratedValues);
+
   Trace("model-builder") << "Copy representatives to model..." << std::endl;
   tm->d_reps.clear();
   std::map<Node, Node>::iterator itMap;
@@ -1228,8 +1293,9 @@ bool TheoryEngineModelBuilder::processBuildModel(TheoryModel* m)
 void TheoryEngineModelBuilder::assignFunction(TheoryModel* m, Node f)
 {
   Assert(!logicInfo().isHigherOrder());
-  uf::UfModelTree ufmt(f);
-  Node default_v;
+  ++d_stats.d_assignedFunctions;
+  // compute the points of the interpretation of f
+  std::vector<Node> points;
   for (size_t i = 0; i < m->d_uf_terms[f].size(); i++)
   {
     Node un = m->d_uf_terms[f][i];
@@ -1244,8 +1310,25 @@ void TheoryEngineModelBuilder::assignFunction(TheoryModel* m, Node f)
       Assert(rc.isConst());
       children.push_back(rc);
     }
-    Node simp = NodeManager::currentNM()->mkNode(un.getKind(), children);
-    Node v = m->getRepresentative(un);
+    points.push_back(NodeManager::currentNM()->mkNode(un.getKind(), children));
+    points.push_back(m->getRepresentative(un));
+  }
+  // the interpretation only depends on the points, reuse it if they did not
+  // change since the last model
+  FunctionValue& fv = d_functionValues[f];
+  if (!fv.d_value.isNull() && fv.d_points == points)
+  {
+    Trace("model-builder") << "  Reuse value of " << f << endl;
+    ++d_stats.d_reusedFunctions;
+    m->assignFunctionDefinition(f, fv.d_value);
+    return;
+  }
+  uf::UfModelTree ufmt(f);
+  Node default_v;
+  for (size_t i = 0; i < points.size(); i += 2)
+  {
+    Node simp = points[i];
+    Node v = points[i + 1];
     Trace("model-builder") << "  Setting (" << simp << ") to (" << v << ")"
                            << endl;
     ufmt.setValue(m, simp, v);
@@ -1266,6 +1349,8 @@ void TheoryEngineModelBuilder::assignFunction(TheoryModel* m, Node f)
   std::stringstream ss;
   ss << "_arg_";
   Node val = ufmt.getFunctionValue(ss.str().c_str(), condenseFuncValues);
+  fv.d_points = std::move(points);
+  fv.d_value = val;
   m->assignFunctionDefinition(f, val);
   // ufmt.debugPrint( std::cout, m );
 }
@@ -1273,6 +1358,7 @@ void TheoryEngineModelBuilder::assignFunction(TheoryModel* m, Node f)
 void TheoryEngineModelBuilder::assignHoFunction(TheoryModel* m, Node f)
 {
   Assert(logicInfo().isHigherOrder());
+  ++d_stats.d_assignedFunctions;
   TypeNode type = f.getType();
   std::vector<TypeNode> argTypes = type.getArgTypes();
   std::vector<Node> args;
@@ -1393,6 +1479,7 @@ void TheoryEngineModelBuilder::assignFunctions(TheoryModel* m)
   {
     return;
   }
+  CodeTimer codeTimer(d_stats.d_functionsTime);
   Trace("model-builder") << "Assigning function values..." << std::endl;
   std::vector<Node> funcs_to_assign = m->getFunctionsToAssign();
 
@@ -1416,6 +1503,17 @@ void TheoryEngineModelBuilder::assignFunctions(TheoryModel* m)
     }
   }
 
+  if (options().theory.lazyFunctionValues && !logicInfo().isHigherOrder())
+  {
+    // the values of functions are independent of each other, they are
+    // constructed when needed by assignLazyFunction
+    Trace("model-builder") << "...assign them lazily." << std::endl;
+    d_lazyModel = m;
+    d_lazyFunctions.insert(funcs_to_assign.begin(), funcs_to_assign.end());
+    m->d_lazyFuncBuilder = this;
+    return;
+  }
+
   // construct function values
   for (unsigned k = 0; k < funcs_to_assign.size(); k++)
   {
@@ -1439,5 +1537,27 @@ void TheoryEngineModelBuilder::assignFunctions(TheoryModel* m)
   Trace("model-builder") << "Finished assigning function values." << std::endl;
 }
 
+bool TheoryEngineModelBuilder::assignLazyFunction(Node f)
+{
+  if (d_lazyFunctions.erase(f) == 0)
+  {
+    return false;
+  }
+  Assert(d_lazyModel != nullptr);
+  CodeTimer codeTimer(d_stats.d_functionsTime);
+  Trace("model-builder") << "Assign function value for " << f << " lazily"
+                         << std::endl;
+  assignFunction(d_lazyModel, f);
+  return true;
+}
+
+void TheoryEngineModelBuilder::notifyResetAssertions()
+{
+  d_enumeratedValues.clear();
+  d_functionValues.clear();
+  d_lazyModel = nullptr;
+  d_lazyFunctions.clear();
+}
+
 }  // namespace theory
 }  // namespace cvc5
@@ -23,6 +23,7 @@
 
 #include "smt/env_obj.h"
 #include "theory/theory_model.h"
+#include "util/statistics_stats.h"
 
 namespace cvc5 {
 
@@ -88,6 +89,21 @@ class TheoryEngineModelBuilder : protected EnvObj
    */
   void postProcessModel(bool incomplete, TheoryModel* m);
 
+  /**
+   * If the option lazyFunctionValues is true, the functions of the model of
+   * the last call to buildModel are assigned their values only when they are
+   * needed, by calls to this method from the model.
+   *
+   * @param f The function whose value is needed
+   * @return true if f was assigned a value by this call.
+   */
+  bool assignLazyFunction(Node f);
+  /**
+   * Called on reset-assertions. Clears the values and interpretations kept
+   * from the last call to buildModel, which are not reused afterwards.
+   */
+  void notifyResetAssertions();
+
  protected:
 
   //-----------------------------------virtual functions
@@ -222,6 +238,54 @@ class TheoryEngineModelBuilder : protected EnvObj
   /** mapping from terms to the constant associated with their equivalence class
    */
   std::map<Node, Node> d_constantReps;
+  /**
+   * Mapping from equivalence classes that were assigned a value by type
+   * enumeration in the last call to buildModel to that value. If the option
+   * modelReuseValues is true, an equivalence class containing one of these
+   * terms is given the same value again in the next call, if that value is
+   * still unused.
+   */
+  NodeMap d_enumeratedValues;
+  /** The interpretation of a function computed by assignFunction */
+  struct FunctionValue
+  {
+    /**
+     * The points of the interpretation, as a list of (f c1 ... cn), v, where
+     * c1 ... cn and v are constants, in the order they were added.
+     */
+    std::vector<Node> d_points;
+    /** The interpretation built from d_points */
+    Node d_value;
+  };
+  /**
+   * The interpretations of functions computed in the last call to
+   * assignFunctions. The interpretation of a function is only rebuilt if its
+   * points have changed.
+   */
+  std::unordered_map<Node, FunctionValue> d_functionValues;
+  /** The model whose functions are assigned by assignLazyFunction */
+  TheoryModel* d_lazyModel;
+  /** The functions of d_lazyModel that are not assigned yet */
+  NodeSet d_lazyFunctions;
+
+  /** Statistics of the phases of model building */
+  struct Statistics
+  {
+    Statistics(StatisticsRegistry& sr);
+    /** Time spent collecting the equivalence classes of the model */
+    TimerStat d_collectTime;
+    /** Time spent assigning values to equivalence classes */
+    TimerStat d_assignTime;
+    /** Time spent assigning interpretations to functions */
+    TimerStat d_functionsTime;
+    /** Number of equivalence classes that kept their previous value */
+    IntStat d_reusedValues;
+    /** Number of function interpretations that were not rebuilt */
+    IntStat d_reusedFunctions;
+    /** Number of functions that were assigned an interpretation */
+    IntStat d_assignedFunctions;
+  };
+  Statistics d_stats;
 
   /** Theory engine model builder assigner class
    *
@@ -35,7 +35,11 @@ EqualityEngine::Statistics::Statistics(const std::string& name)
       d_functionTermsCount(
           smtStatisticsRegistry().registerInt(name + "functionTermsCount")),
       d_constantTermsCount(
-          smtStatisticsRegistry().registerInt(name + "constantTermsCount"))
+          smtStatisticsRegistry().registerInt(name + "constantTermsCount")),
+      d_explanationsCount(
+          smtStatisticsRegistry().registerInt(name + "explanationsCount")),
+      d_explanationCacheHits(
+          smtStatisticsRegistry().registerInt(name + "explanationCacheHits"))
 {
 }
 
@@ -125,6 +129,7 @@ EqualityEngine::EqualityEngine(Env& env,
       d_deducedDisequalitiesSize(c, 0),
       d_deducedDisequalityReasonsSize(c, 0),
       d_propagatedDisequalities(c),
+      d_explanationCacheKeysSize(c, 0),
       d_name(name)
 {
   init();
@@ -157,6 +162,7 @@ EqualityEngine::EqualityEngine(Env& env,
       d_deducedDisequalitiesSize(c, 0),
       d_deducedDisequalityReasonsSize(c, 0),
       d_propagatedDisequalities(c),
+      d_explanationCacheKeysSize(c, 0),
       d_name(name)
 {
   init();
@@ -205,8 +211,8 @@ EqualityNodeId EqualityEngine::newApplicationNode(TNode original, EqualityNodeId
   EqualityNodeId funId = newNode(original);
   FunctionApplication funOriginal(type, t1, t2);
   // The function application we're creating
-  EqualityNodeId t1ClassId = getEqualityNode(t1).getFind();
-  EqualityNodeId t2ClassId = getEqualityNode(t2).getFind();
+  EqualityNodeId t1ClassId = getFind(t1);
+  EqualityNodeId t2ClassId = getFind(t2);
   FunctionApplication funNormalized(type, t1ClassId, t2ClassId);
 
   Debug("equality") << d_name << "::eq::newApplicationNode: funOriginal: ("
@@ -254,7 +260,7 @@ EqualityNodeId EqualityEngine::newNode(TNode node) {
 
   // Register the new id of the term
   EqualityNodeId newId = d_nodes.size();
-  d_nodeIds[node] = newId;
+  d_nodeIds.push_back(node, newId);
   // Add the node to it's position
   d_nodes.push_back(node);
   // Note if this is an application or not
@@ -275,6 +281,7 @@ EqualityNodeId EqualityEngine::newNode(TNode node) {
   d_isInternal.push_back(true);
   // Add the equality node to the nodes
   d_equalityNodes.push_back(EqualityNode(newId));
+  d_findIds.push_back(newId);
 
   // Increase the counters
   d_nodesCount = d_nodesCount + 1;
@@ -432,13 +439,11 @@ void EqualityEngine::addTermInternal(TNode t, bool isOperator) {
   Debug("equality") << d_name << "::eq::addTermInternal(" << t << ") => " << result << std::endl;
 }
 
-bool EqualityEngine::hasTerm(TNode t) const {
-  return d_nodeIds.find(t) != d_nodeIds.end();
-}
+bool EqualityEngine::hasTerm(TNode t) const { return d_nodeIds.contains(t); }
 
 EqualityNodeId EqualityEngine::getNodeId(TNode node) const {
   Assert(hasTerm(node)) << node;
-  return (*d_nodeIds.find(node)).second;
+  return d_nodeIds[node];
 }
 
 EqualityNode& EqualityEngine::getEqualityNode(TNode t) {
@@ -531,8 +536,8 @@ bool EqualityEngine::assertEquality(TNode eq,
     // If both have constant representatives, we don't notify anyone
     EqualityNodeId a = getNodeId(eq[0]);
     EqualityNodeId b = getNodeId(eq[1]);
-    EqualityNodeId aClassId = getEqualityNode(a).getFind();
-    EqualityNodeId bClassId = getEqualityNode(b).getFind();
+    EqualityNodeId aClassId = getFind(a);
+    EqualityNodeId bClassId = getFind(b);
     if (d_isConstant[aClassId] && d_isConstant[bClassId]) {
       return true;
     }
@@ -592,32 +597,32 @@ bool EqualityEngine::assertEquality(TNode eq,
 TNode EqualityEngine::getRepresentative(TNode t) const {
   Debug("equality::internal") << d_name << "::eq::getRepresentative(" << t << ")" << std::endl;
   Assert(hasTerm(t));
-  EqualityNodeId representativeId = getEqualityNode(t).getFind();
+  EqualityNodeId representativeId = getFind(t);
   Assert(!d_isInternal[representativeId]);
   Debug("equality::internal") << d_name << "::eq::getRepresentative(" << t << ") => " << d_nodes[representativeId] << std::endl;
   return d_nodes[representativeId];
 }
 
-bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vector<TriggerId>& triggersFired) {
-
-  Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << ")" << std::endl;
+bool EqualityEngine::merge(EqualityNodeId class1Id,
+                           EqualityNodeId class2Id,
+                           std::vector<TriggerId>& triggersFired)
+{
+  Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << ")" << std::endl;
 
   Assert(triggersFired.empty());
 
   ++d_stats.d_mergesCount;
 
-  EqualityNodeId class1Id = class1.getFind();
-  EqualityNodeId class2Id = class2.getFind();
+  EqualityNode& class1 = getEqualityNode(class1Id);
+  EqualityNode& class2 = getEqualityNode(class2Id);
 
   Node n1 = d_nodes[class1Id];
   Node n2 = d_nodes[class2Id];
-  EqualityNode cc1 = getEqualityNode(n1);
-  EqualityNode cc2 = getEqualityNode(n2);
   bool doNotify = false;
   // Determine if we should notify the owner of this class of this merge.
   // The second part of this check is needed due to the internal implementation
   // of this class. It ensures that we are merging terms and not operators.
-  if (class1Id == cc1.getFind() && class2Id == cc2.getFind())
+  if (class1Id == getFind(n1) && class2Id == getFind(n2))
   {
     doNotify = true;
   }
@@ -658,15 +663,15 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   }
 
   // Update class2 representative information
-  Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): updating class " << class2Id << std::endl;
+  Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): updating class " << class2Id << std::endl;
   EqualityNodeId currentId = class2Id;
   do {
     // Get the current node
     EqualityNode& currentNode = getEqualityNode(currentId);
 
     // Update it's find to class1 id
-    Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): " << currentId << "->" << class1Id << std::endl;
-    currentNode.setFind(class1Id);
+    Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): " << currentId << "->" << class1Id << std::endl;
+    d_findIds[currentId] = class1Id;
 
     // Go through the triggers and inform if necessary
     TriggerId currentTrigger = d_nodeTriggers[currentId];
@@ -698,11 +703,11 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   // Update class2 table lookup and information if not a boolean
   // since booleans can't be in an application
   if (!d_isEquality[class2Id]) {
-    Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): updating lookups of " << class2Id << std::endl;
+    Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): updating lookups of " << class2Id << std::endl;
     do {
       // Get the current node
       EqualityNode& currentNode = getEqualityNode(currentId);
-      Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): updating lookups of node " << currentId << std::endl;
+      Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): updating lookups of node " << currentId << std::endl;
 
       // Go through the uselist and check for congruences
       UseListNodeId currentUseId = currentNode.getUseList();
@@ -711,7 +716,7 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
         UseListNode& useNode = d_useListNodes[currentUseId];
         // Get the function application
         EqualityNodeId funId = useNode.getApplicationId();
-        Debug("equality") << d_name << "::eq::merge(" << class1.getFind() << "," << class2.getFind() << "): " << d_nodes[currentId] << " in " << d_nodes[funId] << std::endl;
+        Debug("equality") << d_name << "::eq::merge(" << class1Id << "," << class2Id << "): " << d_nodes[currentId] << " in " << d_nodes[funId] << std::endl;
         const FunctionApplication& fun =
             d_applications[useNode.getApplicationId()].d_normalized;
         // If it's interpreted and we can interpret
@@ -722,13 +727,13 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
           subtermEvaluates(getNodeId(term));
         }
         // Check if there is an application with find arguments
-        EqualityNodeId aNormalized = getEqualityNode(fun.d_a).getFind();
-        EqualityNodeId bNormalized = getEqualityNode(fun.d_b).getFind();
+        EqualityNodeId aNormalized = getFind(fun.d_a);
+        EqualityNodeId bNormalized = getFind(fun.d_b);
         FunctionApplication funNormalized(fun.d_type, aNormalized, bNormalized);
         ApplicationIdsMap::iterator find = d_applicationLookup.find(funNormalized);
         if (find != d_applicationLookup.end()) {
           // Applications fun and the funNormalized can be merged due to congruence
-          if (getEqualityNode(funId).getFind() != getEqualityNode(find->second).getFind()) {
+          if (getFind(funId) != getFind(find->second)) {
             enqueue(MergeCandidate(funId, find->second, MERGED_THROUGH_CONGRUENCE, TNode::null()));
           }
         } else {
@@ -834,22 +839,25 @@ bool EqualityEngine::merge(EqualityNode& class1, EqualityNode& class2, std::vect
   return true;
 }
 
-void EqualityEngine::undoMerge(EqualityNode& class1, EqualityNode& class2, EqualityNodeId class2Id) {
+void EqualityEngine::undoMerge(EqualityNodeId class1Id, EqualityNodeId class2Id)
+{
+  Debug("equality") << d_name << "::eq::undoMerge(" << class1Id << "," << class2Id << ")" << std::endl;
 
-  Debug("equality") << d_name << "::eq::undoMerge(" << class1.getFind() << "," << class2Id << ")" << std::endl;
+  EqualityNode& class1 = getEqualityNode(class1Id);
+  EqualityNode& class2 = getEqualityNode(class2Id);
 
   // Now unmerge the lists (same as merge)
   class1.merge<false>(class2);
 
   // Update class2 representative information
   EqualityNodeId currentId = class2Id;
-  Debug("equality") << d_name << "::eq::undoMerge(" << class1.getFind() << "," << class2Id << "): undoing representative info" << std::endl;
+  Debug("equality") << d_name << "::eq::undoMerge(" << class1Id << "," << class2Id << "): undoing representative info" << std::endl;
   do {
     // Get the current node
     EqualityNode& currentNode = getEqualityNode(currentId);
 
     // Update it's find to class1 id
-    currentNode.setFind(class2Id);
+    d_findIds[currentId] = class2Id;
 
     // Go through the trigger list (if any) and undo the class
     TriggerId currentTrigger = d_nodeTriggers[currentId];
@@ -886,8 +894,7 @@ void EqualityEngine::backtrack() {
       // Undo the merge
       if (eq.d_lhs != null_id)
       {
-        undoMerge(
-            d_equalityNodes[eq.d_lhs], d_equalityNodes[eq.d_rhs], eq.d_rhs);
+        undoMerge(eq.d_lhs, eq.d_rhs);
       }
     }
 
@@ -942,9 +949,7 @@ void EqualityEngine::backtrack() {
   if (d_nodes.size() > d_nodesCount) {
     // Go down the nodes, check the application nodes and remove them from use-lists
     for(int i = d_nodes.size() - 1, i_end = (int)d_nodesCount; i >= i_end; -- i) {
-      // Remove from the node -> id map
       Debug("equality") << d_name << "::eq::backtrack(): removing node " << d_nodes[i] << std::endl;
-      d_nodeIds.erase(d_nodes[i]);
 
       const FunctionApplication& app = d_applications[i].d_original;
       if (!app.isNull()) {
@@ -966,6 +971,8 @@ void EqualityEngine::backtrack() {
     d_isInternal.resize(d_nodesCount);
     d_equalityGraph.resize(d_nodesCount);
     d_equalityNodes.resize(d_nodesCount);
+    d_findIds.resize(d_nodesCount);
+    d_nodeIds.pop_to_size(d_nodesCount);
   }
 
   if (d_deducedDisequalities.size() > d_deducedDisequalitiesSize) {
@@ -982,6 +989,18 @@ void EqualityEngine::backtrack() {
     d_deducedDisequalities.resize(d_deducedDisequalitiesSize);
   }
 
+  if (d_explanationCacheKeys.size() > d_explanationCacheKeysSize)
+  {
+    size_t keysSize = d_explanationCacheKeysSize;
+    EqualityPair first = d_explanationCacheKeys[keysSize];
+    d_explanationReasons.resize(d_explanationCache[first].first);
+    for (size_t i = keysSize, size = d_explanationCacheKeys.size(); i < size;
+         ++i)
+    {
+      d_explanationCache.erase(d_explanationCacheKeys[i]);
+    }
+    d_explanationCacheKeys.resize(keysSize);
+  }
 }
 
 void EqualityEngine::addGraphEdge(EqualityNodeId t1, EqualityNodeId t2, unsigned type, TNode reason) {
@@ -1355,6 +1374,17 @@ void EqualityEngine::getExplanation(
     {
       return;
     }
+    ExplanationCache::const_iterator itc = d_explanationCache.find(cacheKey);
+    if (itc != d_explanationCache.end())
+    {
+      ++d_stats.d_explanationCacheHits;
+      equalities.insert(equalities.end(),
+                        d_explanationReasons.begin() + itc->second.first,
+                        d_explanationReasons.begin() + itc->second.second);
+      cache[cacheKey] = nullptr;
+      return;
+    }
+    ++d_stats.d_explanationsCount;
   }
   else
   {
@@ -1384,17 +1414,20 @@ void EqualityEngine::getExplanation(
       return;
     }
   }
+  // whether to store the explanation in the explanation cache
+  bool storeExplanation = !eqp && cache.empty() && !d_done;
+  size_t equalitiesStart = equalities.size();
   cache[cacheKey] = eqp;
 
   // We can only explain the nodes that got merged
 #ifdef CVC5_ASSERTIONS
-  bool canExplain = getEqualityNode(t1Id).getFind() == getEqualityNode(t2Id).getFind()
+  bool canExplain = getFind(t1Id) == getFind(t2Id)
                   || (d_done && isConstant(t1Id) && isConstant(t2Id));
 
   if (!canExplain) {
     Warning() << "Can't explain equality:" << std::endl;
-    Warning() << d_nodes[t1Id] << " with find " << d_nodes[getEqualityNode(t1Id).getFind()] << std::endl;
-    Warning() << d_nodes[t2Id] << " with find " << d_nodes[getEqualityNode(t2Id).getFind()] << std::endl;
+    Warning() << d_nodes[t1Id] << " with find " << d_nodes[getFind(t1Id)] << std::endl;
+    Warning() << d_nodes[t2Id] << " with find " << d_nodes[getFind(t2Id)] << std::endl;
   }
   Assert(canExplain);
 #endif
@@ -1603,7 +1636,7 @@ void EqualityEngine::getExplanation(
                 std::shared_ptr<EqProof> eqpcc =
                     eqpc ? std::make_shared<EqProof>() : nullptr;
                 getExplanation(childId,
-                               getEqualityNode(childId).getFind(),
+                               getFind(childId),
                                equalities,
                                cache,
                                eqpcc.get());
@@ -1697,6 +1730,18 @@ void EqualityEngine::getExplanation(
             }
           }
 
+          if (storeExplanation)
+          {
+            size_t start = d_explanationReasons.size();
+            d_explanationReasons.insert(d_explanationReasons.end(),
+                                        equalities.begin() + equalitiesStart,
+                                        equalities.end());
+            d_explanationCache[cacheKey] =
+                std::make_pair(start, d_explanationReasons.size());
+            d_explanationCacheKeys.push_back(cacheKey);
+            d_explanationCacheKeysSize = d_explanationCacheKeys.size();
+          }
+
           // Done
           return;
         }
@@ -1803,13 +1848,13 @@ void EqualityEngine::addTriggerEqualityInternal(TNode t1, TNode t2, TNode trigge
 
   // Get the information about t1
   EqualityNodeId t1Id = getNodeId(t1);
-  EqualityNodeId t1classId = getEqualityNode(t1Id).getFind();
+  EqualityNodeId t1classId = getFind(t1Id);
   // We will attach it to the class representative, since then we know how to backtrack it
   TriggerId t1TriggerId = d_nodeTriggers[t1classId];
 
   // Get the information about t2
   EqualityNodeId t2Id = getNodeId(t2);
-  EqualityNodeId t2classId = getEqualityNode(t2Id).getFind();
+  EqualityNodeId t2classId = getFind(t2Id);
   // We will attach it to the class representative, since then we know how to backtrack it
   TriggerId t2TriggerId = d_nodeTriggers[t2classId];
 
@@ -1912,8 +1957,8 @@ void EqualityEngine::propagate() {
     d_propagationQueue.pop_front();
 
     // Get the representatives
-    EqualityNodeId t1classId = getEqualityNode(current.d_t1Id).getFind();
-    EqualityNodeId t2classId = getEqualityNode(current.d_t2Id).getFind();
+    EqualityNodeId t1classId = getFind(current.d_t1Id);
+    EqualityNodeId t2classId = getFind(current.d_t2Id);
 
     // If already the same, we're done
     if (t1classId == t2classId) {
@@ -1927,8 +1972,8 @@ void EqualityEngine::propagate() {
     EqualityNode& node1 = getEqualityNode(t1classId);
     EqualityNode& node2 = getEqualityNode(t2classId);
 
-    Assert(node1.getFind() == t1classId);
-    Assert(node2.getFind() == t2classId);
+    Assert(getFind(t1classId) == t1classId);
+    Assert(getFind(t2classId) == t2classId);
 
     // Add the actual equality to the equality graph
     addGraphEdge(
@@ -1982,7 +2027,7 @@ void EqualityEngine::propagate() {
                         << d_nodes[current.d_t2Id] << std::endl;
       d_assertedEqualities.push_back(Equality(t2classId, t1classId));
       d_assertedEqualitiesCount = d_assertedEqualitiesCount + 1;
-      if (!merge(node2, node1, triggers)) {
+      if (!merge(t2classId, t1classId, triggers)) {
         d_done = true;
       }
     } else {
@@ -1991,7 +2036,7 @@ void EqualityEngine::propagate() {
                         << d_nodes[current.d_t1Id] << std::endl;
       d_assertedEqualities.push_back(Equality(t1classId, t2classId));
       d_assertedEqualitiesCount = d_assertedEqualitiesCount + 1;
-    if (!merge(node1, node2, triggers)) {
+    if (!merge(t1classId, t2classId, triggers)) {
         d_done = true;
       }
     }
@@ -2061,7 +2106,7 @@ void EqualityEngine::debugPrintGraph() const {
   Debug("equality::graph") << std::endl << "Dumping graph" << std::endl;
   for (EqualityNodeId nodeId = 0; nodeId < d_nodes.size(); ++ nodeId) {
 
-    Debug("equality::graph") << d_nodes[nodeId] << " " << nodeId << "(" << getEqualityNode(nodeId).getFind() << "):";
+    Debug("equality::graph") << d_nodes[nodeId] << " " << nodeId << "(" << getFind(nodeId) << "):";
 
     EqualityEdgeId edgeId = d_equalityGraph[nodeId];
     while (edgeId != null_edge) {
@@ -2104,7 +2149,7 @@ bool EqualityEngine::areEqual(TNode t1, TNode t2) const {
   Assert(hasTerm(t1));
   Assert(hasTerm(t2));
 
-  bool result = getEqualityNode(t1).getFind() == getEqualityNode(t2).getFind();
+  bool result = getFind(t1) == getFind(t2);
   Debug("equality") << (result ? "\t(YES)" : "\t(NO)") << std::endl;
   return result;
 }
@@ -2128,8 +2173,8 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
   }
 
   // Get equivalence classes
-  EqualityNodeId t1ClassId = getEqualityNode(t1Id).getFind();
-  EqualityNodeId t2ClassId = getEqualityNode(t2Id).getFind();
+  EqualityNodeId t1ClassId = getFind(t1Id);
+  EqualityNodeId t2ClassId = getFind(t2Id);
 
   // We are semantically const, for remembering stuff
   EqualityEngine* nonConst = const_cast<EqualityEngine*>(this);
@@ -2149,7 +2194,7 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
   FunctionApplication eqNormalized(APP_EQUALITY, t1ClassId, t2ClassId);
   ApplicationIdsMap::const_iterator find = d_applicationLookup.find(eqNormalized);
   if (find != d_applicationLookup.end()) {
-    if (getEqualityNode(find->second).getFind() == getEqualityNode(d_falseId).getFind()) {
+    if (getFind(find->second) == getFind(d_falseId)) {
       if (ensureProof) {
         const FunctionApplication original =
             d_applications[find->second].d_original;
@@ -2169,7 +2214,7 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
   std::swap(eqNormalized.d_a, eqNormalized.d_b);
   find = d_applicationLookup.find(eqNormalized);
   if (find != d_applicationLookup.end()) {
-    if (getEqualityNode(find->second).getFind() == getEqualityNode(d_falseId).getFind()) {
+    if (getFind(find->second) == getFind(d_falseId)) {
       if (ensureProof) {
         const FunctionApplication original =
             d_applications[find->second].d_original;
@@ -2193,7 +2238,7 @@ bool EqualityEngine::areDisequal(TNode t1, TNode t2, bool ensureProof) const
 size_t EqualityEngine::getSize(TNode t) {
   // Add the term
   addTermInternal(t);
-  return getEqualityNode(getEqualityNode(t).getFind()).getSize();
+  return getEqualityNode(getFind(t)).getSize();
 }
 
 std::string EqualityEngine::identify() const { return d_name; }
@@ -2219,8 +2264,7 @@ void EqualityEngine::addTriggerTerm(TNode t, TheoryId tag)
 
   // Get the node id
   EqualityNodeId eqNodeId = getNodeId(t);
-  EqualityNode& eqNode = getEqualityNode(eqNodeId);
-  EqualityNodeId classId = eqNode.getFind();
+  EqualityNodeId classId = getFind(eqNodeId);
 
   // Possibly existing set of triggers
   TriggerTermSetRef triggerSetRef = d_nodeIndividualTrigger[classId];
@@ -2291,7 +2335,7 @@ void EqualityEngine::addTriggerTerm(TNode t, TheoryId tag)
 
 bool EqualityEngine::isTriggerTerm(TNode t, TheoryId tag) const {
   if (!hasTerm(t)) return false;
-  EqualityNodeId classId = getEqualityNode(t).getFind();
+  EqualityNodeId classId = getFind(t);
   TriggerTermSetRef triggerSetRef = d_nodeIndividualTrigger[classId];
   return triggerSetRef != +null_set_id && getTriggerTermSet(triggerSetRef).hasTrigger(tag);
 }
@@ -2299,7 +2343,7 @@ bool EqualityEngine::isTriggerTerm(TNode t, TheoryId tag) const {
 
 TNode EqualityEngine::getTriggerTermRepresentative(TNode t, TheoryId tag) const {
   Assert(isTriggerTerm(t, tag));
-  EqualityNodeId classId = getEqualityNode(t).getFind();
+  EqualityNodeId classId = getFind(t);
   const TriggerTermSet& triggerSet = getTriggerTermSet(d_nodeIndividualTrigger[classId]);
   unsigned i = 0;
   TheoryIdSet tags = triggerSet.d_tags;
@@ -2335,7 +2379,7 @@ void EqualityEngine::storeApplicationLookup(FunctionApplication& funNormalized,
 void EqualityEngine::getUseListTerms(TNode t, std::set<TNode>& output) {
   if (hasTerm(t)) {
     // Get the equivalence class
-    EqualityNodeId classId = getEqualityNode(t).getFind();
+    EqualityNodeId classId = getFind(t);
     // Go through the equivalence class and get where t is used in
     EqualityNodeId currentId = classId;
     do {
@@ -2448,8 +2492,8 @@ void EqualityEngine::storePropagatedDisequality(TheoryId tag, EqualityNodeId lhs
     for (unsigned i = ref.d_mergesStart; i < ref.d_mergesEnd; ++i)
     {
       Assert(
-          getEqualityNode(d_deducedDisequalityReasons[i].first).getFind()
-          == getEqualityNode(d_deducedDisequalityReasons[i].second).getFind());
+          getFind(d_deducedDisequalityReasons[i].first)
+          == getFind(d_deducedDisequalityReasons[i].second));
     }
 #endif
     if (Debug.isOn("equality::disequality")) {
@@ -2515,7 +2559,7 @@ void EqualityEngine::getDisequalities(bool allowConstants,
       const FunctionApplication& fun =
           d_applications[useListNode.getApplicationId()].d_original;
       // If it's an equality asserted to false, we do the work
-      if (fun.isEquality() && getEqualityNode(funId).getFind() == getEqualityNode(d_false).getFind()) {
+      if (fun.isEquality() && getFind(funId) == getFind(d_false)) {
         // Get the other equality member
         bool lhs = false;
         EqualityNodeId toCompare = fun.d_b;
@@ -2524,7 +2568,7 @@ void EqualityEngine::getDisequalities(bool allowConstants,
           lhs = true;
         }
         // Representative of the other member
-        EqualityNodeId toCompareRep = getEqualityNode(toCompare).getFind();
+        EqualityNodeId toCompareRep = getFind(toCompare);
         if (toCompareRep == classId) {
           // We're in conflict, so we will send it out from merge
           out.clear();
@@ -2589,7 +2633,7 @@ bool EqualityEngine::propagateTriggerTermDisequalities(
     // Figure out who we are comparing to in the original equality
     EqualityNodeId toCompare = disequalityInfo.d_lhs ? fun.d_a : fun.d_b;
     EqualityNodeId myCompare = disequalityInfo.d_lhs ? fun.d_b : fun.d_a;
-    if (getEqualityNode(toCompare).getFind() == getEqualityNode(myCompare).getFind()) {
+    if (getFind(toCompare) == getFind(myCompare)) {
       // We're propagating a != a, which means we're inconsistent, just bail and let it go into
       // a regular conflict
       return !d_done;
@@ -26,6 +26,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "context/cdflat_hashmap.h"
 #include "context/cdhashmap.h"
 #include "context/cdo.h"
 #include "expr/kind_map.h"
@@ -125,6 +126,10 @@ class EqualityEngine : public context::ContextNotifyObj {
     IntStat d_functionTermsCount;
     /** Number of constant terms managed by the system */
     IntStat d_constantTermsCount;
+    /** Number of explanations of equalities computed without proofs */
+    IntStat d_explanationsCount;
+    /** Number of explanations taken from the explanation cache */
+    IntStat d_explanationCacheHits;
 
     Statistics(const std::string& name);
   };/* struct EqualityEngine::statistics */
@@ -151,8 +156,11 @@ class EqualityEngine : public context::ContextNotifyObj {
   /** The map of kinds with operators to be considered external (for higher-order) */
   KindMap d_congruenceKindsExtOperators;
 
-  /** Map from nodes to their ids */
-  std::unordered_map<TNode, EqualityNodeId> d_nodeIds;
+  /**
+   * Map from nodes to their ids. Since nodes are added and removed in stack
+   * order, this is a flat table whose trail is resized on backtracking.
+   */
+  context::FlatInsertHashMap<TNode, EqualityNodeId> d_nodeIds;
 
   /** Map from function applications to their ids */
   typedef std::unordered_map<FunctionApplication, EqualityNodeId, FunctionApplicationHashFunction> ApplicationIdsMap;
@@ -186,6 +194,13 @@ class EqualityEngine : public context::ContextNotifyObj {
   /** Map from ids to the equality nodes */
   std::vector<EqualityNode> d_equalityNodes;
 
+  /**
+   * Map from ids to the ids of their representatives. This is kept apart from
+   * d_equalityNodes so that find operations, which are the most frequent
+   * accesses, use dense memory.
+   */
+  std::vector<EqualityNodeId> d_findIds;
+
   /** Number of asserted equalities we have so far */
   context::CDO<DefaultSizeType> d_assertedEqualitiesCount;
 
@@ -285,14 +300,29 @@ class EqualityEngine : public context::ContextNotifyObj {
   /** Returns the id of the node */
   EqualityNodeId getNodeId(TNode node) const;
 
+  /** Returns the id of the representative of the node with the given id */
+  EqualityNodeId getFind(EqualityNodeId nodeId) const
+  {
+    Assert(nodeId < d_findIds.size());
+    return d_findIds[nodeId];
+  }
+
+  /** Returns the id of the representative of the given node */
+  EqualityNodeId getFind(TNode node) const
+  {
+    return getFind(getNodeId(node));
+  }
+
   /**
-   * Merge the class2 into class1
+   * Merge the class2 into class1, given the ids of their representatives.
    * @return true if ok, false if to break out
    */
-  bool merge(EqualityNode& class1, EqualityNode& class2, std::vector<TriggerId>& triggers);
+  bool merge(EqualityNodeId class1Id,
+             EqualityNodeId class2Id,
+             std::vector<TriggerId>& triggers);
 
   /** Undo the merge of class2 into class1 */
-  void undoMerge(EqualityNode& class1, EqualityNode& class2, EqualityNodeId class2Id);
+  void undoMerge(EqualityNodeId class1Id, EqualityNodeId class2Id);
 
   /** Backtrack the information if necessary */
   void backtrack();
@@ -378,7 +408,7 @@ class EqualityEngine : public context::ContextNotifyObj {
    * Returns true if it's a constant
    */
   bool isConstant(EqualityNodeId id) const {
-    return d_isConstant[getEqualityNode(id).getFind()];
+    return d_isConstant[getFind(id)];
   }
 
   /**
@@ -398,7 +428,7 @@ class EqualityEngine : public context::ContextNotifyObj {
   void addTriggerToList(EqualityNodeId nodeId, TriggerId triggerId);
 
   /** Statistics */
-  Statistics d_stats;
+  mutable Statistics d_stats;
 
   /** Add a new function application node to the database, i.e APP t1 t2 */
   EqualityNodeId newApplicationNode(TNode original, EqualityNodeId t1, EqualityNodeId t2, FunctionApplicationType type);
@@ -446,7 +476,9 @@ class EqualityEngine : public context::ContextNotifyObj {
    * children such that it is a proof of t1 = t2.
    *
    * We cache results of this call in cache, where cache[t1Id][t2Id] stores
-   * a proof of t1 = t2.
+   * a proof of t1 = t2. If eqp is null and cache is empty, i.e., this is not
+   * a recursive call, the explanation is also stored in the context
+   * dependent explanation cache, which is used by all calls without proofs.
    */
   void getExplanation(
       EqualityEdgeId t1Id,
@@ -602,6 +634,33 @@ class EqualityEngine : public context::ContextNotifyObj {
           PropagatedDisequalitiesMap;
   PropagatedDisequalitiesMap d_propagatedDisequalities;
 
+  /**
+   * Cache of the explanations of equalities computed without proofs, from the
+   * ordered pair of node ids to the range of the reasons of the explanation
+   * in d_explanationReasons. The path between two nodes of the equality graph
+   * does not change until backtracking, hence neither does the explanation.
+   */
+  typedef std::unordered_map<EqualityPair,
+                             std::pair<size_t, size_t>,
+                             EqualityPairHashFunction>
+      ExplanationCache;
+  mutable ExplanationCache d_explanationCache;
+
+  /**
+   * The pairs in the explanation cache, in the order of insertion.
+   */
+  mutable std::vector<EqualityPair> d_explanationCacheKeys;
+
+  /**
+   * Context dependent size of the pairs in the explanation cache.
+   */
+  mutable context::CDO<size_t> d_explanationCacheKeysSize;
+
+  /**
+   * The reasons of the explanations in the explanation cache.
+   */
+  mutable std::vector<TNode> d_explanationReasons;
+
   /**
    * Has this equality been propagated to anyone.
    */
@@ -169,9 +169,11 @@ public:
 /**
  * Main class for representing nodes in the equivalence class. The
  * nodes are a circular list, with the representative carrying the
- * size. Each individual node carries with itself the uselist of
- * function applications it appears in and the list of asserted
- * disequalities it belongs to. In order to get these lists one must
+ * size. The representative of each node is stored separately by the
+ * equality engine, since it is accessed much more often than the rest.
+ * Each individual node carries with itself the uselist of function
+ * applications it appears in and the list of asserted disequalities it
+ * belongs to. In order to get these lists one must
  * traverse the entire class and pick up all the individual lists.
  */
 class EqualityNode {
@@ -181,9 +183,6 @@ private:
   /** The size of this equivalence class (if it's a representative) */
   DefaultSizeType d_size;
 
-  /** The id (in the eq-manager) of the representative equality node */
-  EqualityNodeId d_findId;
-
   /** The next equality node in this class */
   EqualityNodeId d_nextId;
 
@@ -197,7 +196,6 @@ public:
    */
   EqualityNode(EqualityNodeId nodeId = null_id)
   : d_size(1)
-  , d_findId(nodeId)
   , d_nextId(nodeId)
   , d_useList(null_uselist_id)
   {}
@@ -237,16 +235,6 @@ public:
     }
   }
 
-  /**
-   * Returns the class representative.
-   */
-  EqualityNodeId getFind() const { return d_findId; }
-
-  /**
-   * Set the class representative.
-   */
-  void setFind(EqualityNodeId findId) { d_findId = findId; }
-
   /**
    * Note that this node is used in a function application funId, or
    * a negatively asserted equality (dis-equality) with funId.
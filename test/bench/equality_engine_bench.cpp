@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Benchmark of merges, congruence and backtracking in the equality engine on
+ * synthetic UF problems.
+ *
+ * Usage: equality_engine_bench [terms levels]...
+ *
+ * For each pair of arguments (by default 1000 1, 1000 100, 100000 1 and
+ * 100000 100), adds the images f(x_i) of the given number of variables to an
+ * equality engine, merges the variables into a single class by a chain of
+ * equalities, pushing a new context level every terms / levels equalities,
+ * queries the equality of all images, which follows by congruence, and pops
+ * back to level 0. Prints the time of each phase in milliseconds.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "context/context.h"
+#include "expr/node.h"
+#include "expr/node_manager.h"
+#include "expr/skolem_manager.h"
+#include "smt/solver_engine.h"
+#include "theory/uf/equality_engine.h"
+
+using namespace cvc5;
+using namespace cvc5::theory::eq;
+
+namespace {
+
+double ms(std::chrono::steady_clock::duration d)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(d).count()
+         / 1000.0;
+}
+
+/** Runs the benchmark for n terms and the given number of levels. */
+bool run(SolverEngine& slv, size_t n, size_t levels)
+{
+  NodeManager* nm = NodeManager::currentNM();
+  TypeNode u = nm->mkSort("U");
+  SkolemManager* sm = nm->getSkolemManager();
+  Node f = sm->mkDummySkolem("f", nm->mkFunctionType(u, u));
+  std::vector<Node> vars, apps, eqs;
+  for (size_t i = 0; i < n; ++i)
+  {
+    vars.push_back(sm->mkDummySkolem("x", u));
+    apps.push_back(nm->mkNode(kind::APPLY_UF, f, vars.back()));
+    if (i > 0)
+    {
+      eqs.push_back(vars[i - 1].eqNode(vars[i]));
+    }
+  }
+  context::Context context;
+  EqualityEngine ee(slv.getEnv(), &context, "bench::", false);
+  ee.addFunctionKind(kind::APPLY_UF);
+  size_t step = std::max<size_t>(1, n / levels);
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (const Node& app : apps)
+  {
+    ee.addTerm(app);
+  }
+  auto t1 = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < eqs.size(); ++i)
+  {
+    if (i % step == 0)
+    {
+      context.push();
+    }
+    ee.assertEquality(eqs[i], true, eqs[i]);
+  }
+  auto t2 = std::chrono::steady_clock::now();
+  size_t equal = 0;
+  for (const Node& app : apps)
+  {
+    equal += ee.areEqual(apps[0], app);
+  }
+  auto t3 = std::chrono::steady_clock::now();
+  context.popto(0);
+  auto t4 = std::chrono::steady_clock::now();
+
+  std::cout << std::setw(10) << n << std::setw(8) << levels << std::fixed
+            << std::setprecision(1) << std::setw(12) << ms(t1 - t0)
+            << std::setw(12) << ms(t2 - t1) << std::setw(12) << ms(t3 - t2)
+            << std::setw(10) << ms(t4 - t3) << std::endl;
+  // all images are equal by congruence, until the merges are backtracked
+  return equal == n && (n < 2 || !ee.areEqual(apps[0], apps[n - 1]));
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  std::vector<std::pair<size_t, size_t>> runs;
+  for (int i = 1; i + 1 < argc; i += 2)
+  {
+    runs.emplace_back(std::strtoul(argv[i], nullptr, 10),
+                      std::strtoul(argv[i + 1], nullptr, 10));
+  }
+  if (runs.empty())
+  {
+    runs = {{1000, 1}, {1000, 100}, {100000, 1}, {100000, 100}};
+  }
+
+  NodeManager* nm = NodeManager::currentNM();
+  nm->init();
+  SolverEngine slv(nm);
+  slv.finishInit();
+
+  std::cout << std::setw(10) << "terms" << std::setw(8) << "levels"
+            << std::setw(12) << "add (ms)" << std::setw(12) << "merge (ms)"
+            << std::setw(12) << "query (ms)" << std::setw(10) << "pop (ms)"
+            << std::endl;
+  bool ok = true;
+  for (const auto& r : runs)
+  {
+    if (r.first == 0 || r.second == 0)
+    {
+      std::cerr << "terms and levels must be positive" << std::endl;
+      return 1;
+    }
+    ok = run(slv, r.first, r.second) && ok;
+  }
+  if (!ok)
+  {
+    std::cerr << "unexpected result of the equality engine" << std::endl;
+    return 1;
+  }
+  return 0;
+}
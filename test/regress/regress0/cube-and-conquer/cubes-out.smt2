@@ -0,0 +1,11 @@
+; COMMAND-LINE: --cube-and-conquer=2 --cubes-out=/dev/stdout
+; EXPECT: (check-sat-assuming (a))
+; EXPECT: (check-sat-assuming ((not a)))
+; The check-sat command only writes the cubes, a is split on since it has the
+; highest score.
+(set-logic QF_UF)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(assert (or a b))
+(assert a)
+(check-sat)
@@ -0,0 +1,17 @@
+; COMMAND-LINE: --cube-and-conquer=4
+; COMMAND-LINE: --cube-and-conquer=4 --cube-workers=2
+; EXPECT: sat
+; EXPECT: ((b true))
+; EXPECT: unsat
+(set-logic QF_UF)
+(set-option :produce-models true)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(declare-fun c () Bool)
+(assert (or a b))
+(assert (or (not a) c))
+(assert (not c))
+(check-sat)
+(get-value (b))
+(assert (or (not b) c))
+(check-sat)
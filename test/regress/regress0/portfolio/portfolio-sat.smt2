@@ -0,0 +1,11 @@
+; COMMAND-LINE: --portfolio=2
+; EXPECT: sat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (> (f x) (f y)))
+(assert (<= 0 x 10))
+(assert (<= 0 y 10))
+(assert (= (+ x y) 7))
+(check-sat)
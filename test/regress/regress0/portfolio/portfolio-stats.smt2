@@ -0,0 +1,16 @@
+; REQUIRES: statistics
+; COMMAND-LINE: --portfolio=2 --stats
+; ERROR-SCRUBBER: grep -c "^global::totalTime = "
+; EXPECT: sat
+; EXPECT-ERROR: 1
+; The statistics of the winning worker are forwarded by the parent process,
+; and only those.
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (> (f x) (f y)))
+(assert (<= 0 x 10))
+(assert (<= 0 y 10))
+(assert (= (+ x y) 7))
+(check-sat)
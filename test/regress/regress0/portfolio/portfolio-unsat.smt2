@@ -0,0 +1,10 @@
+; COMMAND-LINE: --portfolio=2
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(assert (> (f x) (f y)))
+(assert (<= x y))
+(assert (>= x y))
+(check-sat)
@@ -0,0 +1,40 @@
+; COMMAND-LINE: --portfolio=2 --portfolio-share
+; EXPECT: unsat
+; Pigeonhole problem with 4 pigeons and 3 holes, solved by two workers that
+; exchange their short learned clauses.
+(set-logic QF_UF)
+(declare-fun p00 () Bool)
+(declare-fun p01 () Bool)
+(declare-fun p02 () Bool)
+(declare-fun p10 () Bool)
+(declare-fun p11 () Bool)
+(declare-fun p12 () Bool)
+(declare-fun p20 () Bool)
+(declare-fun p21 () Bool)
+(declare-fun p22 () Bool)
+(declare-fun p30 () Bool)
+(declare-fun p31 () Bool)
+(declare-fun p32 () Bool)
+(assert (or p00 p01 p02))
+(assert (or p10 p11 p12))
+(assert (or p20 p21 p22))
+(assert (or p30 p31 p32))
+(assert (not (and p00 p10)))
+(assert (not (and p00 p20)))
+(assert (not (and p00 p30)))
+(assert (not (and p10 p20)))
+(assert (not (and p10 p30)))
+(assert (not (and p20 p30)))
+(assert (not (and p01 p11)))
+(assert (not (and p01 p21)))
+(assert (not (and p01 p31)))
+(assert (not (and p11 p21)))
+(assert (not (and p11 p31)))
+(assert (not (and p21 p31)))
+(assert (not (and p02 p12)))
+(assert (not (and p02 p22)))
+(assert (not (and p02 p32)))
+(assert (not (and p12 p22)))
+(assert (not (and p12 p32)))
+(assert (not (and p22 p32)))
+(check-sat)
@@ -0,0 +1,23 @@
+; REQUIRES: cadical-propagator
+; COMMAND-LINE: --incremental --sat-solver=cadical
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun p () Bool)
+(assert (or p (> x 2)))
+(assert (=> p (= (f x) (f y))))
+(check-sat)
+(push 1)
+(assert (= x y))
+(assert (not (= (f x) (f y))))
+(check-sat)
+(pop 1)
+(assert (not (= (f x) (f y))))
+(check-sat)
+(assert (< x 2))
+(check-sat)
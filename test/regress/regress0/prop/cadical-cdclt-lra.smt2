@@ -0,0 +1,12 @@
+; REQUIRES: cadical-propagator
+; COMMAND-LINE: --sat-solver=cadical
+; EXPECT: unsat
+(set-logic QF_LRA)
+(declare-fun a () Real)
+(declare-fun b () Real)
+(assert (or (> a 1) (> b 1)))
+(assert (or (< a 0) (< b 0)))
+(assert (> (+ a b) 2))
+(assert (< a 1.5))
+(assert (< b 1.5))
+(check-sat)
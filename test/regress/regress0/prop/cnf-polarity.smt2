@@ -0,0 +1,59 @@
+; COMMAND-LINE: --incremental --cnf-polarity --decision=internal --simplification=none --no-check-unsat-cores --no-check-proofs
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: unsat
+; EXPECT: sat
+; The conjunctions below are only used under the polarity-aware encoding, so
+; each of them must be defined in the direction in which the operator above
+; uses its literal.
+(set-logic QF_UF)
+(declare-sort U 0)
+(declare-fun f (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(declare-fun d () U)
+(define-fun x () Bool (f a))
+(define-fun y () Bool (f b))
+(define-fun z () Bool (f c))
+(define-fun w () Bool (f d))
+(push 1)
+(assert (=> (and x y) z))
+(assert x)
+(assert y)
+(assert (not z))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (= (and x y) z))
+(assert x)
+(assert y)
+(assert (not z))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (xor (and x y) z))
+(assert x)
+(assert y)
+(assert z)
+(check-sat)
+(pop 1)
+(push 1)
+(assert (ite (and x y) z w))
+(assert x)
+(assert y)
+(assert (not z))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (ite (or x y) w z))
+(assert (not x))
+(assert (not y))
+(assert (not z))
+(check-sat)
+(pop 1)
+(assert (=> (and x y) z))
+(assert (not z))
+(check-sat)
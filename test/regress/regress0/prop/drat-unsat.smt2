@@ -0,0 +1,16 @@
+; COMMAND-LINE: --drat-file=drat-unsat.drat --no-drat-binary --simplification=none
+; SCRUBBER: sh -c 'cat; f=drat-unsat.drat; if command -v drat-trim > /dev/null; then drat-trim $f.cnf $f | grep -q "^s VERIFIED" && echo "proof ok"; else awk "NR == 1 { n = \$4 } NR > 1 { c++ } END { if (c == n) print \"cnf ok\" }" $f.cnf | grep -q "cnf ok" && tail -n 1 $f | grep -qx "0" && echo "proof ok"; fi; rm -f $f $f.cnf'
+; EXPECT: unsat
+; EXPECT: proof ok
+; Writes the DRAT proof of a small unsatisfiable CNF. The proof is checked with
+; drat-trim if it is installed, otherwise the scrubber checks that the number
+; of clauses of the CNF file matches its header and that the proof ends with
+; the empty clause.
+(set-logic QF_UF)
+(declare-fun a () Bool)
+(declare-fun b () Bool)
+(assert (or a b))
+(assert (or a (not b)))
+(assert (or (not a) b))
+(assert (or (not a) (not b)))
+(check-sat)
@@ -0,0 +1,27 @@
+; COMMAND-LINE: --incremental --model-reuse-values
+; SCRUBBER: awk '/^sat$/ { print } /^\(\(a / { if (v == "") { v = $0 } else { print ($0 == v ? "same" : "changed") } }'
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: same
+; EXPECT: sat
+; The value of a is not constrained, so it is kept by the later models, even
+; though their new equivalence classes could take it.
+(set-logic QF_UF)
+(set-option :produce-models true)
+(set-option :global-declarations true)
+(declare-sort U 0)
+(declare-fun p (U) Bool)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun c () U)
+(declare-fun d () U)
+(assert (p a))
+(check-sat)
+(get-value (a))
+(assert (distinct b c d))
+(assert (not (p b)))
+(check-sat)
+(get-value (a))
+(reset-assertions)
+(assert (p a))
+(check-sat)
@@ -0,0 +1,25 @@
+; COMMAND-LINE: --incremental --model-reuse-values --check-models
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: (((= x y) false))
+; EXPECT: sat
+; EXPECT: (((= (f x) z) true))
+(set-logic QF_UF)
+(set-option :produce-models true)
+(declare-sort U 0)
+(declare-fun f (U) U)
+(declare-fun x () U)
+(declare-fun y () U)
+(declare-fun z () U)
+(assert (= (f y) y))
+(check-sat)
+(push 1)
+(assert (not (= x y)))
+(assert (not (= (f x) z)))
+(check-sat)
+(get-value ((= x y)))
+(pop 1)
+(assert (= (f x) z))
+(assert (not (= x z)))
+(check-sat)
+(get-value ((= (f x) z)))
@@ -0,0 +1,194 @@
+; COMMAND-LINE: --incremental --sat-clause-db=tiers
+; COMMAND-LINE: --incremental --sat-phase=target
+; COMMAND-LINE: --incremental --sat-restart=glucose
+; EXPECT: unsat
+; EXPECT: sat
+; Pigeonhole problems with 7 and 6 pigeons in 6 holes, solved with the tiered
+; reduction of learnt clauses, target phases and glucose restarts. The first
+; one needs enough conflicts to restart and reduce the learnt clauses.
+(set-logic QF_UF)
+(declare-fun p00 () Bool)
+(declare-fun p01 () Bool)
+(declare-fun p02 () Bool)
+(declare-fun p03 () Bool)
+(declare-fun p04 () Bool)
+(declare-fun p05 () Bool)
+(declare-fun p10 () Bool)
+(declare-fun p11 () Bool)
+(declare-fun p12 () Bool)
+(declare-fun p13 () Bool)
+(declare-fun p14 () Bool)
+(declare-fun p15 () Bool)
+(declare-fun p20 () Bool)
+(declare-fun p21 () Bool)
+(declare-fun p22 () Bool)
+(declare-fun p23 () Bool)
+(declare-fun p24 () Bool)
+(declare-fun p25 () Bool)
+(declare-fun p30 () Bool)
+(declare-fun p31 () Bool)
+(declare-fun p32 () Bool)
+(declare-fun p33 () Bool)
+(declare-fun p34 () Bool)
+(declare-fun p35 () Bool)
+(declare-fun p40 () Bool)
+(declare-fun p41 () Bool)
+(declare-fun p42 () Bool)
+(declare-fun p43 () Bool)
+(declare-fun p44 () Bool)
+(declare-fun p45 () Bool)
+(declare-fun p50 () Bool)
+(declare-fun p51 () Bool)
+(declare-fun p52 () Bool)
+(declare-fun p53 () Bool)
+(declare-fun p54 () Bool)
+(declare-fun p55 () Bool)
+(declare-fun p60 () Bool)
+(declare-fun p61 () Bool)
+(declare-fun p62 () Bool)
+(declare-fun p63 () Bool)
+(declare-fun p64 () Bool)
+(declare-fun p65 () Bool)
+(assert (or (not p00) (not p10)))
+(assert (or (not p00) (not p20)))
+(assert (or (not p00) (not p30)))
+(assert (or (not p00) (not p40)))
+(assert (or (not p00) (not p50)))
+(assert (or (not p00) (not p60)))
+(assert (or (not p10) (not p20)))
+(assert (or (not p10) (not p30)))
+(assert (or (not p10) (not p40)))
+(assert (or (not p10) (not p50)))
+(assert (or (not p10) (not p60)))
+(assert (or (not p20) (not p30)))
+(assert (or (not p20) (not p40)))
+(assert (or (not p20) (not p50)))
+(assert (or (not p20) (not p60)))
+(assert (or (not p30) (not p40)))
+(assert (or (not p30) (not p50)))
+(assert (or (not p30) (not p60)))
+(assert (or (not p40) (not p50)))
+(assert (or (not p40) (not p60)))
+(assert (or (not p50) (not p60)))
+(assert (or (not p01) (not p11)))
+(assert (or (not p01) (not p21)))
+(assert (or (not p01) (not p31)))
+(assert (or (not p01) (not p41)))
+(assert (or (not p01) (not p51)))
+(assert (or (not p01) (not p61)))
+(assert (or (not p11) (not p21)))
+(assert (or (not p11) (not p31)))
+(assert (or (not p11) (not p41)))
+(assert (or (not p11) (not p51)))
+(assert (or (not p11) (not p61)))
+(assert (or (not p21) (not p31)))
+(assert (or (not p21) (not p41)))
+(assert (or (not p21) (not p51)))
+(assert (or (not p21) (not p61)))
+(assert (or (not p31) (not p41)))
+(assert (or (not p31) (not p51)))
+(assert (or (not p31) (not p61)))
+(assert (or (not p41) (not p51)))
+(assert (or (not p41) (not p61)))
+(assert (or (not p51) (not p61)))
+(assert (or (not p02) (not p12)))
+(assert (or (not p02) (not p22)))
+(assert (or (not p02) (not p32)))
+(assert (or (not p02) (not p42)))
+(assert (or (not p02) (not p52)))
+(assert (or (not p02) (not p62)))
+(assert (or (not p12) (not p22)))
+(assert (or (not p12) (not p32)))
+(assert (or (not p12) (not p42)))
+(assert (or (not p12) (not p52)))
+(assert (or (not p12) (not p62)))
+(assert (or (not p22) (not p32)))
+(assert (or (not p22) (not p42)))
+(assert (or (not p22) (not p52)))
+(assert (or (not p22) (not p62)))
+(assert (or (not p32) (not p42)))
+(assert (or (not p32) (not p52)))
+(assert (or (not p32) (not p62)))
+(assert (or (not p42) (not p52)))
+(assert (or (not p42) (not p62)))
+(assert (or (not p52) (not p62)))
+(assert (or (not p03) (not p13)))
+(assert (or (not p03) (not p23)))
+(assert (or (not p03) (not p33)))
+(assert (or (not p03) (not p43)))
+(assert (or (not p03) (not p53)))
+(assert (or (not p03) (not p63)))
+(assert (or (not p13) (not p23)))
+(assert (or (not p13) (not p33)))
+(assert (or (not p13) (not p43)))
+(assert (or (not p13) (not p53)))
+(assert (or (not p13) (not p63)))
+(assert (or (not p23) (not p33)))
+(assert (or (not p23) (not p43)))
+(assert (or (not p23) (not p53)))
+(assert (or (not p23) (not p63)))
+(assert (or (not p33) (not p43)))
+(assert (or (not p33) (not p53)))
+(assert (or (not p33) (not p63)))
+(assert (or (not p43) (not p53)))
+(assert (or (not p43) (not p63)))
+(assert (or (not p53) (not p63)))
+(assert (or (not p04) (not p14)))
+(assert (or (not p04) (not p24)))
+(assert (or (not p04) (not p34)))
+(assert (or (not p04) (not p44)))
+(assert (or (not p04) (not p54)))
+(assert (or (not p04) (not p64)))
+(assert (or (not p14) (not p24)))
+(assert (or (not p14) (not p34)))
+(assert (or (not p14) (not p44)))
+(assert (or (not p14) (not p54)))
+(assert (or (not p14) (not p64)))
+(assert (or (not p24) (not p34)))
+(assert (or (not p24) (not p44)))
+(assert (or (not p24) (not p54)))
+(assert (or (not p24) (not p64)))
+(assert (or (not p34) (not p44)))
+(assert (or (not p34) (not p54)))
+(assert (or (not p34) (not p64)))
+(assert (or (not p44) (not p54)))
+(assert (or (not p44) (not p64)))
+(assert (or (not p54) (not p64)))
+(assert (or (not p05) (not p15)))
+(assert (or (not p05) (not p25)))
+(assert (or (not p05) (not p35)))
+(assert (or (not p05) (not p45)))
+(assert (or (not p05) (not p55)))
+(assert (or (not p05) (not p65)))
+(assert (or (not p15) (not p25)))
+(assert (or (not p15) (not p35)))
+(assert (or (not p15) (not p45)))
+(assert (or (not p15) (not p55)))
+(assert (or (not p15) (not p65)))
+(assert (or (not p25) (not p35)))
+(assert (or (not p25) (not p45)))
+(assert (or (not p25) (not p55)))
+(assert (or (not p25) (not p65)))
+(assert (or (not p35) (not p45)))
+(assert (or (not p35) (not p55)))
+(assert (or (not p35) (not p65)))
+(assert (or (not p45) (not p55)))
+(assert (or (not p45) (not p65)))
+(assert (or (not p55) (not p65)))
+(push 1)
+(assert (or p00 p01 p02 p03 p04 p05))
+(assert (or p10 p11 p12 p13 p14 p15))
+(assert (or p20 p21 p22 p23 p24 p25))
+(assert (or p30 p31 p32 p33 p34 p35))
+(assert (or p40 p41 p42 p43 p44 p45))
+(assert (or p50 p51 p52 p53 p54 p55))
+(assert (or p60 p61 p62 p63 p64 p65))
+(check-sat)
+(pop 1)
+(assert (or p00 p01 p02 p03 p04 p05))
+(assert (or p10 p11 p12 p13 p14 p15))
+(assert (or p20 p21 p22 p23 p24 p25))
+(assert (or p30 p31 p32 p33 p34 p35))
+(assert (or p40 p41 p42 p43 p44 p45))
+(assert (or p50 p51 p52 p53 p54 p55))
+(check-sat)
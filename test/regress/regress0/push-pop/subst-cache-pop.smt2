@@ -0,0 +1,27 @@
+; COMMAND-LINE: --incremental
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: unsat
+(set-logic QF_LIA)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(assert (= x (+ y 1)))
+(push 1)
+(assert (= y 3))
+(assert (> (+ x z) 10))
+(check-sat)
+(assert (< z 7))
+(check-sat)
+(pop 1)
+(assert (> (+ x z) 10))
+(assert (< z 7))
+(check-sat)
+(push 1)
+(assert (= y 3))
+(check-sat)
+(pop 1)
+(assert (< y 3))
+(check-sat)
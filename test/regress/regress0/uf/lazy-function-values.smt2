@@ -0,0 +1,32 @@
+; COMMAND-LINE: --lazy-function-values --no-debug-check-models
+; REQUIRES: statistics
+; SCRUBBER: sed -n -e 's/.*"theory::model::assignedFunctions" \([0-9]*\).*/assignedFunctions \1/p' -e '/^sat$/p' -e '/^((/p'
+; EXPECT: sat
+; EXPECT: ((x 3))
+; EXPECT: assignedFunctions 0
+; EXPECT: (((= (f a) b) true) ((p a) true))
+; EXPECT: assignedFunctions 2
+; EXPECT: (((= (g (f a)) (f a)) true))
+; EXPECT: assignedFunctions 3
+(set-logic QF_UFLIA)
+(set-option :produce-models true)
+(declare-sort U 0)
+(declare-fun a () U)
+(declare-fun b () U)
+(declare-fun f (U) U)
+(declare-fun g (U) U)
+(declare-fun p (U) Bool)
+(declare-fun x () Int)
+(declare-fun h (Int) Int)
+(assert (= (f a) b))
+(assert (p a))
+(assert (= (g b) b))
+(assert (= (h x) (+ x 1)))
+(assert (= x 3))
+(check-sat)
+(get-value (x))
+(get-info :all-statistics)
+(get-value ((= (f a) b) (p a)))
+(get-info :all-statistics)
+(get-value ((= (g (f a)) (f a))))
+(get-info :all-statistics)
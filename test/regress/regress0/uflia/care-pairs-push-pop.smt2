@@ -0,0 +1,35 @@
+; COMMAND-LINE: --incremental
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: sat
+; EXPECT: unsat
+; EXPECT: sat
+; EXPECT: unsat
+(set-logic QF_UFLIA)
+(declare-fun f (Int) Int)
+(declare-fun x () Int)
+(declare-fun y () Int)
+(declare-fun z () Int)
+(push 1)
+(assert (<= x y))
+(assert (<= y x))
+(assert (not (= (f x) (f y))))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (<= x y))
+(assert (not (= (f x) (f y))))
+(check-sat)
+; care pairs among x, y and z are examined again at the same level
+(assert (and (<= 0 x 1) (<= 0 y 1) (<= 0 z 1)))
+(check-sat)
+(assert (distinct (f x) (f y) (f z)))
+(check-sat)
+(pop 1)
+(push 1)
+(assert (distinct (f x) (f y)))
+(assert (and (<= 0 x 1) (<= 0 y 1)))
+(check-sat)
+(assert (= (f (- 1 x)) (f x)))
+(check-sat)
+(pop 1)
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of cvc5::context::CDFlatHashMap<>.
+ */
+
+#include <string>
+#include <vector>
+
+#include "context/cdflat_hashmap.h"
+#include "test_context.h"
+
+namespace cvc5 {
+namespace test {
+
+using cvc5::context::CDFlatHashMap;
+using cvc5::context::Context;
+
+class TestContextBlackCDFlatHashMap : public TestContext
+{
+ protected:
+  /** Returns the elements in a CDFlatHashMap, in iteration order. */
+  static std::vector<std::pair<int32_t, int32_t>> get_elements(
+      const CDFlatHashMap<int32_t, int32_t>& map)
+  {
+    return std::vector<std::pair<int32_t, int32_t>>{map.begin(), map.end()};
+  }
+};
+
+TEST_F(TestContextBlackCDFlatHashMap, simple_sequence)
+{
+  CDFlatHashMap<int32_t, int32_t> map(d_context.get());
+  ASSERT_TRUE(map.empty());
+
+  map.insert(3, 4);
+  ASSERT_EQ(map.size(), 1);
+  ASSERT_TRUE(map.contains(3));
+  ASSERT_EQ(map[3], 4);
+
+  {
+    d_context->push();
+    map.insert(5, 6);
+    map.insert(9, 8);
+    ASSERT_TRUE(map.insert_safe(1, 2));
+    ASSERT_FALSE(map.insert_safe(5, 7));
+    ASSERT_EQ(get_elements(map),
+              (std::vector<std::pair<int32_t, int32_t>>{
+                  {3, 4}, {5, 6}, {9, 8}, {1, 2}}));
+    ASSERT_EQ(map.find(9)->second, 8);
+    ASSERT_EQ(map.find(7), map.end());
+
+    {
+      d_context->push();
+      map.insert(7, 7);
+      ASSERT_EQ(map.size(), 5);
+      d_context->pop();
+    }
+    ASSERT_FALSE(map.contains(7));
+    ASSERT_EQ(map.size(), 4);
+    d_context->pop();
+  }
+
+  ASSERT_EQ(get_elements(map),
+            (std::vector<std::pair<int32_t, int32_t>>{{3, 4}}));
+  ASSERT_FALSE(map.contains(5));
+  ASSERT_EQ(map.find(1), map.end());
+}
+
+TEST_F(TestContextBlackCDFlatHashMap, insert_at_context_level_zero)
+{
+  CDFlatHashMap<int32_t, int32_t> map(d_context.get());
+  map.insert(3, 4);
+  {
+    d_context->push();
+    map.insert(5, 6);
+    map.insertAtContextLevelZero(23, 317);
+    {
+      d_context->push();
+      map.insertAtContextLevelZero(24, 318);
+      map.insert(25, 319);
+      ASSERT_EQ(map[24], 318);
+      ASSERT_EQ(map[3], 4);
+      d_context->pop();
+    }
+    ASSERT_FALSE(map.contains(25));
+    ASSERT_EQ(map.size(), 4);
+    d_context->pop();
+  }
+  ASSERT_EQ(get_elements(map),
+            (std::vector<std::pair<int32_t, int32_t>>{
+                {24, 318}, {23, 317}, {3, 4}}));
+  ASSERT_EQ(map[23], 317);
+  ASSERT_FALSE(map.contains(5));
+}
+
+TEST_F(TestContextBlackCDFlatHashMap, many_elements)
+{
+  CDFlatHashMap<int32_t, int32_t> map(d_context.get());
+  CDFlatHashMap<std::string, size_t> smap(d_context.get());
+  const int32_t n = 20000;
+  for (int32_t i = 0; i < n; ++i)
+  {
+    if (i % 1000 == 0)
+    {
+      d_context->push();
+    }
+    map.insert(i * 7919, i);
+    smap.insert(std::to_string(i), i);
+    if (i % 3 == 0)
+    {
+      map.insertAtContextLevelZero(-i - 1, i);
+    }
+  }
+  d_context->popto(7);
+  ASSERT_EQ(map.size(), 7000 + (n + 2) / 3);
+  ASSERT_EQ(smap.size(), 7000);
+  for (int32_t i = 0; i < n; ++i)
+  {
+    ASSERT_EQ(map.contains(i * 7919), i < 7000);
+    ASSERT_EQ(smap.contains(std::to_string(i)), i < 7000);
+    ASSERT_EQ(map.contains(-i - 1), i % 3 == 0);
+    if (i < 7000)
+    {
+      ASSERT_EQ(map[i * 7919], i);
+      ASSERT_EQ(smap[std::to_string(i)], i);
+    }
+  }
+  d_context->popto(0);
+  ASSERT_EQ(map.size(), (n + 2) / 3);
+  ASSERT_TRUE(smap.empty());
+}
+}  // namespace test
+}  // namespace cvc5
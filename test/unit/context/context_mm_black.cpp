@@ -102,5 +102,62 @@ TEST_F(TestContextBlackMM, push_pop)
 #endif
 }
 
+TEST_F(TestContextBlackMM, chunk_reuse)
+{
+#ifndef CVC5_DEBUG_CONTEXT_MEMORY_MANAGER
+  uint32_t chunk_size_bytes = ContextMemoryManager::getMaxAllocationSize();
+  // Fill a region with many chunks' worth of data, chunks grow with the
+  // size of the region so that only a few are needed
+  d_cmm->push();
+  for (uint32_t i = 0; i < 256; ++i)
+  {
+    d_cmm->newData(chunk_size_bytes);
+  }
+  d_cmm->pop();
+  uint64_t allocated = d_cmm->numChunksAllocated();
+  ASSERT_LT(allocated, 16);
+  ASSERT_EQ(d_cmm->numChunksReleased(), 0);
+  ASSERT_EQ(d_cmm->peakBytesHeld(), 256 * chunk_size_bytes);
+
+  // The same workload again is served from the free chunks
+  d_cmm->push();
+  for (uint32_t i = 0; i < 256; ++i)
+  {
+    d_cmm->newData(chunk_size_bytes);
+  }
+  d_cmm->pop();
+  ASSERT_EQ(d_cmm->numChunksAllocated(), allocated);
+  ASSERT_EQ(d_cmm->numChunksReused(), allocated - 1);
+  ASSERT_EQ(d_cmm->numPops(), 2);
+
+  // Shrinking the reserve releases free chunks, largest first
+  uint64_t held = d_cmm->numBytesHeld();
+  d_cmm->setFreeChunkReserve(1);
+  ASSERT_EQ(d_cmm->numChunksReleased(), allocated - 2);
+  ASSERT_EQ(d_cmm->numBytesHeld(), 2 * chunk_size_bytes);
+  ASSERT_LT(d_cmm->numBytesHeld(), held);
+#endif
+}
+
+TEST_F(TestContextBlackMM, huge_pages)
+{
+#ifndef CVC5_DEBUG_CONTEXT_MEMORY_MANAGER
+  uint32_t chunk_size_bytes = ContextMemoryManager::getMaxAllocationSize();
+  d_cmm->setHugePages(true);
+  for (uint32_t p = 0; p < 3; ++p)
+  {
+    d_cmm->push();
+    for (uint32_t i = 0; i < 1024; ++i)
+    {
+      char* mem = static_cast<char*>(d_cmm->newData(chunk_size_bytes));
+      memset(mem, 'a', chunk_size_bytes);
+    }
+    d_cmm->pop();
+  }
+  d_cmm->setFreeChunkReserve(0);
+  ASSERT_EQ(d_cmm->numBytesHeld(), chunk_size_bytes);
+#endif
+}
+
 }  // namespace test
 }  // namespace cvc5
@@ -0,0 +1,266 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of multi-level pops of cvc5::context::Context.
+ */
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "context/cdhashmap.h"
+#include "context/cdlist.h"
+#include "context/cdo.h"
+#include "test_context.h"
+
+namespace cvc5 {
+
+using namespace context;
+
+namespace test {
+
+/** Context-dependent data modified at every level */
+struct PoptoData
+{
+  PoptoData(Context* c, size_t n) : d_list(c), d_map(c)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      d_ints.emplace_back(c, 0);
+      d_strings.emplace_back(c);
+    }
+  }
+
+  /** Modify some of the data, depending on the level */
+  void modify(int level)
+  {
+    for (size_t i = level % 3; i < d_ints.size(); i += 1 + level % 4)
+    {
+      d_ints[i] = level * 100 + i;
+      d_strings[i] = std::to_string(level) + "_" + std::to_string(i);
+    }
+    d_list.push_back(level);
+    d_map.insert(level, level);
+    d_map.insert(0, level);
+  }
+
+  /** Check that other has the same values as this */
+  void check(const PoptoData& other) const
+  {
+    for (size_t i = 0; i < d_ints.size(); ++i)
+    {
+      ASSERT_EQ(d_ints[i].get(), other.d_ints[i].get());
+      ASSERT_EQ(d_strings[i].get(), other.d_strings[i].get());
+    }
+    ASSERT_EQ(d_list.size(), other.d_list.size());
+    for (size_t i = 0; i < d_list.size(); ++i)
+    {
+      ASSERT_EQ(d_list[i], other.d_list[i]);
+    }
+    ASSERT_EQ(d_map.size(), other.d_map.size());
+    for (const auto& p : d_map)
+    {
+      ASSERT_TRUE(other.d_map.find(p.first) != other.d_map.end());
+      ASSERT_EQ(p.second, other.d_map.find(p.first)->second);
+    }
+  }
+
+  std::deque<CDO<int32_t>> d_ints;
+  std::deque<CDO<std::string>> d_strings;
+  CDList<int32_t> d_list;
+  CDHashMap<int32_t, int32_t> d_map;
+};
+
+/** Records the level and the value of an object at each notification */
+struct PoptoRecordingNotifyObj : public ContextNotifyObj
+{
+  PoptoRecordingNotifyObj(Context* context, CDO<int32_t>& obj)
+      : ContextNotifyObj(context), d_context(context), d_obj(obj)
+  {
+  }
+  void contextNotifyPop() override
+  {
+    d_levels.push_back(d_context->getLevel());
+    d_values.push_back(d_obj.get());
+  }
+  Context* d_context;
+  CDO<int32_t>& d_obj;
+  std::vector<int32_t> d_levels;
+  std::vector<int32_t> d_values;
+};
+
+struct PoptoNotifyObj : public ContextNotifyObj
+{
+  PoptoNotifyObj(Context* context, bool preNotify = false)
+      : ContextNotifyObj(context, preNotify), d_ncalls(0)
+  {
+  }
+  void contextNotifyPop() override { ++d_ncalls; }
+  int32_t d_ncalls;
+};
+
+class TestContextBlackPopto : public TestContext
+{
+};
+
+TEST_F(TestContextBlackPopto, popto_matches_pop)
+{
+  Context other;
+  PoptoData data(d_context.get(), 50);
+  PoptoData otherData(&other, 50);
+
+  for (int level = 1; level <= 10; ++level)
+  {
+    d_context->push();
+    other.push();
+    data.modify(level);
+    otherData.modify(level);
+  }
+  d_context->popto(3);
+  while (other.getLevel() > 3)
+  {
+    other.pop();
+  }
+  ASSERT_EQ(d_context->getLevel(), 3);
+  data.check(otherData);
+
+  // the restored objects can be modified and popped again
+  for (int level = 4; level <= 8; ++level)
+  {
+    d_context->push();
+    other.push();
+    data.modify(level * 7);
+    otherData.modify(level * 7);
+  }
+  d_context->popto(5);
+  while (other.getLevel() > 5)
+  {
+    other.pop();
+  }
+  data.check(otherData);
+  d_context->popto(0);
+  other.popto(0);
+  data.check(otherData);
+  ASSERT_EQ(data.d_list.size(), 0);
+  ASSERT_EQ(data.d_map.size(), 0);
+}
+
+TEST_F(TestContextBlackPopto, objects_in_popped_levels)
+{
+  PoptoData data(d_context.get(), 4);
+  d_context->push();
+  data.modify(1);
+  d_context->push();
+  {
+    // an object created above the target level of the pop
+    CDO<int32_t> x(d_context.get(), 1);
+    d_context->push();
+    x = 2;
+    data.modify(2);
+    d_context->push();
+    x = 3;
+    data.modify(3);
+    d_context->popto(2);
+    ASSERT_EQ(x.get(), 1);
+  }
+  d_context->popto(0);
+  ASSERT_EQ(data.d_ints[1].get(), 0);
+  ASSERT_EQ(data.d_strings[1].get(), "");
+}
+
+TEST_F(TestContextBlackPopto, popto_levels)
+{
+  for (int nlevels : {2, 8, 32})
+  {
+    for (int target = 0; target < nlevels; target += 1 + nlevels / 4)
+    {
+      std::deque<CDO<int32_t>> objs;
+      for (size_t i = 0; i < 100; ++i)
+      {
+        objs.emplace_back(d_context.get(), -1);
+      }
+      // expected[l][i] is the value of objs[i] at level l
+      std::vector<std::vector<int32_t>> expected;
+      expected.emplace_back(objs.size(), -1);
+      for (int level = 1; level <= nlevels; ++level)
+      {
+        d_context->push();
+        expected.push_back(expected.back());
+        // objects are modified at some of the levels only
+        for (size_t i = level % 5; i < objs.size(); i += 1 + level % 3)
+        {
+          objs[i] = level;
+          expected.back()[i] = level;
+        }
+      }
+      d_context->popto(target);
+      ASSERT_EQ(d_context->getLevel(), target);
+      for (size_t i = 0; i < objs.size(); ++i)
+      {
+        ASSERT_EQ(objs[i].get(), expected[target][i]);
+      }
+      d_context->popto(0);
+      for (size_t i = 0; i < objs.size(); ++i)
+      {
+        ASSERT_EQ(objs[i].get(), -1);
+      }
+    }
+  }
+}
+
+TEST_F(TestContextBlackPopto, popto_with_pre_notify)
+{
+  Context other;
+  PoptoData data(d_context.get(), 10);
+  PoptoData otherData(&other, 10);
+  // objects notified before the pop force popping one level at a time
+  PoptoNotifyObj preNotify(d_context.get(), true);
+  PoptoNotifyObj postNotify(d_context.get());
+  for (int level = 1; level <= 6; ++level)
+  {
+    d_context->push();
+    other.push();
+    data.modify(level);
+    otherData.modify(level);
+  }
+  d_context->popto(2);
+  other.popto(2);
+  ASSERT_EQ(preNotify.d_ncalls, 4);
+  ASSERT_EQ(postNotify.d_ncalls, 4);
+  data.check(otherData);
+  // popping a single level
+  d_context->popto(1);
+  other.pop();
+  data.check(otherData);
+  d_context->popto(0);
+  ASSERT_EQ(data.d_list.size(), 0);
+}
+
+TEST_F(TestContextBlackPopto, popto_with_post_notify)
+{
+  CDO<int32_t> obj(d_context.get(), 0);
+  // objects notified after the pop see each intermediate level
+  PoptoRecordingNotifyObj postNotify(d_context.get(), obj);
+  for (int32_t level = 1; level <= 6; ++level)
+  {
+    d_context->push();
+    obj = level;
+  }
+  d_context->popto(2);
+  ASSERT_EQ(d_context->getLevel(), 2);
+  ASSERT_EQ(obj.get(), 2);
+  ASSERT_EQ(postNotify.d_levels, std::vector<int32_t>({5, 4, 3, 2}));
+  ASSERT_EQ(postNotify.d_values, std::vector<int32_t>({5, 4, 3, 2}));
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * Black box testing of the cube-and-conquer splitting of the driver.
+ */
+
+#include <sstream>
+#include <vector>
+
+#include "api/cpp/cvc5.h"
+#include "main/cube_and_conquer.h"
+#include "test_api.h"
+
+namespace cvc5 {
+
+using namespace api;
+using namespace main;
+
+namespace test {
+
+class TestMainBlackCubeAndConquer : public TestApi
+{
+ protected:
+  void SetUp() override
+  {
+    TestApi::SetUp();
+    d_solver.setOption("incremental", "true");
+    d_solver.setOption("produce-models", "true");
+    Sort b = d_solver.getBooleanSort();
+    d_a = d_solver.mkConst(b, "a");
+    d_b = d_solver.mkConst(b, "b");
+    d_c = d_solver.mkConst(b, "c");
+    d_d = d_solver.mkConst(b, "d");
+  }
+
+  Term d_a;
+  Term d_b;
+  Term d_c;
+  Term d_d;
+};
+
+TEST_F(TestMainBlackCubeAndConquer, getCubes)
+{
+  // a scores 1/4 + 1/4, b and c score 1/4, d scores 1
+  d_solver.assertFormula(d_solver.mkTerm(OR, d_a, d_b));
+  d_solver.assertFormula(d_solver.mkTerm(OR, d_a, d_c));
+  d_solver.assertFormula(d_d);
+
+  std::vector<std::vector<Term>> cubes = getCubes(d_solver, 1);
+  ASSERT_EQ(cubes.size(), 1);
+  ASSERT_TRUE(cubes[0].empty());
+
+  cubes = getCubes(d_solver, 5);
+  std::vector<std::vector<Term>> expected = {{d_d, d_a},
+                                             {d_d, d_a.notTerm()},
+                                             {d_d.notTerm(), d_a},
+                                             {d_d.notTerm(), d_a.notTerm()}};
+  ASSERT_EQ(cubes, expected);
+
+  // there are only four atoms to split on
+  cubes = getCubes(d_solver, 64);
+  ASSERT_EQ(cubes.size(), 16);
+}
+
+TEST_F(TestMainBlackCubeAndConquer, printCubes)
+{
+  std::stringstream ss;
+  printCubes(ss, {{d_a, d_b.notTerm()}, {}});
+  ASSERT_EQ(ss.str(),
+            "(check-sat-assuming (a (not b)))\n(check-sat-assuming ())\n");
+}
+
+TEST_F(TestMainBlackCubeAndConquer, solveCubesSat)
+{
+  d_solver.assertFormula(d_solver.mkTerm(OR, d_a, d_b));
+  d_solver.assertFormula(d_solver.mkTerm(OR, d_a.notTerm(), d_c));
+  d_solver.assertFormula(d_c.notTerm());
+  std::vector<std::vector<Term>> cubes = getCubes(d_solver, 4);
+  ASSERT_EQ(cubes.size(), 4);
+  for (size_t workers : {1, 2})
+  {
+    api::Result r;
+    ASSERT_EQ(solveCubes(d_solver, cubes, workers, r), CubeResult::SAT);
+    ASSERT_TRUE(r.isSat());
+    ASSERT_EQ(d_solver.getValue(d_b), d_solver.mkTrue());
+  }
+}
+
+TEST_F(TestMainBlackCubeAndConquer, solveCubesUnsat)
+{
+  d_solver.assertFormula(d_solver.mkTerm(OR, d_a, d_b));
+  d_solver.assertFormula(d_solver.mkTerm(OR, d_a.notTerm(), d_b));
+  d_solver.assertFormula(d_b.notTerm());
+  std::vector<std::vector<Term>> cubes = getCubes(d_solver, 4);
+  ASSERT_EQ(cubes.size(), 4);
+  for (size_t workers : {1, 2, 8})
+  {
+    api::Result r;
+    ASSERT_EQ(solveCubes(d_solver, cubes, workers, r), CubeResult::UNSAT);
+    ASSERT_TRUE(r.isNull());
+  }
+}
+
+TEST_F(TestMainBlackCubeAndConquer, cubeResult)
+{
+  std::stringstream ss;
+  ss << CubeResult::SAT << " " << CubeResult::UNSAT << " "
+     << CubeResult::UNKNOWN;
+  ASSERT_EQ(ss.str(), "sat unsat unknown");
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -49,6 +49,11 @@ class TestNodeBlackAttribute : public TestNode
   {
   };
   using BoolAttribute = expr::Attribute<BoolAttributeId, bool>;
+  struct DenseNodeAttributeId
+  {
+  };
+  using DenseNodeAttribute =
+      expr::DenseAttribute<DenseNodeAttributeId, Node>;
 };
 
 TEST_F(TestNodeBlackAttribute, ints)
@@ -123,5 +128,48 @@ TEST_F(TestNodeBlackAttribute, bools)
   delete node;
 }
 
+TEST_F(TestNodeBlackAttribute, dense_nodes)
+{
+  TypeNode booleanType = d_nodeManager->booleanType();
+  Node a = d_skolemManager->mkDummySkolem("a", booleanType);
+  Node b = d_skolemManager->mkDummySkolem("b", booleanType);
+  Node data;
+
+  DenseNodeAttribute attr;
+  ASSERT_FALSE(a.hasAttribute(attr));
+  ASSERT_FALSE(a.getAttribute(attr, data));
+  ASSERT_TRUE(a.getAttribute(attr).isNull());
+
+  // a null value is distinct from no value
+  a.setAttribute(attr, Node::null());
+  ASSERT_TRUE(a.hasAttribute(attr));
+  ASSERT_TRUE(a.getAttribute(attr, data));
+  ASSERT_TRUE(data.isNull());
+  ASSERT_FALSE(b.hasAttribute(attr));
+
+  b.setAttribute(attr, a);
+  ASSERT_TRUE(b.getAttribute(attr, data));
+  ASSERT_EQ(data, a);
+  b.setAttribute(attr, b);
+  ASSERT_EQ(b.getAttribute(attr), b);
+
+  // nodes created later get larger ids than the ones set so far
+  Node c = d_skolemManager->mkDummySkolem("c", booleanType);
+  ASSERT_FALSE(c.hasAttribute(attr));
+  c.setAttribute(attr, a);
+  ASSERT_EQ(c.getAttribute(attr), a);
+
+  // the attribute can be deleted for all nodes at once
+  std::vector<const expr::attr::AttributeUniqueId*> ids;
+  expr::attr::AttributeUniqueId id =
+      expr::attr::AttributeManager::getAttributeId(attr);
+  ASSERT_EQ(id.getTableId(), expr::attr::AttrTableDenseNode);
+  ids.push_back(&id);
+  d_nodeManager->deleteAttributes(ids);
+  ASSERT_FALSE(a.hasAttribute(attr));
+  ASSERT_FALSE(b.hasAttribute(attr));
+  ASSERT_FALSE(c.hasAttribute(attr));
+}
+
 }  // namespace test
 }  // namespace cvc5
@@ -13,7 +13,10 @@
  * White box testing of cvc5::NodeManager.
  */
 
+#include <atomic>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "expr/node_manager.h"
 #include "test_node.h"
@@ -79,5 +82,374 @@ TEST_F(TestNodeWhiteNodeManager, topological_sort)
     ASSERT_EQ(NodeManager::TopologicalSort(roots), result);
   }
 }
+
+TEST_F(TestNodeWhiteNodeManager, slab_allocation)
+{
+  const NodeValueAllocator& nva = d_nodeManager->getNodeValueAllocator();
+  TypeNode boolType = d_nodeManager->booleanType();
+  std::vector<Node> vars;
+  for (size_t i = 0; i < 100; ++i)
+  {
+    vars.push_back(d_skolemManager->mkDummySkolem("x", boolType));
+  }
+  while (!d_nodeManager->d_zombies.empty())
+  {
+    d_nodeManager->reclaimZombies();
+  }
+  uint64_t objects = nva.numSlabObjects();
+  uint64_t slabs = nva.numSlabs();
+
+  {
+    std::vector<Node> nodes;
+    for (const Node& x : vars)
+    {
+      for (const Node& y : vars)
+      {
+        nodes.push_back(d_nodeManager->mkNode(kind::AND, x, y));
+      }
+    }
+    ASSERT_EQ(nva.numSlabObjects(), objects + nodes.size());
+    ASSERT_GT(nva.numSlabs(), slabs);
+  }
+
+  while (!d_nodeManager->d_zombies.empty())
+  {
+    d_nodeManager->reclaimZombies();
+  }
+  ASSERT_EQ(nva.numSlabObjects(), objects);
+  ASSERT_GT(nva.numSlabsReleased(), 0);
+}
+
+TEST_F(TestNodeWhiteNodeManager, pool_deep_and_wide_dags)
+{
+  TypeNode boolType = d_nodeManager->booleanType();
+  std::vector<Node> vars;
+  for (size_t i = 0; i < 64; ++i)
+  {
+    vars.push_back(d_skolemManager->mkDummySkolem("x", boolType));
+  }
+  d_nodeManager->reclaimAllZombies();
+  size_t poolSize = d_nodeManager->poolSize();
+
+  {
+    // a deep DAG, building it twice must yield the same nodes
+    std::vector<Node> deep;
+    Node cur = vars[0];
+    for (size_t i = 0; i < 20000; ++i)
+    {
+      cur = d_nodeManager->mkNode(kind::AND, cur, vars[i % vars.size()]);
+      deep.push_back(cur);
+    }
+    cur = vars[0];
+    for (size_t i = 0; i < 20000; ++i)
+    {
+      cur = d_nodeManager->mkNode(kind::AND, cur, vars[i % vars.size()]);
+      ASSERT_EQ(cur, deep[i]);
+    }
+    // a wide DAG
+    std::vector<Node> wide;
+    for (const Node& x : vars)
+    {
+      for (const Node& y : vars)
+      {
+        wide.push_back(d_nodeManager->mkNode(kind::OR, x, y));
+      }
+    }
+    ASSERT_EQ(d_nodeManager->mkNode(kind::OR, vars[3], vars[5]),
+              wide[3 * vars.size() + 5]);
+    ASSERT_EQ(d_nodeManager->poolSize(),
+              poolSize + deep.size() + wide.size());
+  }
+
+  d_nodeManager->reclaimAllZombies();
+  ASSERT_EQ(d_nodeManager->poolSize(), poolSize);
+}
+
+TEST_F(TestNodeWhiteNodeManager, incremental_reclamation)
+{
+  TypeNode boolType = d_nodeManager->booleanType();
+  Node x = d_skolemManager->mkDummySkolem("x", boolType);
+  std::vector<Node> ys;
+  for (size_t i = 0; i < 100; ++i)
+  {
+    ys.push_back(d_skolemManager->mkDummySkolem("y", boolType));
+  }
+  d_nodeManager->reclaimAllZombies();
+  {
+    std::vector<Node> nodes;
+    for (const Node& y : ys)
+    {
+      nodes.push_back(d_nodeManager->mkNode(kind::AND, x, y));
+    }
+  }
+  size_t numZombies = d_nodeManager->d_zombies.size();
+  ASSERT_GE(numZombies, 100);
+  d_nodeManager->reclaimZombies(10);
+  ASSERT_EQ(d_nodeManager->d_zombies.size(), numZombies - 10);
+
+  // with a batch size, node construction reclaims pending zombies
+  d_nodeManager->setZombieReclamation(nullptr, 5000, 10);
+  Node z = d_skolemManager->mkDummySkolem("z", boolType);
+  Node n = d_nodeManager->mkNode(kind::AND, x, z);
+  ASSERT_LT(d_nodeManager->d_zombies.size(), numZombies - 10);
+  d_nodeManager->setZombieReclamation(nullptr, 5000, 0);
+  d_nodeManager->reclaimAllZombies();
+  ASSERT_TRUE(d_nodeManager->d_zombies.empty());
+}
+
+TEST_F(TestNodeWhiteNodeManager, zombie_reclamation_owner)
+{
+  int first, second;
+  ASSERT_TRUE(d_nodeManager->setZombieReclamation(&first, 100, 10));
+  // the settings are owned by the first owner
+  ASSERT_FALSE(d_nodeManager->setZombieReclamation(&second, 200, 20));
+  ASSERT_FALSE(d_nodeManager->setZombieReclamation(nullptr, 200, 20));
+  ASSERT_EQ(d_nodeManager->d_zombieThreshold, 100u);
+  ASSERT_EQ(d_nodeManager->d_zombieReclaimBatch, 10u);
+  ASSERT_TRUE(d_nodeManager->setZombieReclamation(&first, 300, 30));
+  // only the owner releases the settings, which keep their values
+  d_nodeManager->releaseZombieReclamation(&second);
+  ASSERT_FALSE(d_nodeManager->setZombieReclamation(&second, 200, 20));
+  d_nodeManager->releaseZombieReclamation(&first);
+  ASSERT_EQ(d_nodeManager->d_zombieThreshold, 300u);
+  ASSERT_TRUE(d_nodeManager->setZombieReclamation(&second, 200, 20));
+  d_nodeManager->releaseZombieReclamation(&second);
+  ASSERT_TRUE(d_nodeManager->setZombieReclamation(nullptr, 5000, 0));
+}
+
+TEST_F(TestNodeWhiteNodeManager, thread_safe_sharing)
+{
+  const size_t numThreads = 4;
+  const size_t numVars = 50;
+  bool sameNodes = true;
+  std::atomic<bool> sameTypes(true);
+  std::atomic<bool> sameOwner(true);
+  size_t zombiesWhileShared = 0;
+  size_t zombiesAfterwards = 0;
+  bool releasedOutsideScope = true;
+  // the owning thread of the shared node manager, so that the node manager
+  // of this thread is not made thread-safe for the other tests
+  std::thread owner([&]() {
+    NodeManager* nm = NodeManager::currentNM();
+    nm->setThreadSafe();
+    nm->init();
+    TypeNode boolType = nm->booleanType();
+    std::vector<Node> vars;
+    for (size_t i = 0; i < numVars; ++i)
+    {
+      vars.push_back(nm->getSkolemManager()->mkDummySkolem("x", boolType));
+    }
+    std::vector<std::vector<Node>> results(numThreads);
+    std::vector<expr::NodeValue*> lastNodes(numThreads);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      workers.emplace_back([&, t]() {
+        Node last;
+        {
+          NodeManagerScope nms(nm);
+          for (size_t i = 0; i < numVars; ++i)
+          {
+            Node a = nm->mkNode(kind::AND, vars[i], vars[(i + 1) % numVars]);
+            Node o = nm->mkNode(kind::OR, a, vars[(i + t) % numVars]);
+            // garbage, which becomes a zombie of nm
+            nm->mkNode(kind::XOR, o, vars[i]);
+            results[t].push_back(a);
+            if (a.getType() != boolType)
+            {
+              sameTypes = false;
+            }
+            if (o.d_nv->d_nmIndex != nm->d_threadSafeIndex)
+            {
+              sameOwner = false;
+            }
+          }
+          last = nm->mkNode(kind::NOT, vars[t]);
+          lastNodes[t] = last.d_nv;
+        }
+        // released outside of the scope, this still is a zombie of nm
+        last = Node::null();
+        if (!NodeManager::threadNM()->d_zombies.empty())
+        {
+          sameOwner = false;
+        }
+      });
+    }
+    for (std::thread& w : workers)
+    {
+      w.join();
+    }
+    for (size_t t = 1; t < numThreads; ++t)
+    {
+      sameNodes = sameNodes && results[t] == results[0];
+    }
+    zombiesWhileShared = nm->d_zombies.size();
+    for (expr::NodeValue* nv : lastNodes)
+    {
+      releasedOutsideScope = releasedOutsideScope
+                             && nm->d_zombies.find(nv) != nm->d_zombies.end();
+    }
+    results.clear();
+    nm->reclaimAllZombies();
+    zombiesAfterwards = nm->d_zombies.size();
+  });
+  owner.join();
+  ASSERT_TRUE(sameNodes);
+  ASSERT_TRUE(sameTypes);
+  ASSERT_TRUE(sameOwner);
+  ASSERT_GE(zombiesWhileShared, numVars);
+  ASSERT_TRUE(releasedOutsideScope);
+  ASSERT_EQ(zombiesAfterwards, 0);
+  // nodes of other node managers are reference counted as before
+  ASSERT_FALSE(d_nodeManager->isThreadSafe());
+  ASSERT_EQ(d_nodeManager->mkConst(true).d_nv->d_nmIndex, 0);
+}
+
+TEST_F(TestNodeWhiteNodeManager, thread_safe_reclamation)
+{
+  size_t zombiesInScope = 0;
+  size_t zombiesAfterwards = 0;
+  bool reclaimedInScope = false;
+  std::thread owner([&]() {
+    NodeManager* nm = NodeManager::currentNM();
+    nm->setThreadSafe();
+    nm->init();
+    Node x = nm->getSkolemManager()->mkDummySkolem("x", nm->booleanType());
+    std::thread worker([&]() {
+      NodeManagerScope nms(nm);
+      nm->reclaimAllZombies();
+      size_t poolSize = nm->poolSize();
+      nm->mkNode(kind::NOT, x);
+      zombiesInScope = nm->d_zombies.size();
+      // reclamation is not deferred while threads are in a scope
+      nm->reclaimAllZombies();
+      zombiesAfterwards = nm->d_zombies.size();
+      reclaimedInScope = nm->poolSize() == poolSize;
+    });
+    worker.join();
+  });
+  owner.join();
+  ASSERT_EQ(zombiesInScope, 1);
+  ASSERT_EQ(zombiesAfterwards, 0);
+  ASSERT_TRUE(reclaimedInScope);
+}
+
+TEST_F(TestNodeWhiteNodeManager, thread_safe_concurrent_references)
+{
+  const size_t numThreads = 4;
+  const size_t numRounds = 2000;
+  /** Counts the notifications and detects overlapping ones. */
+  class CountingListener : public NodeManagerListener
+  {
+   public:
+    void nmNotifyNewVar(TNode n) override
+    {
+      enter();
+      ++d_newVars;
+      leave();
+    }
+    void nmNotifyDeleteNode(TNode n) override
+    {
+      enter();
+      ++d_deleted;
+      leave();
+    }
+    void enter()
+    {
+      if (d_active.fetch_add(1) != 0)
+      {
+        d_overlapping = true;
+      }
+    }
+    void leave() { d_active.fetch_sub(1); }
+    /** Not atomic, notifications must be serialized by the lock */
+    size_t d_newVars = 0;
+    size_t d_deleted = 0;
+    std::atomic<uint32_t> d_active{0};
+    std::atomic<bool> d_overlapping{false};
+  };
+  CountingListener listener;
+  uint32_t rcShared = 0;
+  uint32_t rcAfterwards = 0;
+  std::atomic<bool> sameNodes(true);
+  std::thread owner([&]() {
+    NodeManager* nm = NodeManager::currentNM();
+    nm->setThreadSafe();
+    nm->init();
+    // reclaim zombies while the workers are creating and releasing nodes
+    nm->setZombieReclamation(nullptr, 16, 4);
+    nm->subscribeEvents(&listener);
+    TypeNode boolType = nm->booleanType();
+    Node x = nm->getSkolemManager()->mkDummySkolem("x", boolType);
+    Node y = nm->getSkolemManager()->mkDummySkolem("y", boolType);
+    Node shared = nm->mkNode(kind::AND, x, y);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < numThreads; ++t)
+    {
+      workers.emplace_back([&, t]() {
+        NodeManagerScope nms(nm);
+        for (size_t i = 0; i < numRounds; ++i)
+        {
+          // references to a node of another thread, taken and dropped
+          std::vector<Node> copies(4, shared);
+          // a node that is resurrected or recreated after being released by
+          // the other threads
+          Node o = nm->mkNode(kind::OR, x, y);
+          if (nm->mkNode(kind::AND, x, y) != shared)
+          {
+            sameNodes = false;
+          }
+          // garbage that is only referenced by this thread
+          Node v = nm->mkVar(boolType);
+          nm->mkNode(kind::XOR, v, o);
+        }
+      });
+    }
+    for (std::thread& w : workers)
+    {
+      w.join();
+    }
+    rcShared = shared.d_nv->getRefCount();
+    nm->reclaimAllZombies();
+    Node held = shared;
+    rcAfterwards = shared.d_nv->getRefCount();
+    nm->unsubscribeEvents(&listener);
+  });
+  owner.join();
+  ASSERT_TRUE(sameNodes);
+  ASSERT_FALSE(listener.d_overlapping);
+  ASSERT_EQ(listener.d_newVars, numThreads * numRounds);
+  // the variables and the xors, at least
+  ASSERT_GE(listener.d_deleted, 2 * numThreads * numRounds);
+  // only the owner's node refers to the shared node
+  ASSERT_EQ(rcShared, 1);
+  ASSERT_EQ(rcAfterwards, 2);
+}
+
+TEST_F(TestNodeWhiteNodeManager, thread_safe_limit)
+{
+  ASSERT_DEATH(
+      {
+        // the owning threads keep their node managers alive
+        std::vector<std::thread> owners;
+        for (size_t i = 0; i < 16; ++i)
+        {
+          std::atomic<bool> ready(false);
+          owners.emplace_back([&ready]() {
+            NodeManager::currentNM()->setThreadSafe();
+            ready = true;
+            for (;;)
+            {
+              std::this_thread::yield();
+            }
+          });
+          while (!ready)
+          {
+            std::this_thread::yield();
+          }
+        }
+      },
+      "too many thread-safe node managers");
+}
 }  // namespace test
 }  // namespace cvc5
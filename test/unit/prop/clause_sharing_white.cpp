@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * White box testing of cvc5::prop::ClauseSharing.
+ */
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+
+#include "context/context.h"
+#include "fake_sat_solver.h"
+#include "prop/clause_sharing.h"
+#include "prop/cnf_stream.h"
+#include "prop/registrar.h"
+#include "prop/sat_solver.h"
+#include "smt/solver_engine_scope.h"
+#include "test_smt.h"
+
+namespace cvc5 {
+
+using namespace prop;
+
+namespace test {
+
+class TestPropWhiteClauseSharing : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    d_scope.reset(new smt::SolverEngineScope(d_slvEngine.get()));
+    d_satSolver.reset(new FakeSatSolver());
+    d_cnfContext.reset(new context::Context());
+    d_cnfRegistrar.reset(new prop::NullRegistrar);
+    d_cnfStream.reset(new CnfStream(d_satSolver.get(),
+                                    d_cnfRegistrar.get(),
+                                    d_cnfContext.get(),
+                                    &d_slvEngine->getEnv(),
+                                    d_slvEngine->getResourceManager()));
+    char dir[] = "/tmp/cvc5-clause-sharing-XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    d_dir = dir;
+    d_a = d_nodeManager->mkVar("a", d_nodeManager->booleanType());
+    d_b = d_nodeManager->mkVar("b", d_nodeManager->booleanType());
+    d_cnfStream->ensureLiteral(d_a);
+    d_cnfStream->ensureLiteral(d_b);
+  }
+
+  void TearDown() override
+  {
+    unlink((d_dir + "/0.clauses").c_str());
+    rmdir(d_dir.c_str());
+    d_a = Node::null();
+    d_b = Node::null();
+    d_cnfStream.reset(nullptr);
+    d_cnfRegistrar.reset(nullptr);
+    d_cnfContext.reset(nullptr);
+    d_satSolver.reset(nullptr);
+    d_scope.reset(nullptr);
+    TestSmt::TearDown();
+  }
+
+  /** Returns the contents of the file exported by instance 0. */
+  std::string exported()
+  {
+    std::ifstream in(d_dir + "/0.clauses");
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+  }
+
+  std::unique_ptr<smt::SolverEngineScope> d_scope;
+  std::unique_ptr<FakeSatSolver> d_satSolver;
+  std::unique_ptr<context::Context> d_cnfContext;
+  std::unique_ptr<prop::NullRegistrar> d_cnfRegistrar;
+  std::unique_ptr<CnfStream> d_cnfStream;
+  /** The directory through which the clauses are exchanged */
+  std::string d_dir;
+  Node d_a;
+  Node d_b;
+};
+
+TEST_F(TestPropWhiteClauseSharing, file_format)
+{
+  ClauseSharing exporter(d_cnfStream.get(), d_dir, 0, true);
+  SatLiteral a = d_cnfStream->getLiteral(d_a);
+  SatLiteral b = d_cnfStream->getLiteral(d_b);
+  // one line per clause, literals sorted, separated by tabs
+  exporter.exportClause({~b, a}, 1);
+  exporter.exportClause({a, ~b}, 1);
+  exporter.exportLemma(d_nodeManager->mkNode(kind::OR, d_b, d_a));
+  std::vector<SatClause> clauses;
+  exporter.importClauses(clauses);
+  ASSERT_TRUE(clauses.empty());
+  ASSERT_EQ(exported(), "+a\t-b\n+a\t+b\n");
+  // formulas with skolems are not shared
+  Node k = d_skolemManager->mkDummySkolem("k", d_nodeManager->booleanType());
+  d_cnfStream->ensureLiteral(k);
+  exporter.exportClause({a, d_cnfStream->getLiteral(k)}, 1);
+  exporter.importClauses(clauses);
+  ASSERT_EQ(exported(), "+a\t-b\n+a\t+b\n");
+}
+
+TEST_F(TestPropWhiteClauseSharing, import)
+{
+  SatLiteral a = d_cnfStream->getLiteral(d_a);
+  SatLiteral b = d_cnfStream->getLiteral(d_b);
+  std::ofstream out(d_dir + "/0.clauses");
+  // the line with c is deferred because c has no literal, the incomplete
+  // line is only imported once it is complete
+  out << "+a\t-b\n+a\t-b\n-a\t+c\n-a";
+  out.flush();
+  ClauseSharing importer(d_cnfStream.get(), d_dir, 1, false);
+  std::vector<SatClause> clauses;
+  importer.importClauses(clauses);
+  ASSERT_EQ(clauses.size(), 1);
+  ASSERT_EQ(clauses[0], SatClause({a, ~b}));
+  out << "\t-b\n";
+  out.flush();
+  clauses.clear();
+  importer.importClauses(clauses);
+  ASSERT_EQ(clauses.size(), 1);
+  ASSERT_EQ(clauses[0], SatClause({~a, ~b}));
+  // the deferred line is imported once c has a literal, and only once
+  Node c = d_nodeManager->mkVar("c", d_nodeManager->booleanType());
+  d_cnfStream->ensureLiteral(c);
+  clauses.clear();
+  importer.importClauses(clauses);
+  ASSERT_EQ(clauses.size(), 1);
+  ASSERT_EQ(clauses[0], SatClause({~a, d_cnfStream->getLiteral(c)}));
+  clauses.clear();
+  importer.importClauses(clauses);
+  ASSERT_TRUE(clauses.empty());
+  // instances that do not export do not write a file
+  ASSERT_NE(access((d_dir + "/1.clauses").c_str(), F_OK), 0);
+}
+
+}  // namespace test
+}  // namespace cvc5
@@ -15,6 +15,7 @@
 
 #include "base/check.h"
 #include "context/context.h"
+#include "fake_sat_solver.h"
 #include "prop/cnf_stream.h"
 #include "prop/prop_engine.h"
 #include "prop/registrar.h"
@@ -36,71 +37,6 @@ using namespace theory;
 
 namespace test {
 
-/* This fake class relies on the fact that a MiniSat variable is just an int. */
-class FakeSatSolver : public SatSolver
-{
- public:
-  FakeSatSolver() : d_nextVar(0), d_addClauseCalled(false) {}
-
-  SatVariable newVar(bool theoryAtom, bool preRegister, bool canErase) override
-  {
-    return d_nextVar++;
-  }
-
-  SatVariable trueVar() override { return d_nextVar++; }
-
-  SatVariable falseVar() override { return d_nextVar++; }
-
-  ClauseId addClause(SatClause& c, bool lemma) override
-  {
-    d_addClauseCalled = true;
-    return ClauseIdUndef;
-  }
-
-  ClauseId addXorClause(SatClause& clause, bool rhs, bool removable) override
-  {
-    d_addClauseCalled = true;
-    return ClauseIdUndef;
-  }
-
-  bool nativeXor() override { return false; }
-
-  void reset() { d_addClauseCalled = false; }
-
-  unsigned int addClauseCalled() { return d_addClauseCalled; }
-
-  unsigned getAssertionLevel() const override { return 0; }
-
-  bool isDecision(Node) const { return false; }
-
-  void unregisterVar(SatLiteral lit) {}
-
-  void renewVar(SatLiteral lit, int level = -1) {}
-
-  bool spendResource() { return false; }
-
-  void interrupt() override {}
-
-  SatValue solve() override { return SAT_VALUE_UNKNOWN; }
-
-  SatValue solve(long unsigned int& resource) override
-  {
-    return SAT_VALUE_UNKNOWN;
-  }
-
-  SatValue value(SatLiteral l) override { return SAT_VALUE_UNKNOWN; }
-
-  SatValue modelValue(SatLiteral l) override { return SAT_VALUE_UNKNOWN; }
-
-  bool properExplanation(SatLiteral lit, SatLiteral expl) const { return true; }
-
-  bool ok() const override { return true; }
-
- private:
-  SatVariable d_nextVar;
-  bool d_addClauseCalled;
-};
-
 class TestPropWhiteCnfStream : public TestSmt
 {
  protected:
@@ -258,5 +194,54 @@ TEST_F(TestPropWhiteCnfStream, ensure_literal)
   ASSERT_TRUE(d_satSolver->addClauseCalled());
   ASSERT_TRUE(d_cnfStream->hasLiteral(a_and_b));
 }
+
+TEST_F(TestPropWhiteCnfStream, deep_formula)
+{
+  // the conversion must not recurse on the depth of the formula
+  Node a = d_nodeManager->mkVar(d_nodeManager->booleanType());
+  Node b = d_nodeManager->mkVar(d_nodeManager->booleanType());
+  Node f = a;
+  Node g = a;
+  for (size_t i = 0; i < 100000; ++i)
+  {
+    f = d_nodeManager->mkNode(i % 2 == 0 ? kind::OR : kind::AND, f, b);
+    g = d_nodeManager->mkNode(kind::AND, b, g.notNode());
+  }
+  d_cnfStream->convertAndAssert(f, false, false);
+  d_cnfStream->convertAndAssert(g, false, true);
+  ASSERT_TRUE(d_satSolver->addClauseCalled());
+}
+
+TEST_F(TestPropWhiteCnfStream, polarity)
+{
+  d_slvEngine->setOption("cnf-polarity", "true");
+  d_cnfStream.reset(
+      new cvc5::prop::CnfStream(d_satSolver.get(),
+                                d_cnfRegistrar.get(),
+                                d_cnfContext.get(),
+                                &d_slvEngine->getEnv(),
+                                d_slvEngine->getResourceManager()));
+  std::vector<Node> vars;
+  for (size_t i = 0; i < 6; ++i)
+  {
+    vars.push_back(d_nodeManager->mkVar(d_nodeManager->booleanType()));
+  }
+  Node and1 = d_nodeManager->mkNode(kind::AND, vars[0], vars[1]);
+  Node and2 = d_nodeManager->mkNode(kind::AND, vars[2], vars[3]);
+  Node and3 = d_nodeManager->mkNode(kind::AND, vars[4], vars[5]);
+  // the clause of the disjunction and two clauses per conjunction, instead of
+  // three clauses per conjunction with the Tseitin encoding
+  d_cnfStream->convertAndAssert(
+      d_nodeManager->mkNode(kind::OR, and1, and2, and3), false, false);
+  ASSERT_EQ(d_satSolver->numClauses(), 7);
+  // only the missing direction of the definition is added
+  d_cnfStream->ensureLiteral(and1);
+  ASSERT_EQ(d_satSolver->numClauses(), 8);
+  d_cnfStream->ensureLiteral(and1);
+  ASSERT_EQ(d_satSolver->numClauses(), 8);
+  d_cnfStream->convertAndAssert(
+      d_nodeManager->mkNode(kind::OR, and2.notNode(), vars[0]), false, false);
+  ASSERT_EQ(d_satSolver->numClauses(), 10);
+}
 }  // namespace test
 }  // namespace cvc5
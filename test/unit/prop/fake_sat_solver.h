@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Aina Niemetz, Christopher L. Conway, agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * A fake SAT solver for the prop unit tests.
+ */
+
+#ifndef CVC5__TEST__UNIT__PROP__FAKE_SAT_SOLVER_H
+#define CVC5__TEST__UNIT__PROP__FAKE_SAT_SOLVER_H
+
+#include "expr/node.h"
+#include "prop/sat_solver.h"
+
+namespace cvc5 {
+namespace test {
+
+/* This fake class relies on the fact that a MiniSat variable is just an int. */
+class FakeSatSolver : public prop::SatSolver
+{
+ public:
+  FakeSatSolver() : d_nextVar(0), d_addClauseCalled(false), d_numClauses(0)
+  {
+  }
+
+  prop::SatVariable newVar(bool theoryAtom,
+                           bool preRegister,
+                           bool canErase) override
+  {
+    return d_nextVar++;
+  }
+
+  prop::SatVariable trueVar() override { return d_nextVar++; }
+
+  prop::SatVariable falseVar() override { return d_nextVar++; }
+
+  ClauseId addClause(prop::SatClause& c, bool lemma) override
+  {
+    d_addClauseCalled = true;
+    ++d_numClauses;
+    return ClauseIdUndef;
+  }
+
+  ClauseId addXorClause(prop::SatClause& clause,
+                        bool rhs,
+                        bool removable) override
+  {
+    d_addClauseCalled = true;
+    return ClauseIdUndef;
+  }
+
+  bool nativeXor() override { return false; }
+
+  void reset() { d_addClauseCalled = false; }
+
+  unsigned int addClauseCalled() { return d_addClauseCalled; }
+
+  size_t numClauses() const { return d_numClauses; }
+
+  unsigned getAssertionLevel() const override { return 0; }
+
+  bool isDecision(Node) const { return false; }
+
+  void unregisterVar(prop::SatLiteral lit) {}
+
+  void renewVar(prop::SatLiteral lit, int level = -1) {}
+
+  bool spendResource() { return false; }
+
+  void interrupt() override {}
+
+  prop::SatValue solve() override { return prop::SAT_VALUE_UNKNOWN; }
+
+  prop::SatValue solve(long unsigned int& resource) override
+  {
+    return prop::SAT_VALUE_UNKNOWN;
+  }
+
+  prop::SatValue value(prop::SatLiteral l) override
+  {
+    return prop::SAT_VALUE_UNKNOWN;
+  }
+
+  prop::SatValue modelValue(prop::SatLiteral l) override
+  {
+    return prop::SAT_VALUE_UNKNOWN;
+  }
+
+  bool properExplanation(prop::SatLiteral lit, prop::SatLiteral expl) const
+  {
+    return true;
+  }
+
+  bool ok() const override { return true; }
+
+ private:
+  prop::SatVariable d_nextVar;
+  bool d_addClauseCalled;
+  size_t d_numClauses;
+};
+
+}  // namespace test
+}  // namespace cvc5
+#endif
@@ -0,0 +1,123 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * White box testing of the bounded rewrite cache.
+ */
+
+#include <vector>
+
+#include "expr/node.h"
+#include "smt/env.h"
+#include "test_smt.h"
+#include "theory/rewrite_cache.h"
+#include "theory/rewriter.h"
+#include "util/rational.h"
+
+namespace cvc5 {
+
+using namespace theory;
+
+namespace test {
+
+class TestTheoryWhiteRewriteCache : public TestSmt
+{
+ protected:
+  std::vector<Node> mkVars(size_t n)
+  {
+    std::vector<Node> vars;
+    for (size_t i = 0; i < n; ++i)
+    {
+      vars.push_back(d_nodeManager->mkVar(d_nodeManager->integerType()));
+    }
+    return vars;
+  }
+};
+
+TEST_F(TestTheoryWhiteRewriteCache, get_set)
+{
+  RewriteCache cache(d_slvEngine->getEnv().getStatisticsRegistry(), 8);
+  std::vector<Node> v = mkVars(2);
+
+  ASSERT_TRUE(cache.get(true, THEORY_ARITH, v[0]).isNull());
+  cache.set(true, THEORY_ARITH, v[0], v[1]);
+  ASSERT_EQ(cache.get(true, THEORY_ARITH, v[0]), v[1]);
+  // pre- and post-rewrites and theories are cached separately
+  ASSERT_TRUE(cache.get(false, THEORY_ARITH, v[0]).isNull());
+  ASSERT_TRUE(cache.get(true, THEORY_UF, v[0]).isNull());
+  // a node may be its own rewrite
+  cache.set(false, THEORY_ARITH, v[0], v[0]);
+  ASSERT_EQ(cache.get(false, THEORY_ARITH, v[0]), v[0]);
+  // overwriting does not add an entry
+  cache.set(true, THEORY_ARITH, v[0], v[0]);
+  ASSERT_EQ(cache.get(true, THEORY_ARITH, v[0]), v[0]);
+  ASSERT_EQ(cache.size(), 2);
+
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0);
+  ASSERT_TRUE(cache.get(true, THEORY_ARITH, v[0]).isNull());
+}
+
+TEST_F(TestTheoryWhiteRewriteCache, clock_eviction)
+{
+  RewriteCache cache(d_slvEngine->getEnv().getStatisticsRegistry(), 4);
+  std::vector<Node> v = mkVars(6);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    cache.set(false, THEORY_ARITH, v[i], v[i]);
+  }
+  ASSERT_EQ(cache.size(), 4);
+
+  // v[0] and v[2] get a second chance, v[1] is evicted
+  ASSERT_FALSE(cache.get(false, THEORY_ARITH, v[0]).isNull());
+  ASSERT_FALSE(cache.get(false, THEORY_ARITH, v[2]).isNull());
+  cache.set(false, THEORY_ARITH, v[4], v[4]);
+  ASSERT_EQ(cache.size(), 4);
+  ASSERT_TRUE(cache.get(false, THEORY_ARITH, v[1]).isNull());
+  ASSERT_FALSE(cache.get(false, THEORY_ARITH, v[4]).isNull());
+
+  // the hand continues after v[1], clears the reference bit of v[2] and
+  // evicts v[3]
+  cache.set(false, THEORY_ARITH, v[5], v[5]);
+  ASSERT_TRUE(cache.get(false, THEORY_ARITH, v[3]).isNull());
+  ASSERT_FALSE(cache.get(false, THEORY_ARITH, v[0]).isNull());
+  ASSERT_FALSE(cache.get(false, THEORY_ARITH, v[2]).isNull());
+  ASSERT_FALSE(cache.get(false, THEORY_ARITH, v[5]).isNull());
+  ASSERT_EQ(cache.size(), cache.capacity());
+}
+
+TEST_F(TestTheoryWhiteRewriteCache, bounded_rewriter)
+{
+  Rewriter* rr = d_slvEngine->getEnv().getRewriter();
+  rr->setCacheBudget(d_slvEngine->getEnv().getStatisticsRegistry(),
+                     RewriteCache::s_entryBytes * 16);
+  ASSERT_EQ(rr->d_cache->capacity(), 16);
+
+  // rewriting terms with more subterms than the capacity of the cache still
+  // gives the correct results
+  std::vector<Node> v = mkVars(20);
+  Node zero = d_nodeManager->mkConst(Rational(0));
+  for (const Node& x : v)
+  {
+    Node t = d_nodeManager->mkNode(kind::PLUS, x, zero);
+    ASSERT_EQ(rr->rewrite(t), x);
+    ASSERT_LE(rr->d_cache->size(), 16);
+  }
+  for (const Node& x : v)
+  {
+    Node t = d_nodeManager->mkNode(kind::PLUS, zero, x);
+    ASSERT_EQ(rr->rewrite(t), x);
+  }
+  rr->clearCaches();
+  ASSERT_EQ(rr->d_cache->size(), 0);
+}
+}  // namespace test
+}  // namespace cvc5
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * White box testing of the caches of substitution maps across context levels.
+ */
+
+#include <memory>
+
+#include "context/context.h"
+#include "expr/node.h"
+#include "test_node.h"
+#include "theory/substitutions.h"
+
+namespace cvc5 {
+
+using namespace theory;
+using namespace kind;
+
+namespace test {
+
+class TestTheoryWhiteSubstitutions : public TestNode
+{
+ protected:
+  void SetUp() override
+  {
+    TestNode::SetUp();
+    d_context.reset(new context::Context());
+    d_a = d_nodeManager->mkVar("a", *d_intTypeNode);
+    d_b = d_nodeManager->mkVar("b", *d_intTypeNode);
+    d_c = d_nodeManager->mkVar("c", *d_intTypeNode);
+    d_x = d_nodeManager->mkVar("x", *d_intTypeNode);
+    d_y = d_nodeManager->mkVar("y", *d_intTypeNode);
+  }
+
+  std::unique_ptr<context::Context> d_context;
+  Node d_a, d_b, d_c, d_x, d_y;
+};
+
+TEST_F(TestTheoryWhiteSubstitutions, apply_after_pop)
+{
+  SubstitutionMap subs(d_context.get());
+  Node t = d_nodeManager->mkNode(PLUS, d_a, d_b);
+
+  subs.addSubstitution(d_a, d_x);
+  ASSERT_EQ(subs.apply(t), d_nodeManager->mkNode(PLUS, d_x, d_b));
+  ASSERT_EQ(subs.d_caches.size(), 1);
+
+  d_context->push();
+  subs.addSubstitution(d_b, d_y);
+  ASSERT_EQ(subs.apply(t), d_nodeManager->mkNode(PLUS, d_x, d_y));
+  ASSERT_EQ(subs.d_caches.size(), 2);
+  d_context->pop();
+
+  // the cache of the lower level is kept and reused
+  ASSERT_EQ(subs.d_caches.front().d_cache.count(t), 1);
+  ASSERT_EQ(subs.apply(t), d_nodeManager->mkNode(PLUS, d_x, d_b));
+  ASSERT_EQ(subs.d_caches.size(), 1);
+}
+
+TEST_F(TestTheoryWhiteSubstitutions, one_cache_per_level)
+{
+  SubstitutionMap subs(d_context.get());
+  Node t = d_nodeManager->mkNode(PLUS, d_a, d_b);
+
+  subs.addSubstitution(d_a, d_x);
+  subs.apply(t);
+  subs.addSubstitution(d_b, d_y);
+  ASSERT_EQ(subs.apply(t), d_nodeManager->mkNode(PLUS, d_x, d_y));
+  ASSERT_EQ(subs.d_caches.size(), 1);
+
+  d_context->push();
+  subs.apply(t);
+  ASSERT_EQ(subs.d_caches.size(), 1);
+  subs.addSubstitution(d_c, d_x);
+  subs.apply(t);
+  subs.addSubstitution(d_x, d_y);
+  ASSERT_EQ(subs.apply(t), d_nodeManager->mkNode(PLUS, d_y, d_y));
+  ASSERT_EQ(subs.d_caches.size(), 2);
+  d_context->pop();
+
+  ASSERT_EQ(subs.apply(t), d_nodeManager->mkNode(PLUS, d_x, d_y));
+  ASSERT_EQ(subs.d_caches.size(), 1);
+}
+
+TEST_F(TestTheoryWhiteSubstitutions, no_invalidation_at_higher_level)
+{
+  SubstitutionMap subs(d_context.get());
+  subs.addSubstitution(d_a, d_x);
+  ASSERT_EQ(subs.apply(d_c), d_c);
+
+  // the substitution is not added to the cache of the lower level
+  d_context->push();
+  subs.addSubstitution(d_c, d_y, false);
+  ASSERT_EQ(subs.apply(d_c), d_y);
+  d_context->pop();
+
+  ASSERT_EQ(subs.apply(d_c), d_c);
+}
+
+}  // namespace test
+}  // namespace cvc5
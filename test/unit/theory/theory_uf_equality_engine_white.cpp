@@ -0,0 +1,193 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   agent
+ *
+ * This file is part of the cvc5 project.
+ *
+ * Copyright (c) 2009-2021 by the authors listed in the file AUTHORS
+ * in the top-level source directory and their institutional affiliations.
+ * All rights reserved.  See the file COPYING in the top-level source
+ * directory for licensing information.
+ * ****************************************************************************
+ *
+ * White box testing of the node storage of the equality engine.
+ */
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "context/context.h"
+#include "expr/node.h"
+#include "smt/solver_engine.h"
+#include "test_smt.h"
+#include "theory/uf/equality_engine.h"
+
+namespace cvc5 {
+
+using namespace theory;
+using namespace theory::eq;
+using namespace kind;
+
+namespace test {
+
+class TestTheoryWhiteUfEqualityEngine : public TestSmt
+{
+ protected:
+  void SetUp() override
+  {
+    TestSmt::SetUp();
+    d_context.reset(new context::Context());
+    d_u = d_nodeManager->mkSort("U");
+    d_f = d_nodeManager->mkVar("f", d_nodeManager->mkFunctionType(d_u, d_u));
+  }
+
+  std::unique_ptr<EqualityEngine> mkEqualityEngine(const std::string& name)
+  {
+    std::unique_ptr<EqualityEngine> ee(new EqualityEngine(
+        d_slvEngine->getEnv(), d_context.get(), name, false));
+    ee->addFunctionKind(APPLY_UF);
+    return ee;
+  }
+
+  /** Returns n variables of sort U and their images under f. */
+  void mkTerms(size_t n, std::vector<Node>& vars, std::vector<Node>& apps)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      vars.push_back(d_nodeManager->mkVar("x" + std::to_string(i), d_u));
+      apps.push_back(d_nodeManager->mkNode(APPLY_UF, d_f, vars.back()));
+    }
+  }
+
+  std::unique_ptr<context::Context> d_context;
+  TypeNode d_u;
+  Node d_f;
+};
+
+TEST_F(TestTheoryWhiteUfEqualityEngine, find_ids)
+{
+  std::vector<Node> vars, apps;
+  mkTerms(3, vars, apps);
+  std::unique_ptr<EqualityEngine> ee = mkEqualityEngine("find_ids::");
+  for (const Node& app : apps)
+  {
+    ee->addTerm(app);
+  }
+  size_t count = ee->d_nodesCount;
+  ASSERT_EQ(ee->d_findIds.size(), count);
+  ASSERT_EQ(ee->d_nodeIds.size(), count);
+  for (const Node& app : apps)
+  {
+    EqualityNodeId id = ee->getNodeId(app);
+    ASSERT_EQ(ee->getFind(id), id);
+  }
+
+  d_context->push();
+  Node eq = vars[0].eqNode(vars[1]);
+  ee->assertEquality(eq, true, eq);
+  ASSERT_EQ(ee->getFind(vars[0]), ee->getFind(vars[1]));
+  ASSERT_EQ(ee->getFind(apps[0]), ee->getFind(apps[1]));
+  ASSERT_NE(ee->getFind(apps[0]), ee->getFind(apps[2]));
+  // the representative of a class is its own representative
+  EqualityNodeId rep = ee->getFind(apps[0]);
+  ASSERT_EQ(ee->getFind(rep), rep);
+  d_context->pop();
+
+  ASSERT_EQ(ee->getFind(ee->getNodeId(vars[0])), ee->getNodeId(vars[0]));
+  ASSERT_EQ(ee->getFind(ee->getNodeId(apps[1])), ee->getNodeId(apps[1]));
+  ASSERT_FALSE(ee->areEqual(apps[0], apps[1]));
+}
+
+TEST_F(TestTheoryWhiteUfEqualityEngine, remove_terms_on_pop)
+{
+  std::vector<Node> vars, apps;
+  mkTerms(4, vars, apps);
+  std::unique_ptr<EqualityEngine> ee = mkEqualityEngine("remove_terms::");
+  ee->addTerm(apps[0]);
+  size_t count = ee->d_nodesCount;
+
+  d_context->push();
+  ee->addTerm(apps[1]);
+  Node eq = vars[0].eqNode(vars[1]);
+  ee->assertEquality(eq, true, eq);
+  ASSERT_TRUE(ee->areEqual(apps[0], apps[1]));
+  d_context->push();
+  ee->addTerm(apps[2]);
+  ee->addTerm(apps[3]);
+  ASSERT_TRUE(ee->hasTerm(apps[3]));
+  d_context->pop();
+  ASSERT_FALSE(ee->hasTerm(apps[3]));
+  ASSERT_TRUE(ee->hasTerm(apps[1]));
+  d_context->pop();
+
+  ASSERT_EQ(ee->d_nodesCount, count);
+  ASSERT_EQ(ee->d_findIds.size(), count);
+  ASSERT_EQ(ee->d_nodeIds.size(), count);
+  ASSERT_TRUE(ee->hasTerm(apps[0]));
+  ASSERT_FALSE(ee->hasTerm(apps[1]));
+  ASSERT_FALSE(ee->hasTerm(vars[1]));
+
+  // the terms get new ids when they are added again
+  ee->addTerm(apps[3]);
+  ASSERT_TRUE(ee->hasTerm(apps[3]));
+  ASSERT_FALSE(ee->areEqual(apps[0], apps[3]));
+}
+
+TEST_F(TestTheoryWhiteUfEqualityEngine, explanation_cache)
+{
+  std::vector<Node> vars, apps;
+  mkTerms(4, vars, apps);
+  std::unique_ptr<EqualityEngine> ee = mkEqualityEngine("explain::");
+  for (const Node& app : apps)
+  {
+    ee->addTerm(app);
+  }
+  auto explain = [&ee](TNode a, TNode b) {
+    std::vector<TNode> assumptions;
+    ee->explainEquality(a, b, true, assumptions);
+    return std::set<Node>(assumptions.begin(), assumptions.end());
+  };
+  Node eq01 = vars[0].eqNode(vars[1]);
+  Node eq12 = vars[1].eqNode(vars[2]);
+  Node eq03 = vars[0].eqNode(vars[3]);
+  Node eq32 = vars[3].eqNode(vars[2]);
+
+  d_context->push();
+  ee->assertEquality(eq01, true, eq01);
+  ASSERT_EQ(explain(apps[0], apps[1]), std::set<Node>({eq01}));
+  size_t keysSize = ee->d_explanationCacheKeys.size();
+  size_t reasonsSize = ee->d_explanationReasons.size();
+  ASSERT_GT(keysSize, 0);
+
+  d_context->push();
+  ee->assertEquality(eq12, true, eq12);
+  ASSERT_EQ(explain(apps[0], apps[2]), std::set<Node>({eq01, eq12}));
+  // the second explanation is taken from the cache
+  ASSERT_EQ(explain(apps[2], apps[0]), std::set<Node>({eq01, eq12}));
+  ASSERT_GT(ee->d_explanationCacheKeys.size(), keysSize);
+  d_context->pop();
+
+  // only the explanations of the popped level are removed
+  ASSERT_EQ(ee->d_explanationCacheKeys.size(), keysSize);
+  ASSERT_EQ(ee->d_explanationReasons.size(), reasonsSize);
+  ASSERT_EQ(explain(apps[0], apps[1]), std::set<Node>({eq01}));
+  d_context->pop();
+
+  ASSERT_TRUE(ee->d_explanationCacheKeys.empty());
+  ASSERT_TRUE(ee->d_explanationCache.empty());
+  ASSERT_TRUE(ee->d_explanationReasons.empty());
+
+  // a different chain between the same terms is explained by its own
+  // equalities
+  d_context->push();
+  ee->assertEquality(eq03, true, eq03);
+  ee->assertEquality(eq32, true, eq32);
+  ASSERT_EQ(explain(apps[0], apps[2]), std::set<Node>({eq03, eq32}));
+  ASSERT_EQ(explain(vars[2], vars[0]), std::set<Node>({eq03, eq32}));
+  d_context->pop();
+}
+
+}  // namespace test
+}  // namespace cvc5